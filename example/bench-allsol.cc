@@ -0,0 +1,144 @@
+// benchmark of allsol and optimize
+// some problems of Burkardt and COPRIN test sets, and some test
+// functions of global optimization
+//
+//   ./bench-allsol [text|json|csv] [min_time]
+
+#include <iostream>
+#include <cstdlib>
+#include <kv/allsol.hpp>
+#include <kv/optimize.hpp>
+#include <kv/benchmark.hpp>
+#include "burkardt-non.hpp"
+#include "coprin.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+template <class F> struct Allsol {
+	F f;
+	ub::vector<itv> I;
+	double giveup;
+
+	Allsol(F f, const ub::vector<itv>& I, double giveup = 0.) : f(f), I(I), giveup(giveup) {}
+
+	void operator()() {
+		kv::allsol(f, I, 0, giveup);
+	}
+};
+
+template <class F> Allsol<F> make_allsol(F f, const ub::vector<itv>& I, double giveup = 0.) {
+	return Allsol<F>(f, I, giveup);
+}
+
+template <class F> struct Minimize {
+	F f;
+	ub::vector<itv> I;
+	double limit;
+
+	Minimize(F f, const ub::vector<itv>& I, double limit) : f(f), I(I), limit(limit) {}
+
+	void operator()() {
+		kv::minimize_value(I, f, limit);
+	}
+};
+
+template <class F> Minimize<F> make_minimize(F f, const ub::vector<itv>& I, double limit) {
+	return Minimize<F>(f, I, limit);
+}
+
+
+struct Rosenbrock {
+	template <class T> T operator() (const ub::vector<T>& x){
+		T tmp, tmp2;
+		tmp = 1. - x(0);
+		tmp2 = x(1) - x(0) * x(0);
+		return tmp * tmp + 100. * tmp2 * tmp2;
+	}
+};
+
+struct Levy {
+	template <class T> T operator() (const ub::vector<T>& x){
+		T tmp, tmp2;
+		int i;
+
+		tmp = 0.;
+		for (i=1; i<=5; i++) {
+			tmp += i * cos((i-1)*x(0) + i);
+		}
+		tmp2 = 0.;
+		for (i=1; i<=5; i++) {
+			tmp2 += i * cos((i+1)*x(1) + i);
+		}
+		return tmp * tmp2 + pow(x(0) + 1.42513, 2) + pow(x(1) + 0.80032, 2);
+	}
+};
+
+// sum of squares of the equations of COPRIN Cyclo
+struct CycloSq {
+	template <class T> T operator() (const ub::vector<T>& x){
+		ub::vector<T> y = Cyclo()(x);
+		T r;
+		int i;
+
+		r = 0.;
+		for (i=0; i<(int)y.size(); i++) r += pow(y(i), 2);
+		return r;
+	}
+};
+
+
+int main(int argc, char *argv[])
+{
+	std::string format = "text";
+	double min_time = 0.2;
+	ub::vector<itv> I;
+	int i;
+
+	if (argc >= 2) format = argv[1];
+	if (argc >= 3) min_time = std::atof(argv[2]);
+
+	kv::benchmark b("allsol", min_time);
+
+	// Burkardt
+
+	GenRosen().range(10, I);
+	b.run("allsol_burkardt_genrosen10", make_allsol(GenRosen(), I));
+
+	Powell().range(I);
+	b.run("allsol_burkardt_powell", make_allsol(Powell(), I, 1e-10));
+
+	Wood().range(I);
+	b.run("allsol_burkardt_wood", make_allsol(Wood(), I));
+
+	Chebyquad().range(4, I);
+	b.run("allsol_burkardt_chebyquad4", make_allsol(Chebyquad(), I));
+
+	Brown().range(6, I);
+	b.run("allsol_burkardt_brown6", make_allsol(Brown(), I));
+
+	// COPRIN
+
+	Bronstein().range(I);
+	b.run("allsol_coprin_bronstein", make_allsol(Bronstein(), I));
+
+	Caprasse().range(I);
+	b.run("allsol_coprin_caprasse", make_allsol(Caprasse(), I));
+
+	Cyclo().range(I);
+	b.run("allsol_coprin_cyclo", make_allsol(Cyclo(), I));
+
+	// optimize
+
+	I.resize(2);
+	for (i=0; i<2; i++) I(i) = itv(-10., 10.);
+	b.run("minimize_levy", make_minimize(Levy(), I, 1e-6));
+	b.run("minimize_rosenbrock", make_minimize(Rosenbrock(), I, 1e-6));
+
+	Cyclo().range(I);
+	b.run("minimize_coprin_cyclo_sq", make_minimize(CycloSq(), I, 1e-4));
+
+	b.print(std::cout, format);
+}
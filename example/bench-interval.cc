@@ -0,0 +1,179 @@
+// benchmark of rounding operations and interval operations
+//
+//   ./bench-interval [text|json|csv] [min_time]
+//
+// compile with -DKV_NOHWROUND or -DKV_USE_AVX512 to measure the
+// other backends of rop<double>, and with -DBENCH_MPFR (and -lmpfr)
+// to measure interval< mpfr<106> >.
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+// rddx.hpp supports only hardware rounding mode change
+#if !defined(KV_NOHWROUND) && !defined(KV_FASTROUND)
+#include <kv/ddx.hpp>
+#include <kv/rddx.hpp>
+#define BENCH_DDX
+#endif
+#ifdef BENCH_MPFR
+#include <kv/mpfr.hpp>
+#include <kv/rmpfr.hpp>
+#endif
+#include <kv/benchmark.hpp>
+
+
+// number of operations in one call
+const int N = 1000;
+
+template <class T> struct Data {
+	std::vector<T> x, y, z;
+
+	Data() : x(N), y(N), z(N) {
+		int i;
+		for (i=0; i<N; i++) {
+			x[i] = T(1.) + T(i) / T(N);
+			y[i] = T(2.) - T(i) / T(N);
+		}
+	}
+};
+
+template <class T> struct RopAdd {
+	Data<T>& d;
+	RopAdd(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = kv::rop<T>::add_up(d.x[i], d.y[i]);
+	}
+};
+
+template <class T> struct RopMul {
+	Data<T>& d;
+	RopMul(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = kv::rop<T>::mul_up(d.x[i], d.y[i]);
+	}
+};
+
+template <class T> struct RopDiv {
+	Data<T>& d;
+	RopDiv(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = kv::rop<T>::div_up(d.x[i], d.y[i]);
+	}
+};
+
+template <class T> struct RopSqrt {
+	Data<T>& d;
+	RopSqrt(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = kv::rop<T>::sqrt_up(d.x[i]);
+	}
+};
+
+template <class T> struct Add {
+	Data<T>& d;
+	Add(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = d.x[i] + d.y[i];
+	}
+};
+
+template <class T> struct Mul {
+	Data<T>& d;
+	Mul(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = d.x[i] * d.y[i];
+	}
+};
+
+template <class T> struct Div {
+	Data<T>& d;
+	Div(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = d.x[i] / d.y[i];
+	}
+};
+
+template <class T> struct Sqrt {
+	Data<T>& d;
+	Sqrt(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = sqrt(d.x[i]);
+	}
+};
+
+template <class T> struct Exp {
+	Data<T>& d;
+	Exp(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = exp(d.x[i]);
+	}
+};
+
+template <class T> struct Log {
+	Data<T>& d;
+	Log(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = log(d.x[i]);
+	}
+};
+
+template <class T> struct Sin {
+	Data<T>& d;
+	Sin(Data<T>& d) : d(d) {}
+	void operator()() {
+		for (int i=0; i<N; i++) d.z[i] = sin(d.x[i]);
+	}
+};
+
+template <class T> void rop_bench(kv::benchmark& b, const std::string& type) {
+	Data<T> d;
+
+	b.run(type + "_add_up", RopAdd<T>(d), N);
+	b.run(type + "_mul_up", RopMul<T>(d), N);
+	b.run(type + "_div_up", RopDiv<T>(d), N);
+	b.run(type + "_sqrt_up", RopSqrt<T>(d), N);
+}
+
+// arithmetic and some elementary functions
+template <class T> void interval_bench(kv::benchmark& b, const std::string& type, bool elementary = true) {
+	Data< kv::interval<T> > d;
+
+	b.run(type + "_add", Add< kv::interval<T> >(d), N);
+	b.run(type + "_mul", Mul< kv::interval<T> >(d), N);
+	b.run(type + "_div", Div< kv::interval<T> >(d), N);
+	b.run(type + "_sqrt", Sqrt< kv::interval<T> >(d), N);
+	if (!elementary) return;
+	b.run(type + "_exp", Exp< kv::interval<T> >(d), N);
+	b.run(type + "_log", Log< kv::interval<T> >(d), N);
+	b.run(type + "_sin", Sin< kv::interval<T> >(d), N);
+}
+
+
+int main(int argc, char *argv[])
+{
+	std::string format = "text";
+	double min_time = 0.2;
+
+	if (argc >= 2) format = argv[1];
+	if (argc >= 3) min_time = std::atof(argv[2]);
+
+	kv::benchmark b("interval", min_time);
+
+	rop_bench<double>(b, "rop_double");
+	rop_bench<kv::dd>(b, "rop_dd");
+
+	interval_bench<double>(b, "interval_double");
+	interval_bench<kv::dd>(b, "interval_dd");
+#if defined(BENCH_DDX) && defined(KV_HAVE_FP80)
+	interval_bench<kv::ddx>(b, "interval_ddx");
+#endif
+#ifdef BENCH_MPFR
+	interval_bench< kv::mpfr<106> >(b, "interval_mpfr106");
+#endif
+
+	b.print(std::cout, format);
+}
@@ -0,0 +1,107 @@
+// benchmark of ODE solvers
+// one step of ode / ode_maffine and the whole solution of
+// odelong_maffine
+//
+//   ./bench-ode [text|json|csv] [min_time]
+
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <kv/ode.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/benchmark.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+struct Init {
+	ub::vector<itv> x;
+
+	Init() : x(3) {
+		x(0) = itv(15., 15.000001);
+		x(1) = itv(15., 15.000001);
+		x(2) = itv(36., 36.000001);
+	}
+};
+
+// one step (step size is chosen automatically)
+struct Step {
+	Init d;
+	kv::ode_param<double> p;
+	Step(int order) {
+		p.set_order(order);
+	}
+	void operator()() {
+		ub::vector<itv> x = d.x;
+		itv end(1.);
+		kv::ode(Lorenz(), x, itv(0.), end, p);
+	}
+};
+
+struct StepMaffine {
+	Init d;
+	kv::ode_param<double> p;
+	StepMaffine(int order) {
+		p.set_order(order);
+	}
+	void operator()() {
+		ub::vector< kv::affine<double> > x;
+		itv end(1.);
+		int maxnum_save = kv::affine<double>::maxnum();
+
+		x = d.x;
+		kv::ode_maffine(Lorenz(), x, itv(0.), end, p);
+		kv::affine<double>::maxnum() = maxnum_save;
+	}
+};
+
+// t = 0 .. 1
+struct LongMaffine {
+	Init d;
+	kv::ode_param<double> p;
+	LongMaffine(int order) {
+		p.set_order(order);
+	}
+	void operator()() {
+		ub::vector<itv> x = d.x;
+		itv end(1.);
+		kv::odelong_maffine(Lorenz(), x, itv(0.), end, p);
+	}
+};
+
+
+int main(int argc, char *argv[])
+{
+	std::string format = "text";
+	double min_time = 0.2;
+	int order;
+
+	if (argc >= 2) format = argv[1];
+	if (argc >= 3) min_time = std::atof(argv[2]);
+
+	kv::benchmark b("ode", min_time);
+
+	for (order=12; order<=24; order+=12) {
+		std::ostringstream s;
+		s << "_lorenz_order" << order;
+		b.run("ode_step" + s.str(), Step(order));
+		b.run("ode_maffine_step" + s.str(), StepMaffine(order));
+		b.run("odelong_maffine" + s.str(), LongMaffine(order));
+	}
+
+	b.print(std::cout, format);
+}
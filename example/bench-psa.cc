@@ -0,0 +1,92 @@
+// benchmark of power series arithmetic
+//
+//   ./bench-psa [text|json|csv] [min_time]
+
+#include <iostream>
+#include <cstdlib>
+#include <sstream>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/psa.hpp>
+#include <kv/benchmark.hpp>
+
+typedef kv::interval<double> itv;
+typedef kv::psa<itv> psa;
+
+
+struct Data {
+	psa x, y, z;
+
+	Data(int order) {
+		int i;
+
+		x.v.resize(order + 1);
+		y.v.resize(order + 1);
+		for (i=0; i<=order; i++) {
+			x.v(i) = itv(1., 1.125) / (i + 1);
+			y.v(i) = itv(2., 2.125) / (i + 2);
+		}
+	}
+};
+
+struct Mul {
+	Data& d;
+	Mul(Data& d) : d(d) {}
+	void operator()() {
+		d.z = d.x * d.y;
+	}
+};
+
+struct Div {
+	Data& d;
+	Div(Data& d) : d(d) {}
+	void operator()() {
+		d.z = d.x / d.y;
+	}
+};
+
+struct Exp {
+	Data& d;
+	Exp(Data& d) : d(d) {}
+	void operator()() {
+		d.z = exp(d.x);
+	}
+};
+
+struct Sin {
+	Data& d;
+	Sin(Data& d) : d(d) {}
+	void operator()() {
+		d.z = sin(d.x);
+	}
+};
+
+
+int main(int argc, char *argv[])
+{
+	std::string format = "text";
+	double min_time = 0.2;
+	int order, mode;
+
+	if (argc >= 2) format = argv[1];
+	if (argc >= 3) min_time = std::atof(argv[2]);
+
+	kv::benchmark b("psa", min_time);
+
+	for (mode=1; mode<=2; mode++) {
+		psa::mode() = mode;
+		psa::domain() = itv(0., 0.125);
+		for (order=10; order<=40; order+=10) {
+			Data d(order);
+			std::ostringstream s;
+			s << "_type" << mode << "_order" << order;
+			b.run("mul" + s.str(), Mul(d));
+			b.run("div" + s.str(), Div(d));
+			b.run("exp" + s.str(), Exp(d));
+			b.run("sin" + s.str(), Sin(d));
+		}
+	}
+	psa::mode() = 1;
+
+	b.print(std::cout, format);
+}
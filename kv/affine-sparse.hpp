@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef AFFINE_SPARSE_HPP
+#define AFFINE_SPARSE_HPP
+
+// sparse storage of the coefficients of affine<T>.
+// affine<T> uses it instead of ub::vector<T> if AFFINE_SPARSE != 0
+// (see affine.hpp).
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+/*
+ * a(0) and (number, coefficient) pairs of nonzero a(i), i >= 1,
+ * sorted by number. size(), resize() and a(i) can be used as
+ * ub::vector<T>. the coefficients which are not stored are 0.
+ */
+
+template <class T> class affine_sparse_vector {
+	public:
+	T v0;
+	std::vector<int> idx;
+	std::vector<T> coef;
+	int n;
+
+	affine_sparse_vector() : n(0) {
+	}
+
+	int size() const {
+		return n;
+	}
+
+	// the coefficients a(s), a(s+1), ... are removed.
+	// the new coefficients are 0.
+	void resize(int s, bool preserve = true) {
+		int k;
+
+		if (n == 0 || !preserve) v0 = 0.;
+		if (!preserve) k = 0;
+		else k = std::lower_bound(idx.begin(), idx.end(), s) - idx.begin();
+		idx.resize(k);
+		coef.resize(k);
+		n = s;
+	}
+
+	T operator()(int i) const {
+		std::vector<int>::const_iterator p;
+
+		if (i == 0) return v0;
+		p = std::lower_bound(idx.begin(), idx.end(), i);
+		if (p == idx.end() || *p != i) return T(0.);
+		else return coef[p - idx.begin()];
+	}
+
+	// the coefficient is inserted if it is not stored
+	T& operator()(int i) {
+		std::vector<int>::iterator p;
+		int k;
+
+		if (i == 0) return v0;
+		p = std::lower_bound(idx.begin(), idx.end(), i);
+		k = p - idx.begin();
+		if (p == idx.end() || *p != i) {
+			idx.insert(p, i);
+			coef.insert(coef.begin() + k, T(0.));
+		}
+		return coef[k];
+	}
+};
+
+
+namespace affine_sub {
+
+template <class T> inline int nnz(const affine_sparse_vector<T>& a) {
+	return a.n == 0 ? 0 : a.idx.size() + 1;
+}
+
+template <class T> inline int index(const affine_sparse_vector<T>& a, int k) {
+	return k <= 0 ? k : a.idx[k-1];
+}
+
+template <class T> inline const T& value(const affine_sparse_vector<T>& a, int k) {
+	return k == 0 ? a.v0 : a.coef[k-1];
+}
+
+template <class T> inline void start(affine_sparse_vector<T>& r, int n) {
+	r.v0 = 0.;
+	r.idx.clear();
+	r.coef.clear();
+	r.n = n;
+}
+
+// zero is not stored
+template <class T> inline void push(affine_sparse_vector<T>& r, int i, const T& v) {
+	if (i == 0) {
+		r.v0 = v;
+	} else if (v != 0.) {
+		r.idx.push_back(i);
+		r.coef.push_back(v);
+	}
+}
+
+template <class T> inline void finish(affine_sparse_vector<T>&, int) {
+}
+
+template <class T> inline void add(const affine_sparse_vector<T>& x, const affine_sparse_vector<T>& y, affine_sparse_vector<T>& r, T& err) {
+	int xs, ys, i, j;
+	T tmp;
+
+	xs = x.idx.size();
+	ys = y.idx.size();
+	r.idx.reserve(xs + ys + 1);
+	r.coef.reserve(xs + ys + 1);
+
+	r.v0 = rop<T>::add_down(x.v0, y.v0);
+	err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x.v0, y.v0), r.v0));
+	i = j = 0;
+	while (i < xs || j < ys) {
+		if (j == ys || (i < xs && x.idx[i] < y.idx[j])) {
+			push(r, x.idx[i], x.coef[i]);
+			i++;
+		} else if (i == xs || x.idx[i] > y.idx[j]) {
+			push(r, y.idx[j], y.coef[j]);
+			j++;
+		} else {
+			tmp = rop<T>::add_down(x.coef[i], y.coef[j]);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x.coef[i], y.coef[j]), tmp));
+			push(r, x.idx[i], tmp);
+			i++; j++;
+		}
+	}
+}
+
+template <class T> inline void sub(const affine_sparse_vector<T>& x, const affine_sparse_vector<T>& y, affine_sparse_vector<T>& r, T& err) {
+	int xs, ys, i, j;
+	T tmp;
+
+	xs = x.idx.size();
+	ys = y.idx.size();
+	r.idx.reserve(xs + ys + 1);
+	r.coef.reserve(xs + ys + 1);
+
+	r.v0 = rop<T>::sub_down(x.v0, y.v0);
+	err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x.v0, y.v0), r.v0));
+	i = j = 0;
+	while (i < xs || j < ys) {
+		if (j == ys || (i < xs && x.idx[i] < y.idx[j])) {
+			push(r, x.idx[i], x.coef[i]);
+			i++;
+		} else if (i == xs || x.idx[i] > y.idx[j]) {
+			push(r, y.idx[j], T(- y.coef[j]));
+			j++;
+		} else {
+			tmp = rop<T>::sub_down(x.coef[i], y.coef[j]);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x.coef[i], y.coef[j]), tmp));
+			push(r, x.idx[i], tmp);
+			i++; j++;
+		}
+	}
+}
+
+template <class T> inline void mul_lin(const affine_sparse_vector<T>& x, const affine_sparse_vector<T>& y, affine_sparse_vector<T>& r, T& err) {
+	int xs, ys, i, j;
+	T tmp;
+
+	xs = x.idx.size();
+	ys = y.idx.size();
+	r.idx.reserve(xs + ys + 1);
+	r.coef.reserve(xs + ys + 1);
+
+	i = j = 0;
+	while (i < xs || j < ys) {
+		if (j == ys || (i < xs && x.idx[i] < y.idx[j])) {
+			tmp = rop<T>::mul_down(y.v0, x.coef[i]);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(y.v0, x.coef[i]), tmp));
+			push(r, x.idx[i], tmp);
+			i++;
+		} else if (i == xs || x.idx[i] > y.idx[j]) {
+			tmp = rop<T>::mul_down(x.v0, y.coef[j]);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.v0, y.coef[j]), tmp));
+			push(r, y.idx[j], tmp);
+			j++;
+		} else {
+			tmp = rop<T>::add_down(rop<T>::mul_down(y.v0, x.coef[i]), rop<T>::mul_down(x.v0, y.coef[j]));
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y.v0, x.coef[i]), rop<T>::mul_up(x.v0, y.coef[j])), tmp));
+			push(r, x.idx[i], tmp);
+			i++; j++;
+		}
+	}
+}
+
+template <class T> inline void append(const affine_sparse_vector<T>& x, const affine_sparse_vector<T>& y, affine_sparse_vector<T>& r) {
+	int xs, ys, i, j;
+
+	xs = x.idx.size();
+	ys = y.idx.size();
+	r.idx.reserve(xs + ys);
+	r.coef.reserve(xs + ys);
+
+	r.v0 = x.v0 + y.v0;
+	i = j = 0;
+	while (i < xs || j < ys) {
+		if (j == ys || (i < xs && x.idx[i] < y.idx[j])) {
+			push(r, x.idx[i], x.coef[i]);
+			i++;
+		} else if (i == xs || x.idx[i] > y.idx[j]) {
+			push(r, y.idx[j], y.coef[j]);
+			j++;
+		} else {
+			push(r, x.idx[i], T(x.coef[i] + y.coef[j]));
+			i++; j++;
+		}
+	}
+}
+
+} // namespace affine_sub
+
+} // namespace kv
+
+#endif // AFFINE_SPARSE_HPP
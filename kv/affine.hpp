@@ -20,6 +20,7 @@
 #include <kv/rdouble.hpp>
 
 #include <kv/convert.hpp>
+#include <kv/affine-sparse.hpp>
 
 
 /*
@@ -49,6 +50,18 @@
 #define AFFINE_MULT 0
 #endif
 
+/*
+ * select the storage of noise symbols
+ *
+ *  0: dense vector indexed by noise symbol number (default)
+ *  1: sparse (number, coefficient) pairs sorted by number
+ *     (see affine-sparse.hpp)
+ */
+
+#ifndef AFFINE_SPARSE
+#define AFFINE_SPARSE 0
+#endif
+
 
 namespace kv {
 
@@ -81,9 +94,247 @@ template <class C, class T> struct convertible<C, affine<T> > {
 
 
 
+#if AFFINE_MULT >= 1
+
+// error of the product of two affine forms whose coefficients are
+// given in vx(1..n) and vy(1..n)
+
+template <class T> inline interval<T> affine_mult_error(const ub::vector<T>& vx, const ub::vector<T>& vy, int n) {
+	int i, j;
+	kv::interval<T> tmp, C, D, E, X, Y;
+
+	E = 0.;
+
+	#if AFFINE_MULT == 1
+	for (i=1; i<=n; i++) {
+		X = vx(i);
+		Y = vy(i);
+		E += X * Y * interval<T>(0., 1.);
+		for (j=i+1; j<=n; j++) {
+			tmp = X * vy(j) + Y * vx(j);
+			E += tmp * interval<T>(-1., 1.);
+		}
+	}
+	#else // AFFINE_MULT == 1
+
+	for (i=1; i<=n; i++) {
+		X = vx(i);
+		Y = vy(i);
+		if (X == 0. && Y == 0.) continue;
+		C = D = 0.;
+		for (j=1; j<=n; j++) {
+			if (j == i) continue;
+			if (vy(j) == 0. && vx(j) == 0.) continue;
+			tmp = X * vy(j) - Y * vx(j);
+			if (tmp.lower() >= 0.) {
+				C += vx(j);
+				D += vy(j);
+			} else if (tmp.upper() <= 0.) {
+				C -= vx(j);
+				D -= vy(j);
+			} else {
+				if ((X.upper() > 0. && vx(j) < 0.)
+				|| (X.lower() < 0. && vx(j) > 0.)) {
+					X -= vx(j);
+					Y -= vy(j);
+				} else {
+					X += vx(j);
+					Y += vy(j);
+				}
+			}
+		}
+		E = interval<T>::hull(E, X * Y + (X * D + Y * C) + C * D);
+		E = interval<T>::hull(E, X * Y - (X * D + Y * C) + C * D);
+		if (!zero_in(X * Y) ){
+			tmp = -0.5 * (X * D + Y * C) / (X * Y);
+			if (overlap(tmp, interval<T>(-1., 1.))) {
+				E = interval<T>::hull(E, X * Y * tmp * tmp + (X * D + Y * C) * tmp + C * D);
+			}
+		}
+	}
+
+	#endif // AFFINE_MULT == 1
+
+	return E;
+}
+
+#endif // AFFINE_MULT >= 1
+
+
+/*
+ * access to the coefficients a(0), a(1), ... of affine<T>.
+ * the arithmetic of affine<T> is written with the following functions,
+ * which are overloaded for ub::vector<T> (dense storage, below) and
+ * affine_sparse_vector<T> (sparse storage, affine-sparse.hpp).
+ *
+ *  nnz(a)          : number of stored coefficients (a(0) is the first)
+ *  index(a, k)     : noise symbol number of k-th stored coefficient
+ *  value(a, k)     : k-th stored coefficient
+ *  start(r, n)     : prepare r of size n to be written by push
+ *  push(r, i, v)   : r(i) = v. i must be increasing.
+ *  finish(r, n)    : after push, coefficients r(n) ... are 0
+ *  add, sub, mul_lin, append : coefficients of the linear operations
+ *                    (called in rop<T>::begin() ... rop<T>::end())
+ */
+
+namespace affine_sub {
+
+template <class T> inline int nnz(const ub::vector<T>& a) {
+	return a.size();
+}
+
+template <class T> inline int index(const ub::vector<T>&, int k) {
+	return k;
+}
+
+template <class T> inline const T& value(const ub::vector<T>& a, int k) {
+	return a(k);
+}
+
+template <class T> inline void start(ub::vector<T>& r, int n) {
+	r.resize(n);
+}
+
+template <class T> inline void push(ub::vector<T>& r, int i, const T& v) {
+	r(i) = v;
+}
+
+template <class T> inline void finish(ub::vector<T>& r, int n) {
+	int i;
+	for (i=n; i<(int)r.size(); i++) r(i) = 0.;
+}
+
+// r = x + y, rounding errors are added to err
+template <class T> inline void add(const ub::vector<T>& x, const ub::vector<T>& y, ub::vector<T>& r, T& err) {
+	int xs, ys, i;
+
+	xs = x.size();
+	ys = y.size();
+	if (xs > ys) {
+		for (i=0; i<ys; i++) {
+			r(i) = rop<T>::add_down(x(i), y(i));
+		}
+		for (i=0; i<ys; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x(i), y(i)), r(i)));
+		}
+		for (i=ys; i<xs; i++) {
+			r(i) = x(i);
+		}
+		finish(r, xs);
+	} else {
+		for (i=0; i<xs; i++) {
+			r(i) = rop<T>::add_down(x(i), y(i));
+		}
+		for (i=0; i<xs; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x(i), y(i)), r(i)));
+		}
+		for (i=xs; i<ys; i++) {
+			r(i) = y(i);
+		}
+		finish(r, ys);
+	}
+}
+
+// r = x - y
+template <class T> inline void sub(const ub::vector<T>& x, const ub::vector<T>& y, ub::vector<T>& r, T& err) {
+	int xs, ys, i;
+
+	xs = x.size();
+	ys = y.size();
+	if (xs > ys) {
+		for (i=0; i<ys; i++) {
+			r(i) = rop<T>::sub_down(x(i), y(i));
+		}
+		for (i=0; i<ys; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x(i), y(i)), r(i)));
+		}
+		for (i=ys; i<xs; i++) {
+			r(i) = x(i);
+		}
+		finish(r, xs);
+	} else {
+		for (i=0; i<xs; i++) {
+			r(i) = rop<T>::sub_down(x(i), y(i));
+		}
+		for (i=0; i<xs; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x(i), y(i)), r(i)));
+		}
+		for (i=xs; i<ys; i++) {
+			r(i) = - y(i);
+		}
+		finish(r, ys);
+	}
+}
+
+// r(i) = y(0) * x(i) + x(0) * y(i) (i >= 1)
+template <class T> inline void mul_lin(const ub::vector<T>& x, const ub::vector<T>& y, ub::vector<T>& r, T& err) {
+	int xs, ys, i;
+
+	xs = x.size();
+	ys = y.size();
+	if (xs > ys) {
+		for (i=1; i<ys; i++) {
+			r(i) = rop<T>::add_down(rop<T>::mul_down(y(0), x(i)), rop<T>::mul_down(x(0), y(i)));
+		}
+		for (i=ys; i<xs; i++) {
+			r(i) = rop<T>::mul_down(y(0), x(i));
+		}
+		for (i=1; i<ys; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y(0), x(i)), rop<T>::mul_up(x(0), y(i))), r(i)));
+		}
+		for (i=ys; i<xs; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(y(0), x(i)), r(i)));
+		}
+		finish(r, xs);
+	} else {
+		for (i=1; i<xs; i++) {
+			r(i) = rop<T>::add_down(rop<T>::mul_down(y(0), x(i)), rop<T>::mul_down(x(0), y(i)));
+		}
+		for (i=xs; i<ys; i++) {
+			r(i) = rop<T>::mul_down(x(0), y(i));
+		}
+		for (i=1; i<xs; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y(0), x(i)), rop<T>::mul_up(x(0), y(i))), r(i)));
+		}
+		for (i=xs; i<ys; i++) {
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x(0), y(i)), r(i)));
+		}
+		finish(r, ys);
+	}
+}
+
+// r = x + y without rounding control
+template <class T> inline void append(const ub::vector<T>& x, const ub::vector<T>& y, ub::vector<T>& r) {
+	int xs, ys, i;
+
+	xs = x.size();
+	ys = y.size();
+	if (xs > ys) {
+		for (i=0; i<ys; i++) {
+			r(i) = x(i) + y(i);
+		}
+		for (i=ys; i<xs; i++) {
+			r(i) = x(i);
+		}
+	} else {
+		for (i=0; i<xs; i++) {
+			r(i) = x(i) + y(i);
+		}
+		for (i=xs; i<ys; i++) {
+			r(i) = y(i);
+		}
+	}
+}
+
+} // namespace affine_sub
+
 template <class T> class affine {
 	public:
+	#if AFFINE_SPARSE == 0
 	ub::vector<T> a;
+	#else
+	affine_sparse_vector<T> a;
+	#endif
 	#if AFFINE_SIMPLE >= 1
 	T er;
 	#endif
@@ -99,15 +350,15 @@ template <class T> class affine {
 	}
 
 	friend inline T rad(const affine& x) {
-		int i, xs;
+		int k, xn;
 		T r(0.);
 
-		xs = x.a.size();
+		xn = affine_sub::nnz(x.a);
 
 		rop<T>::begin();
-		for (i=1; i<xs; i++) {
+		for (k=1; k<xn; k++) {
 			using std::abs;
-			r = rop<T>::add_up(r, abs(x.a(i)));
+			r = rop<T>::add_up(r, abs(affine_sub::value(x.a, k)));
 		}
 		#if AFFINE_SIMPLE >= 1
 		r = rop<T>::add_up(r, x.er);
@@ -141,18 +392,18 @@ template <class T> class affine {
 	}
 
 	template <class C> explicit affine(const C& x, typename boost::enable_if_c< acceptable_s<C, affine>::value >::type* =0) {
-		int i;
 		interval<T> I(x);
+		T r;
 		maxnum()++;
-		a.resize(maxnum()+1);
-
+		affine_sub::start(a, maxnum()+1);
+		affine_sub::finish(a, 1);
 
 		rop<T>::begin();
 		a(0) = rop<T>::mul_up(rop<T>::add_up(I.upper(), I.lower()), T(0.5));
-		a(maxnum()) = rop<T>::sub_up(a(0), I.lower());
+		r = rop<T>::sub_up(a(0), I.lower());
 		rop<T>::end();
 
-		for (i=1; i<maxnum(); i++) a(i) = 0.;
+		affine_sub::push(a, maxnum(), r);
 
 		#if AFFINE_SIMPLE >= 1
 		er = 0.;
@@ -170,27 +421,12 @@ template <class T> class affine {
 	}
 
 	template <class C> typename boost::enable_if_c< acceptable_s<C, affine>::value, affine& >::type operator=(const C& x) {
-		int i;
-		interval<T> I(x);
-		maxnum()++;
-		a.resize(maxnum()+1);
-
-		rop<T>::begin();
-		a(0) = rop<T>::mul_up(rop<T>::add_up(I.upper(), I.lower()), T(0.5));
-		a(maxnum()) = rop<T>::sub_up(a(0), I.lower());
-		rop<T>::end();
-
-		for (i=1; i<maxnum(); i++) a(i) = 0.;
-
-		#if AFFINE_SIMPLE >= 1
-		er = 0.;
-		#endif
-
+		*this = affine(x);
 		return *this;
 	}
 
 	T get_coef (int i) const {
-		if (i >= a.size()) return T(0.);
+		if (i >= (int)a.size()) return T(0.);
 		else return a(i);
 	}
 
@@ -206,67 +442,35 @@ template <class T> class affine {
 		#endif
 	}
 
+	void set_mid(const T& x) {
+		a(0) = x;
+	}
+
+	// largest number of noise symbol which may have nonzero coefficient
+	int get_maxindex() const {
+		return affine_sub::index(a, affine_sub::nnz(a) - 1);
+	}
+
 	friend affine operator+(const affine& x, const affine& y) {
 		affine r;
-		int xs, ys, i;
 		T err(0.);
 
 		#if AFFINE_SIMPLE == 0
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
+		#else
+		affine_sub::start(r.a, std::max(x.a.size(), y.a.size()));
 		#endif
 
-		xs = x.a.size();
-		ys = y.a.size();
-		if (xs > ys) {
-			#if AFFINE_SIMPLE >= 1
-			r.a.resize(xs);
-			#endif
-			rop<T>::begin();
-			for (i=0; i<ys; i++) {
-				r.a(i) = rop<T>::add_down(x.a(i), y.a(i));
-			}
-			for (i=0; i<ys; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x.a(i), y.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-
-			for (i=ys; i<xs; i++) {
-				r.a(i) = x.a(i);
-			}
-			#if AFFINE_SIMPLE == 0
-			for (i=xs; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		} else {
-			#if AFFINE_SIMPLE >= 1
-			r.a.resize(ys);
-			#endif
-			rop<T>::begin();
-			for (i=0; i<xs; i++) {
-				r.a(i) = rop<T>::add_down(x.a(i), y.a(i));
-			}
-			for (i=0; i<xs; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x.a(i), y.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-
-			for (i=xs; i<ys; i++) {
-				r.a(i) = y.a(i);
-			}
-			#if AFFINE_SIMPLE == 0
-			for (i=ys; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		}
-		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
+		affine_sub::add(x.a, y.a, r.a, err);
+		#if AFFINE_SIMPLE >= 1
 		r.er = rop<T>::add_up(rop<T>::add_up(x.er, y.er), err);
+		#endif
 		rop<T>::end();
-		#else
-		r.a(maxnum()) = err;
+
+		#if AFFINE_SIMPLE == 0
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
@@ -277,105 +481,70 @@ template <class T> class affine {
 
 	friend affine append(const affine& x, const affine& y) {
 		affine r;
-		int xs, ys, i;
 
-		xs = x.a.size();
-		ys = y.a.size();
-
-		if (xs > ys) {
-			r.a.resize(xs);
-			for (i=0; i<ys; i++) {
-				r.a(i) = x.a(i) + y.a(i);
-			}
-			for (i=ys; i<xs; i++) {
-				r.a(i) = x.a(i);
-			}
-		} else {
-			r.a.resize(ys);
-			for (i=0; i<xs; i++) {
-				r.a(i) = x.a(i) + y.a(i);
-			}
-			for (i=xs; i<ys; i++) {
-				r.a(i) = y.a(i);
-			}
-		}
+		affine_sub::start(r.a, std::max(x.a.size(), y.a.size()));
+		affine_sub::append(x.a, y.a, r.a);
 		#if AFFINE_SIMPLE >= 1
 		r.er = x.er + y.er;
 		#endif
 		return r;
 	}
 
+	// r = x with r(0) = c
+	static void copy_coef(const affine& x, affine& r, const T& c) {
+		int k, xn;
 
-	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator+(const affine& x, const C& y) {
-		affine r;
-		int xs, i;
-		T err;
-
-		xs = x.a.size();
-
+		xn = affine_sub::nnz(x.a);
 		#if AFFINE_SIMPLE == 0
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
 		#else
-		r.a.resize(xs);
+		affine_sub::start(r.a, x.a.size());
 		#endif
 
+		r.a(0) = c;
+		for (k=1; k<xn; k++) {
+			affine_sub::push(r.a, affine_sub::index(x.a, k), affine_sub::value(x.a, k));
+		}
+		affine_sub::finish(r.a, x.a.size());
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator+(const affine& x, const C& y) {
+		affine r;
+		T c, err;
+
 		rop<T>::begin();
-		r.a(0) = rop<T>::add_down(x.a(0), (T)y);
-		err = rop<T>::sub_up(rop<T>::add_up(x.a(0), (T)y), r.a(0));
+		c = rop<T>::add_down(x.a(0), (T)y);
+		err = rop<T>::sub_up(rop<T>::add_up(x.a(0), (T)y), c);
 		rop<T>::end();
 
-		for (i=1; i<xs; i++) {
-			r.a(i) = x.a(i);
-		}
-		#if AFFINE_SIMPLE == 0
-		for (i=xs; i<maxnum(); i++) {
-			r.a(i) = 0.;
-		}
-		#endif
+		copy_coef(x, r, c);
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(x.er, err);
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator+(const C& x, const affine& y) {
 		affine r;
-		int ys, i;
-		T err;
-
-		ys = y.a.size();
-
-		#if AFFINE_SIMPLE == 0
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#else
-		r.a.resize(ys);
-		#endif
+		T c, err;
 
 		rop<T>::begin();
-		r.a(0) = rop<T>::add_down((T)x, y.a(0));
-		err = rop<T>::sub_up(rop<T>::add_up((T)x, y.a(0)), r.a(0));
+		c = rop<T>::add_down((T)x, y.a(0));
+		err = rop<T>::sub_up(rop<T>::add_up((T)x, y.a(0)), c);
 		rop<T>::end();
 
-		for (i=1; i<ys; i++) {
-			r.a(i) = y.a(i);
-		}
-		#if AFFINE_SIMPLE == 0
-		for (i=ys; i<maxnum(); i++) {
-			r.a(i) = 0.;
-		}
-		#endif
+		copy_coef(y, r, c);
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(y.er, err);
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
@@ -405,139 +574,64 @@ template <class T> class affine {
 
 	friend affine operator-(const affine& x, const affine& y) {
 		affine r;
-		int xs, ys, i;
 		T err(0.);
 
 		#if AFFINE_SIMPLE == 0
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
+		#else
+		affine_sub::start(r.a, std::max(x.a.size(), y.a.size()));
 		#endif
 
-		xs = x.a.size();
-		ys = y.a.size();
-		if (xs > ys) {
-			#if AFFINE_SIMPLE >= 1
-			r.a.resize(xs);
-			#endif
-			rop<T>::begin();
-			for (i=0; i<ys; i++) {
-				r.a(i) = rop<T>::sub_down(x.a(i), y.a(i));
-			}
-			for (i=0; i<ys; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x.a(i), y.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-
-			for (i=ys; i<xs; i++) {
-				r.a(i) = x.a(i);
-			}
-			#if AFFINE_SIMPLE == 0
-			for (i=xs; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		} else {
-			#if AFFINE_SIMPLE >= 1
-			r.a.resize(ys);
-			#endif
-			rop<T>::begin();
-			for (i=0; i<xs; i++) {
-				r.a(i) = rop<T>::sub_down(x.a(i), y.a(i));
-			}
-			for (i=0; i<xs; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x.a(i), y.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-
-			for (i=xs; i<ys; i++) {
-				r.a(i) = - y.a(i);
-			}
-			#if AFFINE_SIMPLE == 0
-			for (i=ys; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		}
-		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
+		affine_sub::sub(x.a, y.a, r.a, err);
+		#if AFFINE_SIMPLE >= 1
 		r.er = rop<T>::add_up(rop<T>::add_up(x.er, y.er), err);
+		#endif
 		rop<T>::end();
-		#else
-		r.a(maxnum()) = err;
+
+		#if AFFINE_SIMPLE == 0
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator-(const affine& x, const C& y) {
 		affine r;
-		int xs, i;
-		T err;
-
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 0
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#else
-		r.a.resize(xs);
-		#endif
+		T c, err;
 
 		rop<T>::begin();
-		r.a(0) = rop<T>::sub_down(x.a(0), (T)y);
-		err = rop<T>::sub_up(rop<T>::sub_up(x.a(0), (T)y), r.a(0));
+		c = rop<T>::sub_down(x.a(0), (T)y);
+		err = rop<T>::sub_up(rop<T>::sub_up(x.a(0), (T)y), c);
 		rop<T>::end();
 
-		for (i=1; i<xs; i++) {
-			r.a(i) = x.a(i);
-		}
-		#if AFFINE_SIMPLE == 0
-		for (i=xs; i<maxnum(); i++) {
-			r.a(i) = 0.;
-		}
-		#endif
+		copy_coef(x, r, c);
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(x.er, err);
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator-(const C& x, const affine& y) {
 		affine r;
-		int ys, i;
-		T err;
-
-		ys = y.a.size();
-
-		#if AFFINE_SIMPLE == 0
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#else
-		r.a.resize(ys);
-		#endif
+		T c, err;
 
 		rop<T>::begin();
-		r.a(0) = rop<T>::sub_down((T)x, y.a(0));
-		err = rop<T>::sub_up(rop<T>::sub_up((T)x, y.a(0)), r.a(0));
+		c = rop<T>::sub_down((T)x, y.a(0));
+		err = rop<T>::sub_up(rop<T>::sub_up((T)x, y.a(0)), c);
 		rop<T>::end();
 
-		for (i=1; i<ys; i++) {
-			r.a(i) = - y.a(i);
-		}
-		#if AFFINE_SIMPLE == 0
-		for (i=ys; i<maxnum(); i++) {
-			r.a(i) = 0.;
-		}
-		#endif
+		copy_coef(-y, r, c);
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(y.er, err);
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 		return r;
 	}
@@ -567,8 +661,13 @@ template <class T> class affine {
 
 	friend affine operator-(const affine& x) {
 		affine r;
+		int k, xn;
 
-		r.a = - x.a;
+		xn = affine_sub::nnz(x.a);
+		affine_sub::start(r.a, x.a.size());
+		for (k=0; k<xn; k++) {
+			affine_sub::push(r.a, affine_sub::index(x.a, k), - affine_sub::value(x.a, k));
+		}
 		#if AFFINE_SIMPLE >= 1
 		r.er = x.er;
 		#endif
@@ -577,78 +676,41 @@ template <class T> class affine {
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator*(const affine& x, const C& y) {
 		affine r;
-		int xs, i;
-		T err(0.);
+		int k, xn;
+		T err(0.), tmp;
 
-		xs = x.a.size();
+		xn = affine_sub::nnz(x.a);
 
 		#if AFFINE_SIMPLE == 0
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
 		#else
-		r.a.resize(xs);
+		affine_sub::start(r.a, x.a.size());
 		#endif
 
 		rop<T>::begin();
-		for (i=0; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), (T)y);
-		}
-		for (i=0; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), (T)y), r.a(i)));
+		for (k=0; k<xn; k++) {
+			tmp = rop<T>::mul_down(affine_sub::value(x.a, k), (T)y);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(affine_sub::value(x.a, k), (T)y), tmp));
+			affine_sub::push(r.a, affine_sub::index(x.a, k), tmp);
 		}
 		rop<T>::end();
 
-		#if AFFINE_SIMPLE == 0
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
+		affine_sub::finish(r.a, x.a.size());
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		using std::abs;
 		r.er = rop<T>::add_up(rop<T>::mul_up(x.er, T(abs(y))), err);
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator*(const C& x, const affine& y) {
-		affine r;
-		int ys, i;
-		T err(0.);
-
-		ys = y.a.size();
-
-		#if AFFINE_SIMPLE == 0
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#else
-		r.a.resize(ys);
-		#endif
-
-		rop<T>::begin();
-		for (i=0; i<ys; i++) {
-			r.a(i) = rop<T>::mul_down((T)x, y.a(i));
-		}
-		for (i=0; i<ys; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up((T)x, y.a(i)), r.a(i)));
-		}
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 0
-		for (i=ys; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		#if AFFINE_SIMPLE >= 1
-		rop<T>::begin();
-		using std::abs;
-		r.er = rop<T>::add_up(rop<T>::mul_up(y.er, T(abs(x))), err);
-		rop<T>::end();
-		#else
-		r.a(maxnum()) = err;
-		#endif
-
-		return r;
+		return y * x;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_s<C, affine>::value, affine >::type operator*(const affine& x, const C& y) {
@@ -664,32 +726,30 @@ template <class T> class affine {
 
 	static interval<T> bestmult_error(const affine& x, const affine& y)
 	{
-		int n, i, j, s;
-		bool f1, f2;
+		int n, i, j, xn, yn;
 		ub::vector<T> vx, vy;
-		kv::interval<T> tmp, C, D, E, X, Y;
-
-		n = std::max(x.a.size(), y.a.size()) - 1;
 
-		#if AFFINE_SIMPLE >= 1
-		vx.resize(n+3);
-		vy.resize(n+3);
-		#else
-		vx.resize(n+1);
-		vy.resize(n+1);
-		#endif
-
-		for (i=0; i<x.a.size(); i++) {
-			vx(i) = x.a(i);
-		}
-		for (i=x.a.size(); i<=n; i++) {
-			vx(i) = 0.;
-		}
-		for (i=0; i<y.a.size(); i++) {
-			vy(i) = y.a(i);
-		}
-		for (i=y.a.size(); i<=n; i++) {
-			vy(i) = 0.;
+		xn = affine_sub::nnz(x.a);
+		yn = affine_sub::nnz(y.a);
+
+		// the noise symbols appearing in x or y
+		vx.resize(xn + yn + 3);
+		vy.resize(xn + yn + 3);
+
+		n = 0;
+		i = j = 1;
+		while (i < xn || j < yn) {
+			n++;
+			if (j == yn || (i < xn && affine_sub::index(x.a, i) < affine_sub::index(y.a, j))) {
+				vx(n) = affine_sub::value(x.a, i++);
+				vy(n) = 0.;
+			} else if (i == xn || affine_sub::index(x.a, i) > affine_sub::index(y.a, j)) {
+				vx(n) = 0.;
+				vy(n) = affine_sub::value(y.a, j++);
+			} else {
+				vx(n) = affine_sub::value(x.a, i++);
+				vy(n) = affine_sub::value(y.a, j++);
+			}
 		}
 
 		#if AFFINE_SIMPLE >= 1
@@ -700,128 +760,31 @@ template <class T> class affine {
 		n += 2;
 		#endif
 
-		E = 0.;
-
-		#if AFFINE_MULT == 1
-		for (i=1; i<=n; i++) {
-			X = vx(i);
-			Y = vy(i);
-			E += X * Y * interval<T>(0., 1.);
-			for (j=i+1; j<=n; j++) {
-				tmp = X * vy(j) + Y * vx(j);
-				E += tmp * interval<T>(-1., 1.);
-			}
-		}
-		#else // AFFINE_MULT == 1
-
-		for (i=1; i<=n; i++) {
-			X = vx(i);
-			Y = vy(i);
-			if (X == 0. && Y == 0.) continue;
-			C = D = 0.;
-			for (j=1; j<=n; j++) {
-				if (j == i) continue;
-				if (vy(j) == 0. && vx(j) == 0.) continue;
-				tmp = X * vy(j) - Y * vx(j);
-				if (tmp.lower() >= 0.) {
-					C += vx(j);
-					D += vy(j);
-				} else if (tmp.upper() <= 0.) {
-					C -= vx(j);
-					D -= vy(j);
-				} else {
-					if ((X.upper() > 0. && vx(j) < 0.)
-					|| (X.lower() < 0. && vx(j) > 0.)) {
-						X -= vx(j);
-						Y -= vy(j);
-					} else {
-						X += vx(j);
-						Y += vy(j);
-					}
-				}
-			}
-			E = interval<T>::hull(E, X * Y + (X * D + Y * C) + C * D);
-			E = interval<T>::hull(E, X * Y - (X * D + Y * C) + C * D);
-			if (!zero_in(X * Y) ){
-				tmp = -0.5 * (X * D + Y * C) / (X * Y);
-				if (overlap(tmp, interval<T>(-1., 1.))) {
-					E = interval<T>::hull(E, X * Y * tmp * tmp + (X * D + Y * C) * tmp + C * D);
-				}
-			}
-		}
-
-		#endif // AFFINE_MULT == 1
-
-		return E;
+		return affine_mult_error(vx, vy, n);
 	}
 
 	#endif // AFFINE_MULT >= 1
 
 	friend affine operator*(const affine& x, const affine& y) {
 		affine r;
-		int i, j, xs, ys;
 		T err;
 		T tmp_u, tmp_l;
 
 		// if (&x == &y) return square(x);
 
-		xs = x.a.size();
-		ys = y.a.size();
-
 		#if AFFINE_SIMPLE != 2
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
 		#else
-		r.a.resize(std::max(xs, ys));
+		affine_sub::start(r.a, std::max(x.a.size(), y.a.size()));
 		#endif
 
 		rop<T>::begin();
 		r.a(0) = rop<T>::mul_down(x.a(0), y.a(0));
 		err = rop<T>::sub_up(rop<T>::mul_up(x.a(0), y.a(0)), r.a(0));
+		affine_sub::mul_lin(x.a, y.a, r.a, err);
 		rop<T>::end();
 
-		if (xs > ys) {
-			rop<T>::begin();
-			for (i=1; i<ys; i++) {
-				r.a(i) = rop<T>::add_down(rop<T>::mul_down(y.a(0), x.a(i)), rop<T>::mul_down(x.a(0), y.a(i)));
-			}
-			for (i=ys; i<xs; i++) {
-				r.a(i) = rop<T>::mul_down(y.a(0), x.a(i));
-			}
-			for (i=1; i<ys; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y.a(0), x.a(i)), rop<T>::mul_up(x.a(0), y.a(i))), r.a(i)));
-			}
-			for (i=ys; i<xs; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(y.a(0), x.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-			#if AFFINE_SIMPLE != 2
-			for (i=xs; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		} else {
-			rop<T>::begin();
-			for (i=1; i<xs; i++) {
-				r.a(i) = rop<T>::add_down(rop<T>::mul_down(y.a(0), x.a(i)), rop<T>::mul_down(x.a(0), y.a(i)));
-			}
-			for (i=xs; i<ys; i++) {
-				r.a(i) = rop<T>::mul_down(x.a(0), y.a(i));
-			}
-			for (i=1; i<xs; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y.a(0), x.a(i)), rop<T>::mul_up(x.a(0), y.a(i))), r.a(i)));
-			}
-			for (i=xs; i<ys; i++) {
-				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(0), y.a(i)), r.a(i)));
-			}
-			rop<T>::end();
-			#if AFFINE_SIMPLE != 2
-			for (i=ys; i<maxnum(); i++) {
-				r.a(i) = 0.;
-			}
-			#endif
-		}
-
 		#if AFFINE_MULT >= 1
 
 		interval<T> E;
@@ -851,7 +814,7 @@ template <class T> class affine {
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		# if AFFINE_SIMPLE == 1
 		r.er = 0.;
 		# endif
@@ -875,54 +838,32 @@ template <class T> class affine {
 		return x;
 	}
 
+	// a * x + range. the radius of range goes to a new noise symbol.
+	// common part of the nonlinear functions.
 
-	friend affine inv(const affine& x) {
+	static affine linear_approx(const affine& x, const T& a, const interval<T>& range) {
 		affine r;
-		T err;
-		interval<T> I, tmp, range;
-		T a, b, l, u;
-		int i, xs;
+		T b, err, l, u, tmp;
+		int k, xn;
 
-		xs = x.a.size();
+		xn = affine_sub::nnz(x.a);
 
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		affine_sub::start(r.a, x.a.size());
 		#else
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
 		#endif
 
-		I = to_interval(x);
-		l = I.lower();
-		u = I.upper();
-		if (l < 0. && u > 0.) {
-			throw std::domain_error("affine: division by 0");
-		}
-
-		a = -1. /(l * u);
-		tmp = a; // tmp is used to force interval calculation
-		if (u > 0.) {
-			range = 2. * sqrt(-tmp);
-		} else {
-			range = -2. * sqrt(-tmp);
-		}
-		tmp = l;
-		range = interval<T>::hull(range, 1./tmp - a * tmp);
-		tmp = u;
-		range = interval<T>::hull(range, 1./tmp - a * tmp);
-
 		rop<T>::begin();
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
+		for (k=1; k<xn; k++) {
+			tmp = rop<T>::mul_down(affine_sub::value(x.a, k), a);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(affine_sub::value(x.a, k), a), tmp));
+			affine_sub::push(r.a, affine_sub::index(x.a, k), tmp);
 		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
+		affine_sub::finish(r.a, x.a.size());
 		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
@@ -937,7 +878,7 @@ template <class T> class affine {
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		# if AFFINE_SIMPLE == 1
 		r.er = 0.;
 		# endif
@@ -945,6 +886,31 @@ template <class T> class affine {
 
 		return r;
 	}
+	friend affine inv(const affine& x) {
+		interval<T> I, tmp, range;
+		T a, l, u;
+
+		I = to_interval(x);
+		l = I.lower();
+		u = I.upper();
+		if (l < 0. && u > 0.) {
+			throw std::domain_error("affine: division by 0");
+		}
+
+		a = -1. /(l * u);
+		tmp = a; // tmp is used to force interval calculation
+		if (u > 0.) {
+			range = 2. * sqrt(-tmp);
+		} else {
+			range = -2. * sqrt(-tmp);
+		}
+		tmp = l;
+		range = interval<T>::hull(range, 1./tmp - a * tmp);
+		tmp = u;
+		range = interval<T>::hull(range, 1./tmp - a * tmp);
+
+		return linear_approx(x, a, range);
+	}
 
 	friend affine operator/(const affine& x, const affine& y) {
 		return x * inv(y);
@@ -956,30 +922,27 @@ template <class T> class affine {
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, affine>::value, affine >::type operator/(const affine& x, const C& y) {
 		affine r;
-		int xs, i;
-		T err(0.);
+		int k, xn;
+		T err(0.), tmp;
 
-		xs = x.a.size();
+		xn = affine_sub::nnz(x.a);
 
 		#if AFFINE_SIMPLE == 0
 		maxnum()++;
-		r.a.resize(maxnum()+1);
+		affine_sub::start(r.a, maxnum()+1);
 		#else
-		r.a.resize(xs);
+		affine_sub::start(r.a, x.a.size());
 		#endif
 
 		rop<T>::begin();
-		for (i=0; i<xs; i++) {
-			r.a(i) = rop<T>::div_down(x.a(i), (T)y);
-		}
-		for (i=0; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::div_up(x.a(i), (T)y), r.a(i)));
+		for (k=0; k<xn; k++) {
+			tmp = rop<T>::div_down(affine_sub::value(x.a, k), (T)y);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::div_up(affine_sub::value(x.a, k), (T)y), tmp));
+			affine_sub::push(r.a, affine_sub::index(x.a, k), tmp);
 		}
 		rop<T>::end();
 
-		#if AFFINE_SIMPLE == 0
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
+		affine_sub::finish(r.a, x.a.size());
 		#if AFFINE_SIMPLE >= 1
 		// r.er = x.er / abs(y) + err;
 		rop<T>::begin();
@@ -987,7 +950,7 @@ template <class T> class affine {
 		r.er = rop<T>::add_up(err, rop<T>::div_up(x.er, T(abs(y))));
 		rop<T>::end();
 		#else
-		r.a(maxnum()) = err;
+		affine_sub::push(r.a, maxnum(), err);
 		#endif
 
 		return r;
@@ -1018,20 +981,8 @@ template <class T> class affine {
 
 
 	friend affine sqrt(const affine& x) {
-		affine r;
-		T err;
 		interval<T> I, tmp, range;
-		T a, b, l, u;
-		int i, xs;
-
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
-		#else
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#endif
+		T a, l, u;
 
 		I = to_interval(x);
 		l = I.lower();
@@ -1050,56 +1001,12 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, sqrt(tmp) - a * tmp);
 
-		rop<T>::begin();
-		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
-		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
-		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
-		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
-		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
-		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
-		#if AFFINE_SIMPLE >= 1
-		// err += abs(a) * x.er;
-		using std::abs;
-		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
-		#endif
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 2
-		r.er = err;
-		#else
-		r.a(maxnum()) = err;
-		# if AFFINE_SIMPLE == 1
-		r.er = 0.;
-		# endif
-		#endif
-
-		return r;
+		return linear_approx(x, a, range);
 	}
 
 	friend affine square(const affine& x) {
-		affine r;
-		T err;
 		interval<T> I, tmp, range;
-		T a, b, l, u;
-		int i, xs;
-
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
-		#else
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#endif
+		T a, l, u;
 
 		I = to_interval(x);
 		l = I.lower();
@@ -1114,56 +1021,12 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, tmp * (tmp - a));
 
-		rop<T>::begin();
-		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
-		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
-		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
-		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
-		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
-		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
-		#if AFFINE_SIMPLE >= 1
-		// err += abs(a) * x.er;
-		using std::abs;
-		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
-		#endif
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 2
-		r.er = err;
-		#else
-		r.a(maxnum()) = err;
-		# if AFFINE_SIMPLE == 1
-		r.er = 0.;
-		# endif
-		#endif
-
-		return r;
+		return linear_approx(x, a, range);
 	}
 
 	friend affine exp(const affine& x) {
-		affine r;
-		T err;
 		interval<T> I, tmp, range;
-		T a, b, l, u;
-		int i, xs;
-
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
-		#else
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#endif
+		T a, l, u;
 
 		I = to_interval(x);
 		l = I.lower();
@@ -1179,56 +1042,12 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, exp(tmp) - a * tmp);
 
-		rop<T>::begin();
-		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
-		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
-		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
-		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
-		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
-		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
-		#if AFFINE_SIMPLE >= 1
-		// err += abs(a) * x.er;
-		using std::abs;
-		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
-		#endif
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 2
-		r.er = err;
-		#else
-		r.a(maxnum()) = err;
-		# if AFFINE_SIMPLE == 1
-		r.er = 0.;
-		# endif
-		#endif
-
-		return r;
+		return linear_approx(x, a, range);
 	}
 
 	friend affine log(const affine& x) {
-		affine r;
-		T err;
 		interval<T> I, tmp, range;
-		T a, b, l, u;
-		int i, xs;
-
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
-		#else
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#endif
+		T a, l, u;
 
 		I = to_interval(x);
 		l = I.lower();
@@ -1248,47 +1067,12 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, log(tmp) - a * tmp);
 
-		rop<T>::begin();
-		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
-		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
-		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
-		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
-		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
-		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
-		#if AFFINE_SIMPLE >= 1
-		// err += abs(a) * x.er;
-		using std::abs;
-		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
-		#endif
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 2
-		r.er = err;
-		#else
-		r.a(maxnum()) = err;
-		# if AFFINE_SIMPLE == 1
-		r.er = 0.;
-		# endif
-		#endif
-
-		return r;
+		return linear_approx(x, a, range);
 	}
 
 	friend affine abs(const affine& x) {
-		affine r;
-		T err;
 		interval<T> I, range;
-		T a, b, l, u;
-		int i, xs;
+		T a, l, u;
 
 		I = to_interval(x);
 		l = I.lower();
@@ -1301,54 +1085,13 @@ template <class T> class affine {
 			return -x;
 		}
 
-		xs = x.a.size();
-
-		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
-		#else
-		maxnum()++;
-		r.a.resize(maxnum()+1);
-		#endif
-
 		a = (u + l) / (u - l);
 
 		range = 0.;
 		range = interval<T>::hull(range, u - a * u);
 		range = interval<T>::hull(range, -l - a * l);
 
-		rop<T>::begin();
-		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
-		err = rop<T>::sub_up(b, range.lower());
-		for (i=1; i<xs; i++) {
-			r.a(i) = rop<T>::mul_down(x.a(i), a);
-		}
-		for (i=1; i<xs; i++) {
-			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), a), r.a(i)));
-		}
-		#if AFFINE_SIMPLE != 2
-		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
-		#endif
-		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
-		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
-		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
-		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
-		#if AFFINE_SIMPLE >= 1
-		// err += abs(a) * x.er;
-		using std::abs;
-		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
-		#endif
-		rop<T>::end();
-
-		#if AFFINE_SIMPLE == 2
-		r.er = err;
-		#else
-		r.a(maxnum()) = err;
-		# if AFFINE_SIMPLE == 1
-		r.er = 0.;
-		# endif
-		#endif
-
-		return r;
+		return linear_approx(x, a, range);
 	}
 
 	// lazy implementation of integer pow
@@ -1613,13 +1356,14 @@ template <class T> class affine {
 		
 		return r + m * tmp;
 	}
-
 	friend std::ostream& operator<<(std::ostream& s, const affine& x) {
-		int i;
+		int k, xn;
+
+		xn = affine_sub::nnz(x.a);
 
 		s << "[(" << x.a(0) << ")";
-		for (i=1; i<x.a.size(); i++) {
-			s << "+(" << x.a(i) << ")e" << i;
+		for (k=1; k<xn; k++) {
+			s << "+(" << affine_sub::value(x.a, k) << ")e" << affine_sub::index(x.a, k);
 		}
 		#if AFFINE_SIMPLE >= 1
 		s << "+(" << x.er << ")er";
@@ -1629,19 +1373,26 @@ template <class T> class affine {
 		return s;
 	}
 
+	// y: center and epsilons ep_1...ep_n of x
+	// z: other epsilons of x
+
 	friend inline void split(const affine& x, int n, affine& y, affine& z) {
-		int i;
-		int s = x.a.size();
-	
-		y.a.resize(s);
-		z.a.resize(s);
-		for (i=0; i<=n; i++) {
-			y.a(i) = x.a(i);
-			z.a(i) = 0.;
-		}
-		for (i=n+1; i<s; i++) {
-			y.a(i) = 0.;
-			z.a(i) = x.a(i);
+		int k, i;
+		int xn = affine_sub::nnz(x.a);
+
+		affine_sub::start(y.a, x.a.size());
+		affine_sub::start(z.a, x.a.size());
+		y.a(0) = x.a(0);
+		z.a(0) = 0.;
+		for (k=1; k<xn; k++) {
+			i = affine_sub::index(x.a, k);
+			if (i <= n) {
+				affine_sub::push(y.a, i, affine_sub::value(x.a, k));
+				affine_sub::push(z.a, i, T(0.));
+			} else {
+				affine_sub::push(y.a, i, T(0.));
+				affine_sub::push(z.a, i, affine_sub::value(x.a, k));
+			}
 		}
 		#if AFFINE_SIMPLE >= 1
 		y.er = 0.;
@@ -1649,16 +1400,9 @@ template <class T> class affine {
 		#endif
 	}
 
+	// remove epsilons newer than maxnum()
 	void resize() {
-		int i;
-		ub::vector<T> r;
-
-		r.resize(maxnum()+1);
-		for (i=0; i<=maxnum(); i++) {
-			r(i) = a(i);
-		}
-
-		a = r;
+		a.resize(maxnum()+1);
 	}
 };
 
@@ -1732,8 +1476,9 @@ template <class T> inline bool ep_reduce_cmp(ep_reduce_v<T>* a, ep_reduce_v<T>*
 
 template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n, int n_limit = 0) {
 	int s = x.size();
-	int m = affine<T>::maxnum();
-	int i, j;
+	int m;
+	int i, j, k, c, xn;
+	std::vector<int> ids;
 	std::vector< ep_reduce_v<T> > a;
 	std::vector< ep_reduce_v<T>* > pa;
 	ub::vector< affine<T> > r;
@@ -1741,19 +1486,45 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 
 	if (n_limit < n) n_limit = n;
 
+	// numbers of the noise symbols. for sparse storage, only the
+	// symbols which appear in x are counted.
+	#if AFFINE_SPARSE == 0
+	m = affine<T>::maxnum();
+	ids.resize(m);
+	for (i=0; i<m; i++) ids[i] = i + 1;
+	#else
+	for (j=0; j<s; j++) {
+		xn = affine_sub::nnz(x(j).a);
+		for (k=1; k<xn; k++) ids.push_back(affine_sub::index(x(j).a, k));
+	}
+	std::sort(ids.begin(), ids.end());
+	ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	m = ids.size();
+	#endif
+
 	if (m <= n_limit) return;
 	if (n < s) return; // impossible
 
 	a.resize(m);
 	pa.resize(m);
 
-	for (i=1; i<=m; i++) {
-		a[i-1].v.resize(s);
-		for (j=0; j<s; j++) {
-			a[i-1].v(j) = (i < x(j).a.size()) ? x(j).a(i) : (T)0.;
+	for (i=0; i<m; i++) {
+		a[i].v.resize(s);
+		for (j=0; j<s; j++) a[i].v(j) = 0.;
+	}
+	for (j=0; j<s; j++) {
+		xn = affine_sub::nnz(x(j).a);
+		c = 0;
+		for (k=1; k<xn; k++) {
+			i = affine_sub::index(x(j).a, k);
+			while (c < m && ids[c] < i) c++;
+			if (c == m) break;
+			if (ids[c] == i) a[c].v(j) = affine_sub::value(x(j).a, k);
 		}
-		a[i-1].calc_score();
-		pa[i-1] = &(a[i-1]);
+	}
+	for (i=0; i<m; i++) {
+		a[i].calc_score();
+		pa[i] = &(a[i]);
 	}
 
 #ifdef EP_REDUCE_REVERSE
@@ -1764,13 +1535,13 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 
 	r.resize(s);
 	for (i=0; i<s; i++) {
-		r(i).a.resize(n+1);
+		affine_sub::start(r(i).a, n+1);
 		r(i).a(0) = x(i).a(0);
 		for (j=0; j<n-s; j++) {
 #ifdef EP_REDUCE_REVERSE
-			r(i).a(j+1) = pa[m-1-j]->v(i);
+			affine_sub::push(r(i).a, j+1, pa[m-1-j]->v(i));
 #else
-			r(i).a(j+1) = pa[j]->v(i);
+			affine_sub::push(r(i).a, j+1, pa[j]->v(i));
 #endif
 		}
 		tmp = 0.;
@@ -1788,9 +1559,8 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 		#endif
 		rop<T>::end();
 		for (j=n-s; j<n; j++) {
-			r(i).a(j+1) = 0.;
+			affine_sub::push(r(i).a, j+1, (j == n-s+i) ? tmp : T(0.));
 		}
-		r(i).a(n-s+i+1) = tmp;
 		#if AFFINE_SIMPLE >= 1
 		r(i).er = 0.;
 		#endif
@@ -1807,25 +1577,25 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 
 template <class T> inline void epsilon_reduce2(ub::vector< affine<T> >& x, int n) {
 	int s = x.size();
-	int i, j;
+	int i, k, xn;
 	T tmp;
 
 	for (i=0; i<s; i++) {
+		xn = affine_sub::nnz(x(i).a);
 		tmp = 0.;
 		rop<T>::begin();
-		for (j=n+1; j<x(i).a.size(); j++) {
+		for (k=1; k<xn; k++) {
 			using std::abs;
-			tmp = rop<T>::add_up(tmp, abs(x(i).a(j)));
+			if (affine_sub::index(x(i).a, k) <= n) continue;
+			tmp = rop<T>::add_up(tmp, abs(affine_sub::value(x(i).a, k)));
 		}
 		#if AFFINE_SIMPLE >= 1
 		tmp = rop<T>::add_up(tmp, x(i).er);
 		#endif
 		rop<T>::end();
 
-		x(i).a.resize(n+1+i+1, true);
-		for (j=0; j<i; j++) {
-			x(i).a(n+1+j) = 0.;
-		}
+		x(i).a.resize(n+1);
+		x(i).a.resize(n+1+i+1);
 		x(i).a(n+1+i) = tmp;
 		#if AFFINE_SIMPLE >= 1
 		x(i).er = 0.;
@@ -1,12 +1,19 @@
 #include <kv/affine.hpp>
+#include <kv/affine-sparse.hpp>
 #include <kv/airy.hpp>
 #include <kv/allsol-affine.hpp>
+#include <kv/allsol-param.hpp>
 #include <kv/allsol-simple.hpp>
 #include <kv/allsol.hpp>
+#include <kv/autodif-fixed.hpp>
+#include <kv/autodif-reverse.hpp>
 #include <kv/autodif.hpp>
+#include <kv/benchmark.hpp>
 #include <kv/bessel.hpp>
 #include <kv/beta.hpp>
+#include <kv/box-file.hpp>
 #include <kv/cardano-ferrari.hpp>
+#include <kv/checkpoint.hpp>
 #include <kv/complex.hpp>
 #include <kv/constants.hpp>
 #include <kv/conv-dd.hpp>
@@ -14,6 +21,7 @@
 #include <kv/conv-double.hpp>
 #include <kv/conv-fp80.hpp>
 #include <kv/convert.hpp>
+#include <kv/dd-batch.hpp>
 #include <kv/dd.hpp>
 #include <kv/ddx.hpp>
 #include <kv/defint.hpp>
@@ -27,11 +35,15 @@
 #include <kv/eig.hpp>
 #include <kv/fp80.hpp>
 #include <kv/gamma.hpp>
+#include <kv/gemm.hpp>
 #include <kv/geoseries.hpp>
 #include <kv/hypergeom.hpp>
 #include <kv/highderiv.hpp>
 #include <kv/hwround.hpp>
 #include <kv/interval.hpp>
+#include <kv/interval-batch.hpp>
+#include <kv/interval-dot.hpp>
+#include <kv/interval-gemm.hpp>
 #include <kv/interval-vector.hpp>
 #include <kv/interval-converter.hpp>
 #include <kv/jointrange.hpp>
@@ -49,6 +61,7 @@
 #include <kv/ode-autodif-nv.hpp>
 #include <kv/ode-autodif.hpp>
 #include <kv/ode-callback.hpp>
+#include <kv/ode-ensemble.hpp>
 #include <kv/ode-lohner.hpp>
 #include <kv/ode-maffine.hpp>
 #include <kv/ode-maffine2.hpp>
@@ -56,21 +69,26 @@
 #include <kv/ode-param.hpp>
 #include <kv/ode-qr-lohner.hpp>
 #include <kv/ode-qr.hpp>
+#include <kv/ode-trajectory.hpp>
 #include <kv/ode.hpp>
 #include <kv/odescale.hpp>
 #include <kv/optimize.hpp>
 #include <kv/poincaremap.hpp>
+#include <kv/pool-allocator.hpp>
 #include <kv/psa-plot.hpp>
 #include <kv/psa.hpp>
 #include <kv/qr.hpp>
 #include <kv/rdd.hpp>
 #include <kv/rddx.hpp>
 #include <kv/rdouble.hpp>
+#include <kv/rdouble-elementary.hpp>
 #include <kv/rfp80.hpp>
 #include <kv/rmpfr.hpp>
 #include <kv/rk.hpp>
 #include <kv/rkf45.hpp>
 #include <kv/rkf78.hpp>
+#include <kv/solver-stats.hpp>
 #include <kv/strobomap.hpp>
+#include <kv/tape.hpp>
 #include <kv/vleq.hpp>
 #include <kv/version.hpp>
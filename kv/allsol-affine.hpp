@@ -141,6 +141,7 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 	int ep_size, lp_size;
 	bool lp_flag;
 	T lp_return;
+	lp_solver<T> lp;
 
 	E = ub::identity_matrix<T>(s);
 	L.resize(s,s);
@@ -300,7 +301,8 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 		}
 
 		if (lp_flag) {
-			lp_return = lp_minimize_verified(objfunc, constraints, -1);
+			lp.set_constraints(constraints);
+			lp_return = lp.minimize_verified(objfunc);
 			if (lp_return > 0.) {
 				count_ne++;
 				continue;
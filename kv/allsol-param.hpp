@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ALLSOL_PARAM_HPP
+#define ALLSOL_PARAM_HPP
+
+#include <string>
+#include <kv/checkpoint.hpp>
+#include <kv/solver-stats.hpp>
+
+namespace kv {
+
+
+// runtime options of allsol
+//
+// schedule
+//   0: candidate intervals are kept in one shared list
+//   1: candidate intervals are processed as OpenMP tasks
+//      (work stealing by the OpenMP runtime, no busy waiting)
+//   (ignored if compiled without OpenMP)
+// sort
+//   sort the solutions and the rest in lexicographic order
+//   so that the order of output does not depend on the
+//   scheduling of threads
+// max_targets
+//   if the number of candidate intervals in memory exceeds this,
+//   the newer ones are moved to a file (0 means no limit).
+//   used only with schedule 0.
+// spill_file
+//   name of the file for max_targets (empty: temporary file)
+// checkpoint
+//   save the state of the search to checkpoint.file every
+//   checkpoint.interval candidate intervals, and resume from it
+//   (see checkpoint.hpp). used only with schedule 0.
+// stats
+//   if not NULL, the numbers of tested, discarded and divided
+//   intervals and the elapsed time are added (see solver-stats.hpp)
+
+struct allsol_param {
+	int schedule;
+	bool sort;
+	long long max_targets;
+	std::string spill_file;
+	checkpoint_param checkpoint;
+	solver_stats* stats;
+
+	allsol_param() :
+		schedule(0),
+		sort(false),
+		max_targets(0),
+		spill_file(),
+		checkpoint(),
+		stats(NULL)
+	{}
+
+	allsol_param& set_schedule(int x) {
+		schedule = x;
+		return *this;
+	}
+	allsol_param& set_sort(bool x) {
+		sort = x;
+		return *this;
+	}
+	allsol_param& set_max_targets(long long x) {
+		max_targets = x;
+		return *this;
+	}
+	allsol_param& set_spill_file(const std::string& x) {
+		spill_file = x;
+		return *this;
+	}
+	allsol_param& set_checkpoint(const checkpoint_param& x) {
+		checkpoint = x;
+		return *this;
+	}
+	allsol_param& set_stats(solver_stats* x) {
+		stats = x;
+		return *this;
+	}
+};
+
+} // namespace kv
+
+#endif // ALLSOL_PARAM_HPP
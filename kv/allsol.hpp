@@ -19,7 +19,10 @@
 #endif
 // #include <boost/random.hpp>
 #include <kv/matrix-inversion.hpp>
+#include <kv/interval-gemm.hpp>
 #include <kv/autodif.hpp>
+#include <kv/allsol-param.hpp>
+#include <kv/box-file.hpp>
 
 
 #ifndef EDGE_RATIO
@@ -94,6 +97,27 @@ namespace kv {
 namespace bn = boost::numeric;
 namespace ub = boost::numeric::ublas;
 
+
+// base class of allsol_callback
+// solution() is called when a new solution is verified, and giveup()
+// is called for each interval given up (too small to divide).
+// the calls are serialized even if OpenMP is used.
+// if they return false, the search is stopped.
+// they are const because allsol takes the callback by const reference
+// (the default argument is a temporary). keep the state outside of the
+// callback and refer to it by a reference or a pointer member.
+
+template <class T> struct allsol_callback {
+	virtual ~allsol_callback() {}
+	virtual bool solution(const ub::vector< interval<T> >&) const {
+		return true;
+	}
+	virtual bool giveup(const ub::vector< interval<T> >&) const {
+		return true;
+	}
+};
+
+
 namespace allsol_sub {
 
 // return index of I_i which has maximum width
@@ -408,106 +432,105 @@ struct MakeVec {
 	}
 };
 
-} // namespace allsol_sub
 
+// lexicographic order of interval vectors
+// used for sorting the results
 
-// find all solution of f in I
+template <class T> struct vector_less {
+	bool operator() (const ub::vector< interval<T> >& x, const ub::vector< interval<T> >& y) const {
+		int i;
 
-template <class T, class F>
-std::list< ub::vector< interval<T> > >
-allsol (
-F f,
-const ub::vector< interval<T> >& I,
-int verbose = 1,
-T giveup = T(0.),
-std::list< ub::vector < interval<T> > >* rest = NULL
-)
-{
-	std::list< ub::vector < interval<T> > > targets;
-	targets.push_back(I);
-	return allsol_list(f, targets, verbose, giveup, rest);
-}
+		for (i=0; i<(int)x.size(); i++) {
+			if (x(i).lower() < y(i).lower()) return true;
+			if (x(i).lower() > y(i).lower()) return false;
+			if (x(i).upper() < y(i).upper()) return true;
+			if (x(i).upper() > y(i).upper()) return false;
+		}
+		return false;
+	}
+};
 
 
-// find all solution of f in targets (list of intervals)
+// process one candidate interval of allsol.
+// new candidates are appended to next. the results and the counters
+// are shared among threads.
 
-template <class T, class F>
-std::list< ub::vector< interval<T> > >
-allsol_list (
-F f,
-std::list< ub::vector< interval<T> > > targets,
-int verbose = 1,
-T giveup = T(0.),
-std::list< ub::vector < interval<T> > >* rest = NULL
-)
-{
-	int s = (targets.front()).size();
+template <class T, class F> struct allsol_worker {
+	F f;
+	int s;
+	int verbose;
+	T giveup;
+	std::list< ub::vector < interval<T> > >* rest;
 	std::list< ub::vector< interval<T> > > solutions, solutions_big;
-	int count_ne_test = 0;
-	int count_ex_test = 0;
-	int count_unknown = targets.size();
-	int count_ne = 0;
-	int count_ex = 0;
-	int count_giveup = 0;
-
-	#ifdef _OPENMP
-	#pragma omp parallel
-	#endif
+	int count_ne_test;
+	int count_ex_test;
+	int count_unknown;
+	int count_ne;
+	int count_ex;
+	int count_giveup;
+	int count_divide;
+	ub::matrix<T> E;
+	const allsol_callback<T>* callback;
+	bool stop; // use set_stop() and stopped() (atomic under OpenMP)
+
+	allsol_worker(F f, int s, int verbose, T giveup, std::list< ub::vector < interval<T> > >* rest, const allsol_callback<T>* callback = NULL) :
+		f(f),
+		s(s),
+		verbose(verbose),
+		giveup(giveup),
+		rest(rest),
+		count_ne_test(0),
+		count_ex_test(0),
+		count_unknown(0),
+		count_ne(0),
+		count_ex(0),
+		count_giveup(0),
+		count_divide(0),
+		callback(callback),
+		stop(false)
 	{
+		E = ub::identity_matrix<T>(s);
+	}
 
-	ub::vector< interval<T> > I, fc, fi, C, CK, K, mvf, I1, I2, IR, Iorg, g;
-	ub::vector<T> v;
-	ub::matrix< interval<T> > fdi, M, L2;
-	ub::matrix<T> L, R, E;
-	typename std::list< ub::vector< interval<T> > >::iterator p, p2;
-	int i, j, k, mi;
-	T tmp, tmp2;
-	T wmax;
-	bool r, M_calculated, flag, flag2, flag3;
-	interval<T> A, B, J, J2, Itmp;
-#if USE_TRIM == 3
-	ub::vector< interval<T> > A0, A1, A2; // for new trim algorithm
-#endif // USE_TRIM == 3
-
-	// boost::variate_generator<boost::mt19937, boost::uniform_int<> > rand (boost::mt19937(time(0)), boost::uniform_int<>(0, s-1));
-
-	E = ub::identity_matrix<T>(s);
-
-	while (true) {
-		if (verbose >= 2) {
-			#ifdef _OPENMP
-			#pragma omp critical (cout)
-			#endif
-			{
-			std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", unknown: " << count_unknown << ", ne: " << count_ne << ", ex: " << count_ex << ", giveup: " << count_giveup << "    \r" << std::flush;
-			}
-		}
+	void set_stop() {
+		#ifdef _OPENMP
+		#pragma omp atomic write
+		#endif
+		stop = true;
+	}
 
+	bool stopped() {
+		bool r;
 		#ifdef _OPENMP
+		#pragma omp atomic read
+		#endif
+		r = stop;
+		return r;
+	}
 
-		int iflag = 0;
-		#pragma omp critical (targets)
+	void print_count() {
+		#ifdef _OPENMP
+		#pragma omp critical (cout)
+		#endif
 		{
-		if (count_unknown == 0) iflag = 2;
-		else {
-			if (targets.empty()) {
-				iflag = 1;
-			} else {
-				I = targets.front();
-				targets.pop_front();
-			}
-		}
+		std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", unknown: " << count_unknown << ", ne: " << count_ne << ", ex: " << count_ex << ", giveup: " << count_giveup << "    \r" << std::flush;
 		}
-		if (iflag == 2)  break;
-		if (iflag == 1) continue;
-
-		#else // _OPENMP
-
-		if (targets.empty()) break;
-		I = targets.front();
-		targets.pop_front();
+	}
 
-		#endif // _OPENMP
+	void process(ub::vector< interval<T> > I, std::list< ub::vector< interval<T> > >& next) {
+		ub::vector< interval<T> > fc, fi, C, CK, K, mvf, I1, I2, IR, Iorg, g;
+		ub::vector<T> v;
+		ub::matrix< interval<T> > fdi, M, L2;
+		ub::matrix<T> L, R;
+		typename std::list< ub::vector< interval<T> > >::iterator p, p2;
+		int i, j, k, mi;
+		T tmp, tmp2;
+		T wmax;
+		bool r, M_calculated, flag, flag2, flag3;
+		interval<T> A, B, J, J2, Itmp;
+#if USE_TRIM == 3
+		ub::vector< interval<T> > A0, A1, A2; // for new trim algorithm
+#endif // USE_TRIM == 3
 
 		Iorg = I;
 
@@ -531,18 +554,12 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 #endif // USE_FI == 1
 
 		try {
-			autodif< interval<T> >::split(f(autodif< interval<T> >::init(I)), fi, fdi);
+			autodif_eval<F>::split(f, I, fi, fdi);
 		}
 		catch (std::domain_error& e) {
 			goto label;
@@ -554,13 +571,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 #endif // USE_FI != 1
 
@@ -582,13 +593,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 
 #if ENABLE_INFINITY == 1
@@ -686,14 +691,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 							I2(j) = intersect(IR(j), J2);
 							allsol_sub::recovery_inflation(I1, Iorg, (T)RECOVER_RATIO);
 							allsol_sub::recovery_inflation(I2, Iorg, (T)RECOVER_RATIO);
-							#ifdef _OPENMP
-							#pragma omp critical (targets)
-							#endif
-							{
-							targets.push_back(I1);
-							targets.push_back(I2);
-							count_unknown += 1;
-							}
+							next.push_back(I1);
+							next.push_back(I2);
 							flag3 = true;
 							break;
 #else
@@ -740,7 +739,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 #if USE_ZERODIVIDE == 2
 		// interval division occurs
-		if (flag3 == true) continue;
+		if (flag3 == true) return;
 #endif
 
 		// non-existence in I turns out
@@ -749,13 +748,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 
 		if (flag2 == true) {
@@ -767,13 +760,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			// shrinking again.
 			mi = allsol_sub::search_maxwidth(I);
 			if (rad(IR(mi)) <= 0.5 * rad(I(mi))) {
-				#ifdef _OPENMP
-				#pragma omp critical (targets)
-				#endif
-				{
-				targets.push_back(IR);
-				}
-				continue;
+				next.push_back(IR);
+				return;
 			}
 #endif // USE_MULTITRIM == 1
 
@@ -795,13 +783,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				#pragma omp atomic
 				#endif
 				count_ne++;
-				#ifdef _OPENMP
-				#pragma omp critical (targets)
-				#endif
-				{
-				count_unknown--;
-				}
-				continue;
+				return;
 			}
 		}
 
@@ -820,13 +802,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 #endif
 
@@ -878,7 +854,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		r = invert(L, R);
 		if (!r) goto label;
 
-		M = E - prod(R, fdi);
+		mm_mult(R, fdi, M);
+		M = E - M;
 		M_calculated = true;
 		CK = C - prod(R, fc);
 		K = CK +  prod(M, I - C);
@@ -887,13 +864,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			#pragma omp atomic
 			#endif
 			count_ne++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 
 #if 0
@@ -902,7 +873,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		I1 = Rfc + prod(Rfdi, I - C);
 		if (!zero_in(I1)) {
 			count_ne++;
-			continue;
+			return;
 		}
 #endif
 
@@ -959,10 +930,11 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				while (1) {
 					C = mid(K);
 					#if USE_SUPERLINEAR == 1
-					autodif< interval<T> >::split(f(autodif< interval<T> >::init(K)), fi, fdi);
+					autodif_eval<F>::split(f, K, fi, fdi);
 					L = mid(fdi);
 					r = invert(L, R);
-					M = E - prod(R, fdi);
+					mm_mult(R, fdi, M);
+					M = E - M;
 					#endif
 					I1 = C - prod(R, f(C)) + prod(M, K - C);
 					I1 = intersect(K, I1);
@@ -972,6 +944,14 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				}
 				solutions.push_back(K);
 				count_ex++;
+				if (callback != NULL) {
+					#ifdef _OPENMP
+					#pragma omp critical (allsol_callback)
+					#endif
+					{
+					if (!callback->solution(K)) set_stop();
+					}
+				}
 				if (verbose >= 1) {
 					#ifdef _OPENMP
 					#pragma omp critical (cout)
@@ -982,13 +962,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				}
 			}
 			} // pragma omp critical (solutions)
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 
 		// check the case that solution may exist near boundary.
@@ -1000,13 +974,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 #endif
 		{
 			allsol_sub::recovery_inflation2(K, Iorg, (T)RECOVER_RATIO);
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			targets.push_back(K);
-			}
-			continue;
+			next.push_back(K);
+			return;
 		}
 
 
@@ -1029,13 +998,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		if (allsol_sub::widthratio_max(I, Iorg) <= 0.5)
 #endif
 		{
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			targets.push_back(I);
-			}
-			continue;
+			next.push_back(I);
+			return;
 		}
 #endif // USE_SLOWDIVIDE == 1
 
@@ -1047,13 +1011,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 		mi = allsol_sub::search_maxwidth(Iorg);
 		if (rad(I(mi)) <= 0.5 * rad(Iorg(mi))) {
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			targets.push_back(I);
-			}
-			continue;
+			next.push_back(I);
+			return;
 		}
 #else // USE_SLOWDIVIDE_OLD
 #if ENABLE_INFINITY == 1
@@ -1101,17 +1060,19 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				#endif // UNIFY_REST == 1
 				}
 			}
+			if (callback != NULL) {
+				#ifdef _OPENMP
+				#pragma omp critical (allsol_callback)
+				#endif
+				{
+				if (!callback->giveup(I)) set_stop();
+				}
+			}
 			#ifdef _OPENMP
 			#pragma omp atomic
 			#endif
 			count_giveup++;
-			#ifdef _OPENMP
-			#pragma omp critical (targets)
-			#endif
-			{
-			count_unknown--;
-			}
-			continue;
+			return;
 		}
 
 		I1 = I; I2 = I;
@@ -1127,13 +1088,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				tmp = mid(I1(mi2));
 				I1(mi2).assign(I1(mi2).lower(), tmp);
 				I3(mi2).assign(tmp, I3(mi2).upper());
-				#ifdef _OPENMP
-				#pragma omp critical (targets)
-				#endif
-				{
-				targets.push_back(I3);
-				count_unknown += 1;
-				}
+				next.push_back(I3);
 			}
 		}
 		if (allsol_sub::include_infinity(I2(mi))) {
@@ -1143,33 +1098,296 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				tmp = mid(I2(mi2));
 				I2(mi2).assign(I2(mi2).lower(), tmp);
 				I3(mi2).assign(tmp, I3(mi2).upper());
-				#ifdef _OPENMP
-				#pragma omp critical (targets)
-				#endif
-				{
-				targets.push_back(I3);
-				count_unknown += 1;
-				}
+				next.push_back(I3);
 			}
 		}
 #endif // ENABLE_INFINITY == 1
+		next.push_back(I1);
+		next.push_back(I2);
+	}
+
+#ifdef _OPENMP
+	// process I and its descendants as OpenMP tasks.
+	// the runtime keeps the tasks in per-thread queues and idle
+	// threads steal from the others, so no shared list is used.
+	void process_task(const ub::vector< interval<T> >& I) {
+		std::list< ub::vector< interval<T> > > next;
+		typename std::list< ub::vector< interval<T> > >::iterator p;
+
+		if (stopped()) return;
+
+		if (verbose >= 2) print_count();
+
+		process(I, next);
+
+		#pragma omp atomic
+		count_unknown += (int)next.size() - 1;
+		if (next.size() >= 2) {
+			#pragma omp atomic
+			count_divide++;
+		}
+
+		for (p=next.begin(); p!=next.end(); p++) {
+			ub::vector< interval<T> > J = *p;
+			#pragma omp task firstprivate(J)
+			process_task(J);
+		}
+	}
+#endif // _OPENMP
+};
+
+
+// fingerprint of the problem for the checkpoint file
+
+template <class F, class T> unsigned long long checkpoint_key(const std::list< ub::vector< interval<T> > >& targets, const T& giveup) {
+	typename std::list< ub::vector< interval<T> > >::const_iterator p;
+	unsigned long long h = checkpoint_sub::hash_init<F>("allsol");
+	long long n = targets.size();
+
+	checkpoint_sub::hash_value(h, giveup);
+	checkpoint_sub::hash_value(h, n);
+	for (p=targets.begin(); p!=targets.end(); p++) {
+		checkpoint_sub::hash_box(h, *p);
+	}
+	return h;
+}
+
+// save the state of allsol (candidate intervals, results and
+// counters) to the checkpoint file
+
+template <class T, class F> bool save_checkpoint(const checkpoint_param& cp, unsigned long long key, allsol_worker<T, F>& w, box_spill_queue<T>& targets) {
+	std::FILE* fp;
+	bool ok;
+	int has_rest = (w.rest != NULL);
+
+	fp = checkpoint_sub::begin_write(cp);
+	if (fp == NULL) return false;
+
+	ok = checkpoint_sub::write_header(fp, "allsol", sizeof(T), key)
+		&& checkpoint_sub::write_value(fp, w.s)
+		&& checkpoint_sub::write_value(fp, w.count_ne_test)
+		&& checkpoint_sub::write_value(fp, w.count_ex_test)
+		&& checkpoint_sub::write_value(fp, w.count_unknown)
+		&& checkpoint_sub::write_value(fp, w.count_ne)
+		&& checkpoint_sub::write_value(fp, w.count_ex)
+		&& checkpoint_sub::write_value(fp, w.count_giveup)
+		&& checkpoint_sub::write_value(fp, w.count_divide)
+		&& targets.save(fp)
+		&& checkpoint_sub::write_list(fp, w.solutions)
+		&& checkpoint_sub::write_list(fp, w.solutions_big)
+		&& checkpoint_sub::write_value(fp, has_rest)
+		&& (!has_rest || checkpoint_sub::write_list(fp, *w.rest));
+
+	return checkpoint_sub::end_write(cp, fp, ok);
+}
+
+// restore the state saved by save_checkpoint.
+// return false if there is no valid checkpoint of the same problem
+// (key is made by checkpoint_key).
+
+template <class T, class F> bool load_checkpoint(const checkpoint_param& cp, unsigned long long key, allsol_worker<T, F>& w, box_spill_queue<T>& targets) {
+	std::FILE* fp;
+	bool ok;
+	int s, has_rest;
+	std::list< ub::vector< interval<T> > > rest;
+
+	fp = checkpoint_sub::begin_read(cp);
+	if (fp == NULL) return false;
+
+	ok = checkpoint_sub::read_header(fp, "allsol", sizeof(T), key)
+		&& checkpoint_sub::read_value(fp, s)
+		&& s == w.s
+		&& checkpoint_sub::read_value(fp, w.count_ne_test)
+		&& checkpoint_sub::read_value(fp, w.count_ex_test)
+		&& checkpoint_sub::read_value(fp, w.count_unknown)
+		&& checkpoint_sub::read_value(fp, w.count_ne)
+		&& checkpoint_sub::read_value(fp, w.count_ex)
+		&& checkpoint_sub::read_value(fp, w.count_giveup)
+		&& checkpoint_sub::read_value(fp, w.count_divide)
+		&& targets.load(fp)
+		&& checkpoint_sub::read_list(fp, s, w.solutions)
+		&& checkpoint_sub::read_list(fp, s, w.solutions_big)
+		&& checkpoint_sub::read_value(fp, has_rest)
+		&& (!has_rest || checkpoint_sub::read_list(fp, s, rest));
+
+	std::fclose(fp);
+
+	if (!ok) {
+		w.count_ne_test = w.count_ex_test = w.count_ne = w.count_ex = w.count_giveup = w.count_divide = 0;
+		w.solutions.clear();
+		w.solutions_big.clear();
+		targets.clear();
+		return false;
+	}
+	if (w.rest != NULL) w.rest->swap(rest);
+
+	return true;
+}
+
+} // namespace allsol_sub
+
+
+// find all solution of f in I
+
+template <class T, class F>
+std::list< ub::vector< interval<T> > >
+allsol (
+F f,
+const ub::vector< interval<T> >& I,
+int verbose = 1,
+T giveup = T(0.),
+std::list< ub::vector < interval<T> > >* rest = NULL,
+const allsol_param& param = allsol_param(),
+const allsol_callback<T>& callback = allsol_callback<T>()
+)
+{
+	std::list< ub::vector < interval<T> > > targets;
+	targets.push_back(I);
+	return allsol_list(f, targets, verbose, giveup, rest, param, callback);
+}
+
+
+// find all solution of f in targets (list of intervals)
+
+template <class T, class F>
+std::list< ub::vector< interval<T> > >
+allsol_list (
+F f,
+std::list< ub::vector< interval<T> > > targets0,
+int verbose = 1,
+T giveup = T(0.),
+std::list< ub::vector < interval<T> > >* rest = NULL,
+const allsol_param& param = allsol_param(),
+const allsol_callback<T>& callback = allsol_callback<T>()
+)
+{
+	int s = (targets0.front()).size();
+	allsol_sub::allsol_worker<T, F> w(f, s, verbose, giveup, rest, &callback);
+	stats_timer timer(param.stats, "allsol");
+
+	w.count_unknown = targets0.size();
+
+	#ifdef _OPENMP
+	if (param.schedule == 1) {
+		#pragma omp parallel
+		#pragma omp single
+		{
+		while (!targets0.empty()) {
+			ub::vector< interval<T> > J = targets0.front();
+			targets0.pop_front();
+			#pragma omp task firstprivate(J)
+			w.process_task(J);
+		}
+		}
+	} else
+	#endif // _OPENMP
+
+	{
+	box_spill_queue<T> targets(s, param.max_targets, param.spill_file);
+	const checkpoint_param& cp = param.checkpoint;
+	long long count_box = 0; // processed boxes after last checkpoint
+	int inflight = 0; // boxes being processed
+
+	unsigned long long key = allsol_sub::checkpoint_key<F>(targets0, giveup);
+
+	if (allsol_sub::load_checkpoint(cp, key, w, targets)) {
+		if (verbose >= 1) {
+			std::cout << "resume from " << cp.file << ": " << targets.size() << " intervals, " << w.solutions.size() << " solutions\n";
+		}
+	} else {
+		targets.splice(targets0);
+	}
+
+	#ifdef _OPENMP
+	#pragma omp parallel
+	#endif
+	{
+
+	ub::vector< interval<T> > I;
+	std::list< ub::vector< interval<T> > > next;
+	int n;
+
+	while (true) {
+		if (verbose >= 2) w.print_count();
+
+		#ifdef _OPENMP
+
+		int iflag = 0;
+		#pragma omp critical (targets)
+		{
+		if (w.count_unknown == 0 || w.stopped()) iflag = 2;
+		else {
+			// wait for the other threads before checkpoint
+			if (targets.empty() || (cp.enabled() && count_box >= cp.interval)) {
+				iflag = 1;
+			} else {
+				targets.pop_front(I);
+				count_box++;
+				inflight++;
+			}
+		}
+		}
+		if (iflag == 2)  break;
+		if (iflag == 1) continue;
+
+		#else // _OPENMP
+
+		if (targets.empty() || w.stopped()) break;
+		targets.pop_front(I);
+		count_box++;
+		inflight++;
+
+		#endif // _OPENMP
+
+		w.process(I, next);
+
 		#ifdef _OPENMP
 		#pragma omp critical (targets)
 		#endif
 		{
-		targets.push_back(I1);
-		targets.push_back(I2);
-		count_unknown += 1;
+		n = next.size();
+		targets.splice(next);
+		w.count_unknown += n - 1;
+		if (n >= 2) w.count_divide++;
+		inflight--;
+		if (cp.enabled() && count_box >= cp.interval && inflight == 0) {
+			if (!allsol_sub::save_checkpoint(cp, key, w, targets) && verbose >= 1) {
+				std::cout << "checkpoint: can not write " << cp.file << "\n";
+			}
+			count_box = 0;
+		}
 		}
 	}
 
 	} // pragma omp parallel
 
+	// the checkpoint is kept if the search is stopped by the callback
+	if (!w.stopped()) checkpoint_sub::finish(cp);
+
+	if (verbose >= 2 && targets.max_file > 0) {
+		std::cout << "max number of intervals in file: " << targets.max_file << "\n";
+	}
+	}
+
 	if (verbose >= 1) {
-			std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", ne: " << count_ne << ", ex: " << count_ex << ", giveup: " << count_giveup << "    \n";
+			std::cout << "ne_test: " << w.count_ne_test << ", ex_test: " << w.count_ex_test << ", ne: " << w.count_ne << ", ex: " << w.count_ex << ", giveup: " << w.count_giveup << "    \n";
+	}
+
+	if (param.stats != NULL) {
+		param.stats->add("allsol_tested", w.count_ne_test);
+		param.stats->add("allsol_ne", w.count_ne);
+		param.stats->add("allsol_ex_test", w.count_ex_test);
+		param.stats->add("allsol_solutions", w.count_ex);
+		param.stats->add("allsol_divided", w.count_divide);
+		param.stats->add("allsol_giveup", w.count_giveup);
+	}
+
+	if (param.sort) {
+		w.solutions.sort(allsol_sub::vector_less<T>());
+		if (rest != NULL) (*rest).sort(allsol_sub::vector_less<T>());
 	}
 
-	return solutions;
+	return w.solutions;
 }
 
 
@@ -1182,7 +1400,9 @@ F f,
 const interval<T>& I,
 int verbose = 1,
 T giveup = T(0.),
-std::list< interval<T> >* rest = NULL
+std::list< interval<T> >* rest = NULL,
+const allsol_param& param = allsol_param(),
+const allsol_callback<T>& callback = allsol_callback<T>()
 )
 {
 	allsol_sub::MakeVec<F> g(f);
@@ -1201,7 +1421,7 @@ std::list< interval<T> >* rest = NULL
 		rest_p = &rest2;
 	}
 
-	r1 = allsol(g, I2, verbose, giveup, rest_p);
+	r1 = allsol(g, I2, verbose, giveup, rest_p, param, callback);
 
 	p2 = r1.begin();
 	while (p2 != r1.end()) {
@@ -0,0 +1,677 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef AUTODIF_FIXED_HPP
+#define AUTODIF_FIXED_HPP
+
+// Automatic Differentiation by bottom up algorithm
+// with fixed number of variables N.
+// derivatives are stored in the object itself, so no memory
+// allocation occurs during the calculation.
+
+#include <iostream>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+#include <algorithm>
+
+#include <kv/convert.hpp>
+#include <kv/autodif.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T, int N> class autodif_fixed;
+template <class C, class T, int N> struct convertible<C, autodif_fixed<T, N> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, autodif_fixed<T, N> >::value;
+};
+template <class C, class T, int N> struct acceptable_n<C, autodif_fixed<T, N> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T, int N> class autodif_fixed {
+	public:
+	T v;
+	T d[N];
+
+	typedef T base_type;
+
+	autodif_fixed() {
+		int i;
+		v = 0.;
+		for (i=0; i<N; i++) d[i] = 0.;
+	}
+
+	template <class C> explicit autodif_fixed(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value >::type* =0) {
+		int i;
+		v = x;
+		for (i=0; i<N; i++) d[i] = 0.;
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed& >::type operator=(const C& x) {
+		int i;
+		v = x;
+		for (i=0; i<N; i++) d[i] = 0.;
+		return *this;
+	}
+
+	// r.d = c * x.d
+	static void scale(autodif_fixed& r, const T& c, const autodif_fixed& x) {
+		int i;
+		for (i=0; i<N; i++) r.d[i] = c * x.d[i];
+	}
+
+	friend autodif_fixed operator+(const autodif_fixed& a, const autodif_fixed& b) {
+		autodif_fixed r;
+		int i;
+
+		r.v = a.v + b.v;
+		for (i=0; i<N; i++) r.d[i] = a.d[i] + b.d[i];
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator+(const autodif_fixed& a, const C& b) {
+		autodif_fixed r(a);
+
+		r.v = a.v + b;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator+(const C& a, const autodif_fixed& b) {
+		autodif_fixed r(b);
+
+		r.v = a + b.v;
+
+		return r;
+	}
+
+	friend autodif_fixed& operator+=(autodif_fixed& a, const autodif_fixed& b) {
+		int i;
+
+		a.v += b.v;
+		for (i=0; i<N; i++) a.d[i] += b.d[i];
+
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed& >::type operator+=(autodif_fixed& a, const C& b) {
+		a.v += b;
+		return a;
+	}
+
+	friend autodif_fixed operator-(const autodif_fixed& a, const autodif_fixed& b) {
+		autodif_fixed r;
+		int i;
+
+		r.v = a.v - b.v;
+		for (i=0; i<N; i++) r.d[i] = a.d[i] - b.d[i];
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator-(const autodif_fixed& a, const C& b) {
+		autodif_fixed r(a);
+
+		r.v = a.v - b;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator-(const C& a, const autodif_fixed& b) {
+		autodif_fixed r;
+		int i;
+
+		r.v = a - b.v;
+		for (i=0; i<N; i++) r.d[i] = - b.d[i];
+
+		return r;
+	}
+
+	friend autodif_fixed& operator-=(autodif_fixed& a, const autodif_fixed& b) {
+		int i;
+
+		a.v -= b.v;
+		for (i=0; i<N; i++) a.d[i] -= b.d[i];
+
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed& >::type operator-=(autodif_fixed& a, const C& b) {
+		a.v -= b;
+		return a;
+	}
+
+	friend autodif_fixed operator-(const autodif_fixed& a) {
+		autodif_fixed r;
+		int i;
+
+		r.v = - a.v;
+		for (i=0; i<N; i++) r.d[i] = - a.d[i];
+
+		return r;
+	}
+
+	friend autodif_fixed operator*(const autodif_fixed& a, const autodif_fixed& b) {
+		autodif_fixed r;
+		int i;
+
+		r.v = a.v * b.v;
+		for (i=0; i<N; i++) r.d[i] = b.v * a.d[i] + a.v * b.d[i];
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator*(const autodif_fixed& a, const C& b) {
+		autodif_fixed r;
+
+		r.v = a.v * b;
+		scale(r, T(b), a);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator*(const C& a, const autodif_fixed& b) {
+		autodif_fixed r;
+
+		r.v = a * b.v;
+		scale(r, T(a), b);
+
+		return r;
+	}
+
+	friend autodif_fixed& operator*=(autodif_fixed& a, const autodif_fixed& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed& >::type operator*=(autodif_fixed& a, const C& b) {
+		a.v *= b;
+		scale(a, T(b), a);
+		return a;
+	}
+
+	friend autodif_fixed operator/(const autodif_fixed& a, const autodif_fixed& b) {
+		autodif_fixed r;
+		T tmp;
+		int i;
+
+		r.v = a.v / b.v;
+		tmp = -a.v/(b.v*b.v);
+		for (i=0; i<N; i++) r.d[i] = a.d[i] / b.v + b.d[i] * tmp;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator/(const autodif_fixed& a, const C& b) {
+		autodif_fixed r;
+		int i;
+
+		r.v = a.v / b;
+		for (i=0; i<N; i++) r.d[i] = a.d[i] / T(b);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type operator/(const C& a, const autodif_fixed& b) {
+		autodif_fixed r;
+
+		r.v = a / b.v;
+		scale(r, -a/(b.v*b.v), b);
+
+		return r;
+	}
+
+	friend autodif_fixed& operator/=(autodif_fixed& a, const autodif_fixed& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed& >::type operator/=(autodif_fixed& a, const C& b) {
+		int i;
+
+		a.v /= b;
+		for (i=0; i<N; i++) a.d[i] /= T(b);
+		return a;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const autodif_fixed& x) {
+		int i;
+		s << x.v;
+		s << '<';
+		for (i=0; i<N; i++) {
+			s << x.d[i];
+			if (i != N-1) {
+				s << ',';
+			}
+		}
+		s << '>';
+		return s;
+	}
+
+	friend autodif_fixed pow(const autodif_fixed& x, int y) {
+		autodif_fixed r;
+
+		using std::pow;
+		r.v = pow(x.v, y);
+		if (y != 0) {
+			scale(r, y * pow(x.v, y - 1), x);
+		}
+		return r;
+	}
+
+	friend autodif_fixed pow(const autodif_fixed& x, const autodif_fixed& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value && ! boost::is_integral<C>::value, autodif_fixed >::type pow(const autodif_fixed& a, const C& b) {
+		return pow(a, autodif_fixed(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_fixed>::value, autodif_fixed >::type pow(const C& a, const autodif_fixed& b) {
+		return pow(autodif_fixed(a), b);
+	}
+
+	friend autodif_fixed exp (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::exp;
+		r.v = exp(x.v);
+		scale(r, r.v, x);
+
+		return r;
+	}
+
+	friend autodif_fixed log (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::log;
+		r.v = log(x.v);
+		scale(r, 1. / x.v, x);
+
+		return r;
+	}
+
+	friend autodif_fixed sqrt (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sqrt;
+		r.v = sqrt(x.v);
+		scale(r, 1. / (2. * r.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed sin (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sin;
+		using std::cos;
+		r.v = sin(x.v);
+		scale(r, cos(x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed cos (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sin;
+		using std::cos;
+		r.v = cos(x.v);
+		scale(r, -sin(x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed tan (const autodif_fixed& x) {
+		autodif_fixed r;
+		T tmp;
+
+		using std::tan;
+		using std::cos;
+		r.v = tan(x.v);
+		tmp = cos(x.v);
+		scale(r, 1. / (tmp * tmp), x);
+
+		return r;
+	}
+
+	friend autodif_fixed asin (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::asin;
+		using std::sqrt;
+		r.v = asin(x.v);
+		scale(r, 1. / sqrt(1. - x.v * x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed acos (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::acos;
+		using std::sqrt;
+		r.v = acos(x.v);
+		scale(r, -1. / sqrt(1. - x.v * x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed atan (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::atan;
+		r.v = atan(x.v);
+		scale(r, 1. / (1. + x.v * x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed sinh (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = sinh(x.v);
+		scale(r, cosh(x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed cosh (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = cosh(x.v);
+		scale(r, sinh(x.v), x);
+
+		return r;
+	}
+
+	friend autodif_fixed tanh (const autodif_fixed& x) {
+		autodif_fixed r;
+		T tmp;
+
+		using std::tanh;
+		using std::cosh;
+		r.v = tanh(x.v);
+		tmp = cosh(x.v);
+		scale(r, 1. / (tmp * tmp), x);
+
+		return r;
+	}
+
+	friend autodif_fixed asinh (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sqrt;
+		r.v = asinh(x.v);
+		scale(r, 1. / sqrt(x.v * x.v + 1.), x);
+
+		return r;
+	}
+
+	friend autodif_fixed acosh (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		using std::sqrt;
+		r.v = acosh(x.v);
+		scale(r, 1. / sqrt(x.v * x.v - 1.), x);
+
+		return r;
+	}
+
+	friend autodif_fixed atanh (const autodif_fixed& x) {
+		autodif_fixed r;
+
+		r.v = atanh(x.v);
+		scale(r, 1. / (1. - x.v * x.v), x);
+
+		return r;
+	}
+
+	// n-dimensional version (n <= N)
+	static ub::vector<autodif_fixed> init (const ub::vector<T>& in) {
+		int i;
+		int n = in.size();
+		ub::vector<autodif_fixed> out(n);
+
+		for (i=0; i<n; i++) {
+			out(i).v = in(i);
+			out(i).d[i] = 1.;
+		}
+
+		return out;
+	}
+
+	// 1-dimensional version
+	static autodif_fixed init (const T& in) {
+		autodif_fixed out;
+
+		out.v = in;
+		out.d[0] = 1.;
+
+		return out;
+	}
+
+	// for functions R^n -> R^m (n <= N)
+	static void split (const ub::vector<autodif_fixed>& in, ub::vector<T>& v, ub::matrix<T>& d, int n = N) {
+		int i, j;
+		int m = in.size();
+
+		if (in.size() == 0) return;
+
+		v.resize(m);
+		d.resize(m, n);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			for (j=0; j<n; j++) {
+				d(i, j) = in(i).d[j];
+			}
+		}
+	}
+
+	// for functions R^n -> R (n <= N)
+	static void split (const autodif_fixed& in, T& v, ub::vector<T>& d, int n = N) {
+		int j;
+
+		d.resize(n);
+
+		v = in.v;
+		for (j=0; j<n; j++) {
+			d(j) = in.d[j];
+		}
+	}
+
+	// for functions R -> R^m
+	static void split (const ub::vector<autodif_fixed>& in, ub::vector<T>& v, ub::vector<T>& d) {
+		int i;
+		int m = in.size();
+
+		if (in.size() == 0) return;
+
+		v.resize(m);
+		d.resize(m);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			d(i) = in(i).d[0];
+		}
+	}
+
+	// for functions R -> R
+	static void split (const autodif_fixed& in, T& v, T& d) {
+		v = in.v;
+		d = in.d[0];
+	}
+
+	// conversion from/to autodif
+
+	static bool fits (const autodif<T>& x) {
+		return x.d.size() <= N;
+	}
+
+	static bool fits (const ub::vector< autodif<T> >& x) {
+		int i;
+		for (i=0; i<(int)x.size(); i++) {
+			if (x(i).d.size() > N) return false;
+		}
+		return true;
+	}
+
+	static autodif_fixed from_autodif (const autodif<T>& x) {
+		autodif_fixed r;
+		int i;
+
+		r.v = x.v;
+		for (i=0; i<(int)x.d.size(); i++) r.d[i] = x.d(i);
+
+		return r;
+	}
+
+	static ub::vector<autodif_fixed> from_autodif (const ub::vector< autodif<T> >& x) {
+		int i;
+		int n = x.size();
+		ub::vector<autodif_fixed> r(n);
+
+		for (i=0; i<n; i++) r(i) = from_autodif(x(i));
+
+		return r;
+	}
+
+	// number of the derivatives of x (the maximum for vector)
+	static int dsize (const autodif<T>& x) {
+		return x.d.size();
+	}
+
+	static int dsize (const ub::vector< autodif<T> >& x) {
+		int i, r = 0;
+		for (i=0; i<(int)x.size(); i++) {
+			if ((int)x(i).d.size() > r) r = x(i).d.size();
+		}
+		return r;
+	}
+
+	// the first n (<= N) derivatives are converted
+	static autodif<T> to_autodif (const autodif_fixed& x, int n = N) {
+		autodif<T> r;
+		int i;
+
+		r.v = x.v;
+		r.d.resize(n);
+		for (i=0; i<n; i++) r.d(i) = x.d[i];
+
+		return r;
+	}
+
+	static ub::vector< autodif<T> > to_autodif (const ub::vector<autodif_fixed>& x, int n = N) {
+		int i;
+		int m = x.size();
+		ub::vector< autodif<T> > r(m);
+
+		for (i=0; i<m; i++) r(i) = to_autodif(x(i), n);
+
+		return r;
+	}
+};
+
+
+// wrap vector function f (R^n -> R^m, or right hand side f(x, t) of
+// ODE) so that the derivatives are calculated by autodif_fixed.
+// allsol, krawczyk_approx, optimize and ode_maffine evaluate the
+// derivatives through autodif_eval, which builds autodif_fixed directly
+// for these wrappers (see below) if n <= N.
+// a call with ub::vector< autodif<T> > from other code is converted to
+// autodif_fixed and back (the conversion allocates).
+// other argument types are passed to f without change.
+
+template <class F, int N> struct FixedJacobian {
+	F f;
+	FixedJacobian(F f) : f(f) {}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		return f(x);
+	}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, const T& t) {
+		return f(x, t);
+	}
+
+	template <class T> ub::vector< autodif<T> > operator() (const ub::vector< autodif<T> >& x) {
+		typedef autodif_fixed<T, N> AF;
+
+		if (!AF::fits(x)) return f(x);
+		return AF::to_autodif(f(AF::from_autodif(x)), AF::dsize(x));
+	}
+
+	template <class T> ub::vector< autodif<T> > operator() (const ub::vector< autodif<T> >& x, const autodif<T>& t) {
+		typedef autodif_fixed<T, N> AF;
+
+		if (!AF::fits(x) || !AF::fits(t)) return f(x, t);
+		return AF::to_autodif(f(AF::from_autodif(x), AF::from_autodif(t)), std::max(AF::dsize(x), AF::dsize(t)));
+	}
+};
+
+// same as above for scalar function (R^n -> R) such as
+// objective function of optimize
+
+template <class F, int N> struct FixedGradient {
+	F f;
+	FixedGradient(F f) : f(f) {}
+
+	template <class T> T operator() (const ub::vector<T>& x) {
+		return f(x);
+	}
+
+	template <class T> autodif<T> operator() (const ub::vector< autodif<T> >& x) {
+		typedef autodif_fixed<T, N> AF;
+
+		if (!AF::fits(x)) return f(x);
+		return AF::to_autodif(f(AF::from_autodif(x)), AF::dsize(x));
+	}
+};
+
+
+// the algorithms evaluate the derivatives of FixedJacobian and
+// FixedGradient by autodif_fixed without conversion from autodif.
+
+template <class F, int N> struct autodif_eval< FixedJacobian<F, N> > {
+	template <class T, class V, class D> static void split(FixedJacobian<F, N>& f, const ub::vector<T>& x, V& v, D& d) {
+		typedef autodif_fixed<T, N> AF;
+		int n = x.size();
+
+		if (n > N) autodif_eval<F>::split(f.f, x, v, d);
+		else AF::split(f.f(AF::init(x)), v, d, n);
+	}
+
+	template <class T, class V, class D> static void split(FixedJacobian<F, N>& f, const ub::vector<T>& x, const T& t, V& v, D& d) {
+		typedef autodif_fixed<T, N> AF;
+		int n = x.size();
+
+		if (n > N) autodif_eval<F>::split(f.f, x, t, v, d);
+		else AF::split(f.f(AF::init(x), AF(t)), v, d, n);
+	}
+};
+
+template <class F, int N> struct autodif_eval< FixedGradient<F, N> > {
+	template <class T, class V, class D> static void split(FixedGradient<F, N>& f, const ub::vector<T>& x, V& v, D& d) {
+		typedef autodif_fixed<T, N> AF;
+		int n = x.size();
+
+		if (n > N) autodif_eval<F>::split(f.f, x, v, d);
+		else AF::split(f.f(AF::init(x)), v, d, n);
+	}
+};
+
+} // namespace kv
+
+#endif // AUTODIF_FIXED_HPP
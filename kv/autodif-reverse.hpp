@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef AUTODIF_REVERSE_HPP
+#define AUTODIF_REVERSE_HPP
+
+// Automatic Differentiation by top down (reverse) algorithm
+//
+// each operation is recorded on a tape (one tape for each type T and
+// each thread) with its local partial derivatives, and the gradient is
+// calculated by one backward sweep in split().
+// the cost of the gradient of R^n -> R is a constant multiple of the
+// cost of the function, independent of n.
+//
+// usage is the same as autodif:
+//   autodif_reverse<T>::split(f(autodif_reverse<T>::init(x)), v, d);
+// init() clears the tape of the calling thread, so the result must be
+// split before the next init() of the same type.
+
+#include <iostream>
+#include <vector>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+
+#include <kv/convert.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T> class autodif_reverse;
+template <class C, class T> struct convertible<C, autodif_reverse<T> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, autodif_reverse<T> >::value;
+};
+template <class C, class T> struct acceptable_n<C, autodif_reverse<T> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T> class autodif_reverse {
+	public:
+	T v;
+	int id; // position in the tape, -1 means constant
+
+	typedef T base_type;
+
+	// a node of the tape: the result depends on the nodes a and b
+	// with partial derivatives da and db (-1 means none)
+	struct node {
+		int a, b;
+		T da, db;
+	};
+
+	struct tape_type {
+		std::vector<node> nodes;
+		int nvar;
+		tape_type() : nvar(0) {}
+	};
+
+	// tape of the calling thread
+	static tape_type& rec() {
+		static tape_type t;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(t)
+		#endif
+		return t;
+	}
+
+	static int push(int a, const T& da, int b, const T& db) {
+		tape_type& t = rec();
+		node n;
+
+		n.a = a; n.b = b;
+		n.da = da; n.db = db;
+		t.nodes.push_back(n);
+		return t.nodes.size() - 1;
+	}
+
+	// result of unary operation with derivative dx
+	static void unary(autodif_reverse& r, const autodif_reverse& x, const T& dx) {
+		r.id = push(x.id, dx, -1, T(0.));
+	}
+
+	autodif_reverse() {
+		v = 0.;
+		id = -1;
+	}
+
+	template <class C> explicit autodif_reverse(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value >::type* =0) {
+		v = x;
+		id = -1;
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator=(const C& x) {
+		v = x;
+		id = -1;
+		return *this;
+	}
+
+	friend autodif_reverse operator+(const autodif_reverse& a, const autodif_reverse& b) {
+		autodif_reverse r;
+
+		r.v = a.v + b.v;
+		if (a.id < 0 && b.id < 0) r.id = -1;
+		else if (b.id < 0) unary(r, a, T(1.));
+		else if (a.id < 0) unary(r, b, T(1.));
+		else r.id = push(a.id, T(1.), b.id, T(1.));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator+(const autodif_reverse& a, const C& b) {
+		autodif_reverse r;
+
+		r.v = a.v + b;
+		if (a.id < 0) r.id = -1;
+		else unary(r, a, T(1.));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator+(const C& a, const autodif_reverse& b) {
+		return b + a;
+	}
+
+	friend autodif_reverse& operator+=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a + b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator+=(autodif_reverse& a, const C& b) {
+		a = a + b;
+		return a;
+	}
+
+	friend autodif_reverse operator-(const autodif_reverse& a, const autodif_reverse& b) {
+		autodif_reverse r;
+
+		r.v = a.v - b.v;
+		if (a.id < 0 && b.id < 0) r.id = -1;
+		else if (b.id < 0) unary(r, a, T(1.));
+		else if (a.id < 0) unary(r, b, T(-1.));
+		else r.id = push(a.id, T(1.), b.id, T(-1.));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator-(const autodif_reverse& a, const C& b) {
+		autodif_reverse r;
+
+		r.v = a.v - b;
+		if (a.id < 0) r.id = -1;
+		else unary(r, a, T(1.));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator-(const C& a, const autodif_reverse& b) {
+		autodif_reverse r;
+
+		r.v = a - b.v;
+		if (b.id < 0) r.id = -1;
+		else unary(r, b, T(-1.));
+
+		return r;
+	}
+
+	friend autodif_reverse& operator-=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a - b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator-=(autodif_reverse& a, const C& b) {
+		a = a - b;
+		return a;
+	}
+
+	friend autodif_reverse operator-(const autodif_reverse& a) {
+		autodif_reverse r;
+
+		r.v = -a.v;
+		if (a.id < 0) r.id = -1;
+		else unary(r, a, T(-1.));
+
+		return r;
+	}
+
+	friend autodif_reverse operator*(const autodif_reverse& a, const autodif_reverse& b) {
+		autodif_reverse r;
+
+		r.v = a.v * b.v;
+		if (a.id < 0 && b.id < 0) r.id = -1;
+		else if (b.id < 0) unary(r, a, b.v);
+		else if (a.id < 0) unary(r, b, a.v);
+		else r.id = push(a.id, b.v, b.id, a.v);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator*(const autodif_reverse& a, const C& b) {
+		autodif_reverse r;
+
+		r.v = a.v * b;
+		if (a.id < 0) r.id = -1;
+		else unary(r, a, T(b));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator*(const C& a, const autodif_reverse& b) {
+		return b * a;
+	}
+
+	friend autodif_reverse& operator*=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator*=(autodif_reverse& a, const C& b) {
+		a = a * b;
+		return a;
+	}
+
+	friend autodif_reverse operator/(const autodif_reverse& a, const autodif_reverse& b) {
+		autodif_reverse r;
+		T tmp;
+
+		r.v = a.v / b.v;
+		if (a.id < 0 && b.id < 0) {
+			r.id = -1;
+			return r;
+		}
+		tmp = 1. / b.v;
+		if (b.id < 0) unary(r, a, tmp);
+		else if (a.id < 0) unary(r, b, - r.v * tmp);
+		else r.id = push(a.id, tmp, b.id, - r.v * tmp);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator/(const autodif_reverse& a, const C& b) {
+		autodif_reverse r;
+
+		r.v = a.v / b;
+		if (a.id < 0) r.id = -1;
+		else unary(r, a, 1. / T(b));
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator/(const C& a, const autodif_reverse& b) {
+		autodif_reverse r;
+
+		r.v = a / b.v;
+		if (b.id < 0) r.id = -1;
+		else unary(r, b, - r.v / b.v);
+
+		return r;
+	}
+
+	friend autodif_reverse& operator/=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator/=(autodif_reverse& a, const C& b) {
+		a = a / b;
+		return a;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const autodif_reverse& x) {
+		s << x.v << '<' << x.id << '>';
+		return s;
+	}
+
+	friend autodif_reverse pow(const autodif_reverse& x, int y) {
+		autodif_reverse r;
+
+		using std::pow;
+		r.v = pow(x.v, y);
+		if (x.id < 0 || y == 0) r.id = -1;
+		else unary(r, x, y * pow(x.v, y - 1));
+
+		return r;
+	}
+
+	friend autodif_reverse pow(const autodif_reverse& x, const autodif_reverse& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value && ! boost::is_integral<C>::value, autodif_reverse >::type pow(const autodif_reverse& a, const C& b) {
+		return pow(a, autodif_reverse(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type pow(const C& a, const autodif_reverse& b) {
+		return pow(autodif_reverse(a), b);
+	}
+
+	friend autodif_reverse exp (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::exp;
+		r.v = exp(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, r.v);
+
+		return r;
+	}
+
+	friend autodif_reverse log (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::log;
+		r.v = log(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / x.v);
+
+		return r;
+	}
+
+	friend autodif_reverse sqrt (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::sqrt;
+		r.v = sqrt(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / (2. * r.v));
+
+		return r;
+	}
+
+	friend autodif_reverse sin (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::sin;
+		using std::cos;
+		r.v = sin(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, cos(x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse cos (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::sin;
+		using std::cos;
+		r.v = cos(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, -sin(x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse tan (const autodif_reverse& x) {
+		autodif_reverse r;
+		T tmp;
+
+		using std::tan;
+		using std::cos;
+		r.v = tan(x.v);
+		if (x.id < 0) {
+			r.id = -1;
+		} else {
+			tmp = cos(x.v);
+			unary(r, x, 1. / (tmp * tmp));
+		}
+
+		return r;
+	}
+
+	friend autodif_reverse asin (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::asin;
+		using std::sqrt;
+		r.v = asin(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / sqrt(1. - x.v * x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse acos (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::acos;
+		using std::sqrt;
+		r.v = acos(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, -1. / sqrt(1. - x.v * x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse atan (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::atan;
+		r.v = atan(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / (1. + x.v * x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse sinh (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = sinh(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, cosh(x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse cosh (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = cosh(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, sinh(x.v));
+
+		return r;
+	}
+
+	friend autodif_reverse tanh (const autodif_reverse& x) {
+		autodif_reverse r;
+		T tmp;
+
+		using std::tanh;
+		using std::cosh;
+		r.v = tanh(x.v);
+		if (x.id < 0) {
+			r.id = -1;
+		} else {
+			tmp = cosh(x.v);
+			unary(r, x, 1. / (tmp * tmp));
+		}
+
+		return r;
+	}
+
+	friend autodif_reverse asinh (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		// using std::asinh;
+		using std::sqrt;
+		r.v = asinh(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / sqrt(x.v * x.v + 1.));
+
+		return r;
+	}
+
+	friend autodif_reverse acosh (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		// using std::acosh;
+		using std::sqrt;
+		r.v = acosh(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / sqrt(x.v * x.v - 1.));
+
+		return r;
+	}
+
+	friend autodif_reverse atanh (const autodif_reverse& x) {
+		autodif_reverse r;
+
+		// using std::atanh;
+		r.v = atanh(x.v);
+		if (x.id < 0) r.id = -1;
+		else unary(r, x, 1. / (1. - x.v * x.v));
+
+		return r;
+	}
+
+	// n-dimensional version
+	static ub::vector<autodif_reverse> init (const ub::vector<T>& in) {
+		int i;
+		int n = in.size();
+		tape_type& t = rec();
+		ub::vector<autodif_reverse> out(n);
+
+		t.nodes.clear();
+		t.nvar = n;
+		for (i=0; i<n; i++) {
+			out(i).v = in(i);
+			out(i).id = push(-1, T(0.), -1, T(0.));
+		}
+
+		return out;
+	}
+
+	// 1-dimensional version
+	static autodif_reverse init (const T& in) {
+		tape_type& t = rec();
+		autodif_reverse out;
+
+		t.nodes.clear();
+		t.nvar = 1;
+		out.v = in;
+		out.id = push(-1, T(0.), -1, T(0.));
+
+		return out;
+	}
+
+	// backward sweep: d = gradient of in
+	static void sweep (const autodif_reverse& in, ub::vector<T>& d) {
+		int i, j;
+		const tape_type& t = rec();
+		int n = t.nvar;
+
+		d.resize(n);
+		for (j=0; j<n; j++) d(j) = 0.;
+		if (in.id < 0) return;
+
+		std::vector<T> adj(in.id + 1);
+		std::vector<char> touched(in.id + 1, 0);
+
+		adj[in.id] = 1.;
+		touched[in.id] = 1;
+		for (i=in.id; i>=n; i--) {
+			if (!touched[i]) continue;
+			const node& e = t.nodes[i];
+			if (e.a >= 0) {
+				if (touched[e.a]) {
+					adj[e.a] += e.da * adj[i];
+				} else {
+					adj[e.a] = e.da * adj[i];
+					touched[e.a] = 1;
+				}
+			}
+			if (e.b >= 0) {
+				if (touched[e.b]) {
+					adj[e.b] += e.db * adj[i];
+				} else {
+					adj[e.b] = e.db * adj[i];
+					touched[e.b] = 1;
+				}
+			}
+		}
+
+		for (j=0; j<n && j<=in.id; j++) {
+			if (touched[j]) d(j) = adj[j];
+		}
+	}
+
+	// for functions R^n -> R^m (one sweep for each output)
+	static void split (const ub::vector<autodif_reverse>& in, ub::vector<T>& v, ub::matrix<T>& d) {
+		int i, j;
+		int m = in.size();
+		int n = rec().nvar;
+		ub::vector<T> g;
+
+		v.resize(m);
+		d.resize(m, n);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			sweep(in(i), g);
+			for (j=0; j<n; j++) d(i, j) = g(j);
+		}
+	}
+
+	// for functions R^n -> R
+	static void split (const autodif_reverse& in, T& v, ub::vector<T>& d) {
+		v = in.v;
+		sweep(in, d);
+	}
+
+	// for functions R -> R
+	static void split (const autodif_reverse& in, T& v, T& d) {
+		ub::vector<T> g;
+
+		v = in.v;
+		sweep(in, g);
+		d = g(0);
+	}
+};
+
+} // namespace kv
+
+#endif // AUTODIF_REVERSE_HPP
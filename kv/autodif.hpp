@@ -603,6 +603,24 @@ template <class T> class autodif {
 	}
 };
 
+
+// value and Jacobian (or gradient) of f at x by autodif.
+// the algorithms (allsol, krawczyk_approx, optimize, ode for autodif)
+// evaluate the derivatives of f by this, so that another type of
+// automatic differentiation can be used for some types of f by
+// specializing it (see autodif-fixed.hpp).
+
+template <class F> struct autodif_eval {
+	template <class T, class V, class D> static void split(F& f, const ub::vector<T>& x, V& v, D& d) {
+		autodif<T>::split(f(autodif<T>::init(x)), v, d);
+	}
+
+	// for right hand side f(x, t) of ODE
+	template <class T, class V, class D> static void split(F& f, const ub::vector<T>& x, const T& t, V& v, D& d) {
+		autodif<T>::split(f(autodif<T>::init(x), autodif<T>(t)), v, d);
+	}
+};
+
 } // namespace kv
 
 #endif //AUTODIF_HPP
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+// simple harness for benchmark programs (example/bench-*.cc)
+//
+//   kv::benchmark b("interval");
+//   b.run("add", f, 1000);   // f() performs 1000 operations
+//   b.print(std::cout, "json");
+//
+// f is called repeatedly until min_time seconds elapse, and the time
+// per call and per operation are recorded. the results are printed
+// in one of the following formats:
+//   text: human readable table
+//   json: one JSON object per line
+//   csv : header line and one line per result
+// each record contains the library version and the rounding backend
+// (selected by KV_NOHWROUND, KV_USE_AVX512, KV_USE_UPWARD, KV_FASTROUND
+// at compile time), so that the results of different builds can be compared.
+//
+// benchmark programs:
+//   example/bench-interval.cc : rop and interval operations
+//   example/bench-psa.cc      : power series arithmetic
+//   example/bench-ode.cc      : ODE solvers
+//   example/bench-allsol.cc   : allsol and optimize
+// for example,
+//   g++ -O3 -I.. bench-interval.cc && ./a.out json >> result.json
+//   g++ -O3 -I.. -DKV_NOHWROUND bench-interval.cc && ./a.out json >> result.json
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <kv/version.hpp>
+
+
+namespace kv {
+
+
+// name of rounding backend of rop<double>
+inline std::string benchmark_backend() {
+	std::string s;
+
+#if defined(KV_NOHWROUND)
+	s = "nohwround";
+#elif defined(KV_USE_AVX512)
+	s = "avx512";
+#elif defined(KV_USE_UPWARD)
+	s = "upward";
+#else
+	s = "hwround";
+#endif
+#if defined(KV_FASTROUND)
+	s += "+fastround";
+#endif
+	return s;
+}
+
+
+struct benchmark_result {
+	std::string name;
+	long long calls; // number of calls of f
+	double ops; // number of operations in one call
+	double sec; // total time
+};
+
+
+class benchmark {
+	public:
+	std::string suite;
+	double min_time;
+	std::vector<benchmark_result> results;
+
+	benchmark(const std::string& suite, double min_time = 0.2) : suite(suite), min_time(min_time) {}
+
+	// f: function object which performs ops operations
+	template <class F> void run(const std::string& name, F f, double ops = 1.) {
+		std::chrono::system_clock::time_point t;
+		benchmark_result r;
+		long long i, n;
+		double sec;
+
+		// first call is a warm up, but used as the result if it is slow
+		n = 1;
+		t = std::chrono::system_clock::now();
+		f();
+		sec = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+
+		while (sec < min_time && n < (1LL << 40)) {
+			// estimate the number of calls for min_time
+			if (sec <= 0.) n *= 10;
+			else if (sec * 10 < min_time) n *= 10;
+			else n = (long long)(n * min_time / sec * 1.1) + 1;
+			t = std::chrono::system_clock::now();
+			for (i=0; i<n; i++) f();
+			sec = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+		}
+
+		r.name = name;
+		r.calls = n;
+		r.ops = ops;
+		r.sec = sec;
+		results.push_back(r);
+	}
+
+	void print_text(std::ostream& o) const {
+		int i;
+
+		o << "# " << suite << " (kv " << KV_VERSION_STRING << ", " << benchmark_backend() << ")\n";
+		for (i=0; i<(int)results.size(); i++) {
+			const benchmark_result& r = results[i];
+			o << r.name << ": " << r.sec / r.calls << " sec/call, " << r.sec / r.calls / r.ops * 1e9 << " nsec/op\n";
+		}
+	}
+
+	void print_json(std::ostream& o) const {
+		int i;
+
+		for (i=0; i<(int)results.size(); i++) {
+			const benchmark_result& r = results[i];
+			o << "{\"suite\": \"" << suite << "\", \"name\": \"" << r.name << "\", \"version\": \"" << KV_VERSION_STRING << "\", \"backend\": \"" << benchmark_backend() << "\", \"calls\": " << r.calls << ", \"ops\": " << r.ops << ", \"sec\": " << r.sec << ", \"sec_per_call\": " << r.sec / r.calls << ", \"ops_per_sec\": " << r.ops * r.calls / r.sec << "}\n";
+		}
+	}
+
+	void print_csv(std::ostream& o, bool header = true) const {
+		int i;
+
+		if (header) o << "suite,name,version,backend,calls,ops,sec,sec_per_call,ops_per_sec\n";
+		for (i=0; i<(int)results.size(); i++) {
+			const benchmark_result& r = results[i];
+			o << suite << "," << r.name << "," << KV_VERSION_STRING << "," << benchmark_backend() << "," << r.calls << "," << r.ops << "," << r.sec << "," << r.sec / r.calls << "," << r.ops * r.calls / r.sec << "\n";
+		}
+	}
+
+	// format: "text", "json" or "csv"
+	void print(std::ostream& o, const std::string& format = "text") const {
+		if (format == "json") print_json(o);
+		else if (format == "csv") print_csv(o);
+		else print_text(o);
+	}
+};
+
+} // namespace kv
+
+#endif // BENCHMARK_HPP
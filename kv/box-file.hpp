@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef BOX_FILE_HPP
+#define BOX_FILE_HPP
+
+// binary I/O of interval vectors (boxes) and a FIFO queue of boxes
+// which spills to a file
+//
+// the endpoints are written by their bytes, so they are restored
+// exactly. T must be a plain type (double, float, dd, ...).
+
+#include <cstdio>
+#include <string>
+#include <list>
+#include <vector>
+#include <stdexcept>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T> inline bool write_box(std::FILE* fp, const ub::vector< interval<T> >& x) {
+	int i;
+	int n = x.size();
+	std::vector<T> buf(2 * n);
+
+	for (i=0; i<n; i++) {
+		buf[2 * i] = x(i).lower();
+		buf[2 * i + 1] = x(i).upper();
+	}
+	if (n == 0) return true;
+	return std::fwrite(&buf[0], sizeof(T), 2 * n, fp) == (std::size_t)(2 * n);
+}
+
+template <class T> inline bool read_box(std::FILE* fp, int n, ub::vector< interval<T> >& x) {
+	int i;
+	std::vector<T> buf(2 * n);
+
+	x.resize(n);
+	if (n == 0) return true;
+	if (std::fread(&buf[0], sizeof(T), 2 * n, fp) != (std::size_t)(2 * n)) return false;
+	for (i=0; i<n; i++) {
+		x(i).assign(buf[2 * i], buf[2 * i + 1]);
+	}
+	return true;
+}
+
+
+// FIFO queue of boxes of dimension n.
+// if the number of boxes in memory exceeds limit (0 means no limit),
+// the newest boxes are moved to a file and read back in chunks when
+// the boxes in memory are exhausted. the order of boxes is the same
+// as std::list.
+//   head (memory) -> file -> tail (memory)
+
+template <class T> class box_spill_queue {
+	public:
+	std::list< ub::vector< interval<T> > > head, tail;
+	int n;
+	long long limit;
+	std::string filename; // empty: use tmpfile()
+	std::FILE* fp;
+	long long nfile; // number of boxes in the file
+	long long rpos, wpos; // read and write position (number of boxes)
+	long long nhead, ntail;
+	long long max_file; // statistics
+
+	box_spill_queue(int n = 0, long long limit = 0, const std::string& filename = "") : n(n), limit(limit), filename(filename), fp(NULL), nfile(0), rpos(0), wpos(0), nhead(0), ntail(0), max_file(0) {}
+
+	~box_spill_queue() {
+		if (fp != NULL) {
+			std::fclose(fp);
+			if (!filename.empty()) std::remove(filename.c_str());
+		}
+	}
+
+	long long size() const {
+		return nhead + nfile + ntail;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	void push_back(const ub::vector< interval<T> >& x) {
+		tail.push_back(x);
+		ntail++;
+		if (limit > 0 && nhead + ntail > limit) spill();
+	}
+
+	// move all the elements of l to the end of queue
+	void splice(std::list< ub::vector< interval<T> > >& l) {
+		long long m = l.size();
+
+		tail.splice(tail.end(), l);
+		ntail += m;
+		if (limit > 0 && nhead + ntail > limit) spill();
+	}
+
+	void pop_front(ub::vector< interval<T> >& x) {
+		if (nhead == 0) fill();
+		x = head.front();
+		head.pop_front();
+		nhead--;
+	}
+
+	void clear() {
+		head.clear();
+		tail.clear();
+		nhead = ntail = 0;
+		nfile = 0;
+		rpos = wpos = 0;
+	}
+
+	// write the number of boxes and all the boxes in the queue order
+	bool save(std::FILE* out) {
+		typename std::list< ub::vector< interval<T> > >::iterator p;
+		ub::vector< interval<T> > x;
+		long long i, m = size();
+
+		if (std::fwrite(&m, sizeof(m), 1, out) != 1) return false;
+		for (p=head.begin(); p!=head.end(); p++) {
+			if (!write_box(out, *p)) return false;
+		}
+		for (i=0; i<nfile; i++) {
+			std::fseek(fp, (rpos + i) * record_size(), SEEK_SET);
+			if (!read_box(fp, n, x)) return false;
+			if (!write_box(out, x)) return false;
+		}
+		for (p=tail.begin(); p!=tail.end(); p++) {
+			if (!write_box(out, *p)) return false;
+		}
+		return true;
+	}
+
+	// replace the contents by the boxes written by save
+	bool load(std::FILE* in) {
+		ub::vector< interval<T> > x;
+		long long i, m;
+
+		clear();
+		if (std::fread(&m, sizeof(m), 1, in) != 1) return false;
+		for (i=0; i<m; i++) {
+			if (!read_box(in, n, x)) return false;
+			push_back(x);
+		}
+		return true;
+	}
+
+	private:
+
+	bool open() {
+		if (fp != NULL) return true;
+		if (filename.empty()) {
+			fp = std::tmpfile();
+		} else {
+			fp = std::fopen(filename.c_str(), "w+b");
+		}
+		return fp != NULL;
+	}
+
+	long long record_size() const {
+		return 2 * n * (long long)sizeof(T);
+	}
+
+	// move tail to the end of the file
+	void spill() {
+		typename std::list< ub::vector< interval<T> > >::iterator p;
+
+		if (!open()) return; // keep in memory
+		std::fseek(fp, wpos * record_size(), SEEK_SET);
+		for (p=tail.begin(); p!=tail.end(); p++) {
+			if (!write_box(fp, *p)) break;
+			wpos++;
+			nfile++;
+		}
+		tail.erase(tail.begin(), p);
+		ntail = tail.size();
+		if (nfile > max_file) max_file = nfile;
+	}
+
+	// move boxes from the file (or tail) to head
+	void fill() {
+		ub::vector< interval<T> > x;
+		long long i, m;
+
+		if (nfile == 0) {
+			head.swap(tail);
+			nhead = ntail;
+			ntail = 0;
+			return;
+		}
+
+		m = (limit > 1) ? limit / 2 : 1;
+		if (m > nfile) m = nfile;
+		std::fseek(fp, rpos * record_size(), SEEK_SET);
+		for (i=0; i<m; i++) {
+			if (!read_box(fp, n, x)) {
+				throw std::runtime_error("box_spill_queue: read error");
+			}
+			head.push_back(x);
+			nhead++;
+			rpos++;
+			nfile--;
+		}
+		if (nfile == 0) {
+			// the file is empty, reuse from the beginning
+			rpos = wpos = 0;
+		}
+	}
+};
+
+} // namespace kv
+
+#endif // BOX_FILE_HPP
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+// checkpoint files of long searches (allsol, optimize)
+//
+// checkpoint_param
+//   file: name of checkpoint file (empty: no checkpoint)
+//   interval: write the state every this number of processed boxes
+//   resume: if file exists, start from the state saved in it
+//
+// the file is first written to file + ".tmp" and renamed, so that
+// the old checkpoint remains if the program is killed while writing.
+// the values are written by their bytes and restored exactly.
+//
+// the header has a fingerprint of the problem (the kind of the search,
+// the type of the function, the initial boxes and the parameters).
+// a checkpoint of another problem is not used. note that two functions
+// of the same type (e.g. function pointers) can not be distinguished.
+// the file is removed when the search finishes normally.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <list>
+#include <typeinfo>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+#include <kv/box-file.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+struct checkpoint_param {
+	std::string file;
+	long long interval;
+	bool resume;
+
+	checkpoint_param() :
+		file(),
+		interval(100000),
+		resume(true)
+	{}
+
+	checkpoint_param& set_file(const std::string& x) {
+		file = x;
+		return *this;
+	}
+	checkpoint_param& set_interval(long long x) {
+		interval = x;
+		return *this;
+	}
+	checkpoint_param& set_resume(bool x) {
+		resume = x;
+		return *this;
+	}
+
+	bool enabled() const {
+		return !file.empty() && interval > 0;
+	}
+};
+
+
+namespace checkpoint_sub {
+
+static const char magic[8] = {'K', 'V', 'C', 'K', 'P', 'T', '2', '\0'};
+
+// fingerprint of the problem (FNV-1a hash of the bytes)
+
+inline void hash_bytes(unsigned long long& h, const void* p, std::size_t n) {
+	const unsigned char* c = (const unsigned char*)p;
+	std::size_t i;
+
+	for (i=0; i<n; i++) {
+		h ^= c[i];
+		h *= 1099511628211ULL;
+	}
+}
+
+inline void hash_string(unsigned long long& h, const char* x) {
+	hash_bytes(h, x, std::strlen(x) + 1);
+}
+
+// kind: kind of the search. the function type F is hashed by its name.
+template <class F> inline unsigned long long hash_init(const char* kind) {
+	unsigned long long h = 14695981039346656037ULL;
+
+	hash_string(h, kind);
+	hash_string(h, typeid(F).name());
+	return h;
+}
+
+template <class X> inline void hash_value(unsigned long long& h, const X& x) {
+	hash_bytes(h, &x, sizeof(X));
+}
+
+template <class T> inline void hash_box(unsigned long long& h, const ub::vector< interval<T> >& x) {
+	int i, n = x.size();
+
+	hash_value(h, n);
+	for (i=0; i<n; i++) {
+		hash_value(h, x(i).lower());
+		hash_value(h, x(i).upper());
+	}
+}
+
+// tag: kind of the state (at most 8 characters, padded by zero)
+inline void make_tag(char* t, const char* tag) {
+	int i;
+
+	for (i=0; i<8 && tag[i] != '\0'; i++) t[i] = tag[i];
+	for ( ; i<8; i++) t[i] = '\0';
+}
+
+// key: fingerprint of the problem
+inline bool write_header(std::FILE* fp, const char* tag, int tsize, unsigned long long key) {
+	char t[8];
+
+	make_tag(t, tag);
+	if (std::fwrite(magic, 1, 8, fp) != 8) return false;
+	if (std::fwrite(t, 1, 8, fp) != 8) return false;
+	if (std::fwrite(&tsize, sizeof(int), 1, fp) != 1) return false;
+	return std::fwrite(&key, sizeof(key), 1, fp) == 1;
+}
+
+inline bool read_header(std::FILE* fp, const char* tag, int tsize, unsigned long long key) {
+	char m[8], t[8], t2[8];
+	int s;
+	unsigned long long k;
+
+	make_tag(t2, tag);
+	if (std::fread(m, 1, 8, fp) != 8) return false;
+	if (std::fread(t, 1, 8, fp) != 8) return false;
+	if (std::fread(&s, sizeof(int), 1, fp) != 1) return false;
+	if (std::fread(&k, sizeof(k), 1, fp) != 1) return false;
+	return std::memcmp(m, magic, 8) == 0 && std::memcmp(t, t2, 8) == 0 && s == tsize && k == key;
+}
+
+template <class X> inline bool write_value(std::FILE* fp, const X& x) {
+	return std::fwrite(&x, sizeof(X), 1, fp) == 1;
+}
+
+template <class X> inline bool read_value(std::FILE* fp, X& x) {
+	return std::fread(&x, sizeof(X), 1, fp) == 1;
+}
+
+template <class T> inline bool write_list(std::FILE* fp, const std::list< ub::vector< interval<T> > >& l) {
+	typename std::list< ub::vector< interval<T> > >::const_iterator p;
+	long long m = l.size();
+
+	if (!write_value(fp, m)) return false;
+	for (p=l.begin(); p!=l.end(); p++) {
+		if (!write_box(fp, *p)) return false;
+	}
+	return true;
+}
+
+template <class T> inline bool read_list(std::FILE* fp, int n, std::list< ub::vector< interval<T> > >& l) {
+	long long i, m;
+	ub::vector< interval<T> > x;
+
+	l.clear();
+	if (!read_value(fp, m)) return false;
+	for (i=0; i<m; i++) {
+		if (!read_box(fp, n, x)) return false;
+		l.push_back(x);
+	}
+	return true;
+}
+
+// open temporary file for writing checkpoint
+inline std::FILE* begin_write(const checkpoint_param& cp) {
+	return std::fopen((cp.file + ".tmp").c_str(), "wb");
+}
+
+// close temporary file and replace the checkpoint with it
+inline bool end_write(const checkpoint_param& cp, std::FILE* fp, bool ok) {
+	std::string tmp = cp.file + ".tmp";
+
+	if (std::fclose(fp) != 0) ok = false;
+	if (!ok) {
+		std::remove(tmp.c_str());
+		return false;
+	}
+	if (std::rename(tmp.c_str(), cp.file.c_str()) != 0) {
+		// rename does not overwrite on some systems
+		std::remove(cp.file.c_str());
+		if (std::rename(tmp.c_str(), cp.file.c_str()) != 0) return false;
+	}
+	return true;
+}
+
+// open checkpoint for resuming (NULL if not exists)
+inline std::FILE* begin_read(const checkpoint_param& cp) {
+	if (!cp.enabled() || !cp.resume) return NULL;
+	return std::fopen(cp.file.c_str(), "rb");
+}
+
+// remove the checkpoint after the search is finished
+inline void finish(const checkpoint_param& cp) {
+	if (!cp.enabled()) return;
+	std::remove(cp.file.c_str());
+}
+
+} // namespace checkpoint_sub
+
+} // namespace kv
+
+#endif // CHECKPOINT_HPP
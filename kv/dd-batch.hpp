@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef DD_BATCH_HPP
+#define DD_BATCH_HPP
+
+// dot products of dd and interval<dd> over contiguous arrays
+//
+// usage:
+//   kv::dd_vector x(n), y(n);         // struct of arrays (a1[], a2[])
+//   kv::dd u = kv::dd_batch::dot_up(x, y);    // u >= sum x[i] * y[i]
+//   kv::dd l = kv::dd_batch::dot_down(x, y);  // l <= sum x[i] * y[i]
+//   kv::interval<kv::dd> s = kv::dd_batch::dot(p, 1, q, 1, n);
+//   kv::dd_batch::conv(p, q, r, n);   // r[k] = sum_{j<=k} p[j] * q[k-j]
+//
+// The upper bound is accumulated lane by lane in the form s1 + s2
+// (double + double) like Dot2 of Ogita, Rump and Oishi, but every
+// operation is rounded upward:
+//   p1 + p2 >= x * y  : p1 = x1*y1, p2 = fma(x1, y1, -p1) + (tail)
+//   s1 + s2 >= s + p  : h = s1 + p1, error of the addition is bounded
+//                       by TwoSum with |big| >= |small|, in which
+//                       h - big is exact in any rounding mode, and
+//                       (h, error + s2 + p2) is normalized in the
+//                       same way
+// and the lanes are added and normalized to dd at the end. The lower
+// bound is obtained by down(x * y) = -up((-x) * y).
+//  - KV_USE_AVX512: 8 lanes with embedded rounding
+//  - __AVX2__ and __FMA__ (and not KV_NOHWROUND): 4 lanes with the
+//    rounding mode set upward once per call
+//  - otherwise: scalar loop using rop<dd>
+// If the result is not finite (inf or NaN in the arrays), it is
+// recomputed by the scalar loop.
+//
+// For interval<dd>, the end points which give the bounds of each
+// product are selected by the signs as in interval::operator*, and
+// the products whose both factors contain 0 are added by scalar
+// operations. The results are not the same as those of the scalar
+// interval operations, but the widths are of the same order.
+//
+// Including this file makes psa< interval<dd> >::operator* and
+// mm_mult for interval<dd> matrices use these kernels.
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#include <kv/psa.hpp>
+#include <kv/matrix-inversion.hpp>
+
+#if defined(KV_USE_AVX512) || (!defined(KV_NOHWROUND) && defined(__AVX2__) && defined(__FMA__))
+#include <immintrin.h>
+#endif
+
+#if !defined(KV_USE_AVX512) && !defined(KV_NOHWROUND) && defined(__AVX2__) && defined(__FMA__)
+#include <kv/hwround.hpp>
+#endif
+
+
+// kernels are used for the dot products of at least DD_BATCH_MIN terms
+
+#ifndef DD_BATCH_MIN
+#define DD_BATCH_MIN 4
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+// vector of dd stored as struct of arrays
+
+class dd_vector {
+	public:
+	std::vector<double> a1, a2;
+
+	dd_vector() {}
+
+	explicit dd_vector(std::size_t n) : a1(n), a2(n) {}
+
+	std::size_t size() const {
+		return a1.size();
+	}
+
+	void resize(std::size_t n) {
+		a1.resize(n);
+		a2.resize(n);
+	}
+
+	dd get(std::size_t i) const {
+		return dd(a1[i], a2[i]);
+	}
+
+	void set(std::size_t i, const dd& x) {
+		a1[i] = x.a1;
+		a2[i] = x.a2;
+	}
+
+	// set -x
+	void set_neg(std::size_t i, const dd& x) {
+		a1[i] = -x.a1;
+		a2[i] = -x.a2;
+	}
+};
+
+
+struct dd_batch {
+
+	// end points selected for interval dot products
+	struct work {
+		dd_vector ux, uy, lx, ly;
+	};
+
+	static work& get_work() {
+#ifdef _OPENMP // hack for non-POD thread local storage
+		static work* w = NULL;
+		#pragma omp threadprivate (w)
+		if (w == NULL) {
+			w = new work();
+		}
+		return *w;
+#else
+		static work w;
+		return w;
+#endif
+	}
+
+	static bool finite(double x) {
+		return std::fabs(x) <= (std::numeric_limits<double>::max)();
+	}
+
+	static dd dot_up_scalar(const double* x1, const double* x2, const double* y1, const double* y2, std::size_t n) {
+		dd s(0., 0.);
+
+		for (std::size_t i=0; i<n; i++) {
+			s = rop<dd>::add_up(s, rop<dd>::mul_up(dd(x1[i], x2[i]), dd(y1[i], y2[i])));
+		}
+
+		return s;
+	}
+
+	// add the lanes (l1[i] + l2[i]) rounding upward and normalize.
+	// called with rounding to nearest.
+	static bool reduce_up(const double* l1, const double* l2, int m, dd& r) {
+		double r1, r2, h, t, e, big, small, z1, z2;
+		int i;
+
+		r1 = l1[0];
+		r2 = l2[0];
+		for (i=1; i<m; i++) {
+			h = rop<double>::add_up(r1, l1[i]);
+			if (std::fabs(r1) >= std::fabs(l1[i])) {
+				big = r1; small = l1[i];
+			} else {
+				big = l1[i]; small = r1;
+			}
+			t = h - big; // exact
+			e = rop<double>::sub_up(small, t);
+			r2 = rop<double>::add_up(r2, rop<double>::add_up(e, l2[i]));
+			r1 = h;
+		}
+
+		if (!finite(r1) || !finite(r2)) return false;
+
+		dd::twosum(r1, r2, z1, z2);
+		if (z1 == std::numeric_limits<double>::infinity()) {
+			r = dd(z1, 0.);
+		} else if (z1 == -std::numeric_limits<double>::infinity()) {
+			r = -(std::numeric_limits<dd>::max)();
+		} else {
+			r = dd(z1, z2);
+		}
+		return true;
+	}
+
+#if defined(KV_USE_AVX512)
+
+	#define KV_BATCH_UP (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+
+	// (s1, s2) += (a1, a2) * (b1, b2) rounding upward
+	static void step512(const __m512d& a1, const __m512d& a2, const __m512d& b1, const __m512d& b2, __m512d& s1, __m512d& s2) {
+		__m512d p1, p2, h, big, small, t;
+		__mmask8 m;
+
+		p1 = _mm512_mul_round_pd(a1, b1, KV_BATCH_UP);
+		p2 = _mm512_fmsub_round_pd(a1, b1, p1, KV_BATCH_UP);
+		t = _mm512_fmadd_round_pd(a1, b2, _mm512_fmadd_round_pd(a2, b1, _mm512_mul_round_pd(a2, b2, KV_BATCH_UP), KV_BATCH_UP), KV_BATCH_UP);
+		p2 = _mm512_add_round_pd(p2, t, KV_BATCH_UP);
+
+		h = _mm512_add_round_pd(s1, p1, KV_BATCH_UP);
+		m = _mm512_cmp_pd_mask(_mm512_abs_pd(s1), _mm512_abs_pd(p1), _CMP_GE_OQ);
+		big = _mm512_mask_blend_pd(m, p1, s1);
+		small = _mm512_mask_blend_pd(m, s1, p1);
+		t = _mm512_sub_round_pd(h, big, KV_BATCH_UP);
+		t = _mm512_sub_round_pd(small, t, KV_BATCH_UP);
+		t = _mm512_add_round_pd(s2, _mm512_add_round_pd(t, p2, KV_BATCH_UP), KV_BATCH_UP);
+
+		// normalize (h, t)
+		s1 = _mm512_add_round_pd(h, t, KV_BATCH_UP);
+		m = _mm512_cmp_pd_mask(_mm512_abs_pd(h), _mm512_abs_pd(t), _CMP_GE_OQ);
+		big = _mm512_mask_blend_pd(m, t, h);
+		small = _mm512_mask_blend_pd(m, h, t);
+		s2 = _mm512_sub_round_pd(small, _mm512_sub_round_pd(s1, big, KV_BATCH_UP), KV_BATCH_UP);
+	}
+
+	static bool dot_up_simd(const double* x1, const double* x2, const double* y1, const double* y2, std::size_t n, dd& r) {
+		__m512d s1, s2;
+		__mmask8 m;
+		double l1[8], l2[8];
+		std::size_t i;
+
+		s1 = _mm512_setzero_pd();
+		s2 = _mm512_setzero_pd();
+		for (i=0; i+8<=n; i+=8) {
+			step512(_mm512_loadu_pd(x1 + i), _mm512_loadu_pd(x2 + i), _mm512_loadu_pd(y1 + i), _mm512_loadu_pd(y2 + i), s1, s2);
+		}
+		if (i < n) {
+			// missing lanes are 0
+			m = (__mmask8)((1U << (n - i)) - 1);
+			step512(_mm512_maskz_loadu_pd(m, x1 + i), _mm512_maskz_loadu_pd(m, x2 + i), _mm512_maskz_loadu_pd(m, y1 + i), _mm512_maskz_loadu_pd(m, y2 + i), s1, s2);
+		}
+		_mm512_storeu_pd(l1, s1);
+		_mm512_storeu_pd(l2, s2);
+
+		return reduce_up(l1, l2, 8, r);
+	}
+
+	#undef KV_BATCH_UP
+
+#elif !defined(KV_NOHWROUND) && defined(__AVX2__) && defined(__FMA__)
+
+	// must be called with rounding upward
+	static void step256(const __m256d& a1, const __m256d& a2, const __m256d& b1, const __m256d& b2, __m256d& s1, __m256d& s2) {
+		__m256d p1, p2, h, big, small, t, m, sign;
+
+		p1 = _mm256_mul_pd(a1, b1);
+		p2 = _mm256_fmsub_pd(a1, b1, p1);
+		t = _mm256_fmadd_pd(a1, b2, _mm256_fmadd_pd(a2, b1, _mm256_mul_pd(a2, b2)));
+		p2 = _mm256_add_pd(p2, t);
+
+		sign = _mm256_set1_pd(-0.);
+		h = _mm256_add_pd(s1, p1);
+		m = _mm256_cmp_pd(_mm256_andnot_pd(sign, s1), _mm256_andnot_pd(sign, p1), _CMP_GE_OQ);
+		big = _mm256_blendv_pd(p1, s1, m);
+		small = _mm256_blendv_pd(s1, p1, m);
+		t = _mm256_sub_pd(h, big);
+		t = _mm256_sub_pd(small, t);
+		t = _mm256_add_pd(s2, _mm256_add_pd(t, p2));
+
+		// normalize (h, t)
+		s1 = _mm256_add_pd(h, t);
+		m = _mm256_cmp_pd(_mm256_andnot_pd(sign, h), _mm256_andnot_pd(sign, t), _CMP_GE_OQ);
+		big = _mm256_blendv_pd(t, h, m);
+		small = _mm256_blendv_pd(h, t, m);
+		s2 = _mm256_sub_pd(small, _mm256_sub_pd(s1, big));
+	}
+
+	static bool dot_up_simd(const double* x1, const double* x2, const double* y1, const double* y2, std::size_t n, dd& r) {
+		__m256d s1, s2;
+		__m256i m;
+		double l1[4], l2[4];
+		std::size_t i;
+		long long k;
+
+		s1 = _mm256_setzero_pd();
+		s2 = _mm256_setzero_pd();
+		hwround::roundup();
+		for (i=0; i+4<=n; i+=4) {
+			step256(_mm256_loadu_pd(x1 + i), _mm256_loadu_pd(x2 + i), _mm256_loadu_pd(y1 + i), _mm256_loadu_pd(y2 + i), s1, s2);
+		}
+		if (i < n) {
+			// missing lanes are 0
+			k = (long long)(n - i);
+			m = _mm256_set_epi64x(k > 3 ? -1 : 0, k > 2 ? -1 : 0, k > 1 ? -1 : 0, -1);
+			step256(_mm256_maskload_pd(x1 + i, m), _mm256_maskload_pd(x2 + i, m), _mm256_maskload_pd(y1 + i, m), _mm256_maskload_pd(y2 + i, m), s1, s2);
+		}
+		hwround_state::restore();
+		_mm256_storeu_pd(l1, s1);
+		_mm256_storeu_pd(l2, s2);
+
+		return reduce_up(l1, l2, 4, r);
+	}
+
+#else
+
+	static bool dot_up_simd(const double*, const double*, const double*, const double*, std::size_t, dd&) {
+		return false;
+	}
+
+#endif
+
+	// upper bound of sum (x1[i] + x2[i]) * (y1[i] + y2[i])
+	static dd dot_up(const double* x1, const double* x2, const double* y1, const double* y2, std::size_t n) {
+		dd r;
+
+		if (n == 0) return dd(0., 0.);
+		if (dot_up_simd(x1, x2, y1, y2, n, r)) return r;
+		return dot_up_scalar(x1, x2, y1, y2, n);
+	}
+
+	static dd dot_up(const dd_vector& x, const dd_vector& y) {
+		std::size_t n = x.size();
+
+		if (n == 0) return dd(0., 0.);
+		return dot_up(&x.a1[0], &x.a2[0], &y.a1[0], &y.a2[0], n);
+	}
+
+	static dd dot_down(const dd_vector& x, const dd_vector& y) {
+		std::size_t i, n = x.size();
+		dd_vector z(n);
+
+		if (n == 0) return dd(0., 0.);
+		for (i=0; i<n; i++) {
+			z.a1[i] = -x.a1[i];
+			z.a2[i] = -x.a2[i];
+		}
+		return -dot_up(&z.a1[0], &z.a2[0], &y.a1[0], &y.a2[0], n);
+	}
+
+	// sum x[i*incx] * y[i*incy] (i = 0, ..., n-1)
+	static interval<dd> dot(const interval<dd>* x, std::ptrdiff_t incx, const interval<dd>* y, std::ptrdiff_t incy, std::size_t n) {
+		work& w = get_work();
+		interval<dd> rest, r;
+		bool use_rest = false;
+		std::size_t i, m;
+		int cx, cy;
+		dd lo, up;
+
+		if (n < DD_BATCH_MIN) {
+			r = 0.;
+			for (i=0; i<n; i++) r += x[i * incx] * y[i * incy];
+			return r;
+		}
+
+		if (w.ux.size() < n) {
+			w.ux.resize(n); w.uy.resize(n);
+			w.lx.resize(n); w.ly.resize(n);
+		}
+
+		rest = 0.;
+		m = 0;
+		for (i=0; i<n; i++) {
+			const interval<dd>& a = x[i * incx];
+			const interval<dd>& b = y[i * incy];
+			const dd& a1 = a.lower();
+			const dd& a2 = a.upper();
+			const dd& b1 = b.lower();
+			const dd& b2 = b.upper();
+
+			// 0: >= 0, 1: <= 0, 2: contains 0
+			cx = a1.a1 >= 0. ? 0 : (a2.a1 <= 0. ? 1 : 2);
+			cy = b1.a1 >= 0. ? 0 : (b2.a1 <= 0. ? 1 : 2);
+
+			// lower bound: -(lx * ly), upper bound: ux * uy
+			switch (cx * 3 + cy) {
+				case 0:
+					w.lx.set_neg(m, a1); w.ly.set(m, b1);
+					w.ux.set(m, a2); w.uy.set(m, b2);
+					break;
+				case 1:
+					w.lx.set_neg(m, a2); w.ly.set(m, b1);
+					w.ux.set(m, a1); w.uy.set(m, b2);
+					break;
+				case 2:
+					w.lx.set_neg(m, a2); w.ly.set(m, b1);
+					w.ux.set(m, a2); w.uy.set(m, b2);
+					break;
+				case 3:
+					w.lx.set_neg(m, a1); w.ly.set(m, b2);
+					w.ux.set(m, a2); w.uy.set(m, b1);
+					break;
+				case 4:
+					w.lx.set_neg(m, a2); w.ly.set(m, b2);
+					w.ux.set(m, a1); w.uy.set(m, b1);
+					break;
+				case 5:
+					w.lx.set_neg(m, a1); w.ly.set(m, b2);
+					w.ux.set(m, a1); w.uy.set(m, b1);
+					break;
+				case 6:
+					w.lx.set_neg(m, a1); w.ly.set(m, b2);
+					w.ux.set(m, a2); w.uy.set(m, b2);
+					break;
+				case 7:
+					w.lx.set_neg(m, a2); w.ly.set(m, b1);
+					w.ux.set(m, a1); w.uy.set(m, b1);
+					break;
+				default:
+					// both contain 0
+					rest += a * b;
+					use_rest = true;
+					continue;
+			}
+			m++;
+		}
+
+		lo = -dot_up(&w.lx.a1[0], &w.lx.a2[0], &w.ly.a1[0], &w.ly.a2[0], m);
+		up = dot_up(&w.ux.a1[0], &w.ux.a2[0], &w.uy.a1[0], &w.uy.a2[0], m);
+		if (use_rest) {
+			lo = rop<dd>::add_down(lo, rest.lower());
+			up = rop<dd>::add_up(up, rest.upper());
+		}
+
+		// NaN (0 * inf): use the scalar operations
+		if (!(lo.a1 == lo.a1) || !(up.a1 == up.a1)) {
+			r = 0.;
+			for (i=0; i<n; i++) r += x[i * incx] * y[i * incy];
+			return r;
+		}
+
+		r.assign(lo, up);
+		return r;
+	}
+
+	// r[k] = sum_{j=0}^{k} x[j] * y[k-j] (k = 0, ..., n-1)
+	static void conv(const interval<dd>* x, const interval<dd>* y, interval<dd>* r, std::size_t n) {
+		std::vector< interval<dd> > tmp(n);
+
+		for (std::size_t k=0; k<n; k++) {
+			tmp[k] = dot(x, 1, y + k, -1, k + 1);
+		}
+		for (std::size_t k=0; k<n; k++) r[k] = tmp[k];
+	}
+};
+
+
+// sum of products of psa multiplication
+
+template <> struct psa_dot< interval<dd> > {
+	template <class V> static interval<dd> conv(const V& a, const V& b, int i, int j0, int j1) {
+		return dd_batch::dot(&a(j0), 1, &b(i-j0), -1, j1 - j0 + 1);
+	}
+};
+
+
+// c = a * b by the dot product kernel
+// (c may be the same as a or b)
+
+inline void mm_mult(const ub::matrix< interval<dd> >& a, const ub::matrix< interval<dd> >& b, ub::matrix< interval<dd> >& c) {
+	int m = a.size1();
+	int k = a.size2();
+	int n = b.size2();
+	int i, j;
+
+	if (k < DD_BATCH_MIN) {
+		c = ub::prod(a, b);
+		return;
+	}
+
+	ub::matrix< interval<dd> > r(m, n);
+
+	// ub::matrix is stored in row major order
+	for (i=0; i<m; i++) {
+		for (j=0; j<n; j++) {
+			r(i, j) = dd_batch::dot(&a(i, 0), 1, &b(0, j), n, k);
+		}
+	}
+
+	c.swap(r);
+}
+
+} // namespace kv
+
+#endif // DD_BATCH_HPP
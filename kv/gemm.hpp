@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+// blocked matrix multiplication kernel for double
+//
+// c (m x n) = a (m x k) * b (k x n)
+// all the matrices are stored in row major order with leading
+// dimensions lda, ldb, ldc.
+// if up is true, the result is computed with rounding upward, so that
+// c is an upper bound of the exact product. the rounding mode is
+// changed only once per block of rows (each OpenMP thread has its own
+// rounding mode).
+
+#include <algorithm>
+
+#ifndef KV_NOHWROUND
+#include <kv/hwround.hpp>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+// block sizes (number of rows, columns and inner products)
+
+#ifndef GEMM_BLOCK_M
+#define GEMM_BLOCK_M 32
+#endif
+
+#ifndef GEMM_BLOCK_N
+#define GEMM_BLOCK_N 512
+#endif
+
+#ifndef GEMM_BLOCK_K
+#define GEMM_BLOCK_K 128
+#endif
+
+// use threads only if m * n * k is larger than this
+
+#ifndef GEMM_PARALLEL_MIN
+#define GEMM_PARALLEL_MIN 32768
+#endif
+
+
+namespace kv {
+
+inline void gemm(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc, bool up = false) {
+	int nb = (m + GEMM_BLOCK_M - 1) / GEMM_BLOCK_M;
+	int bi;
+
+	#ifdef _OPENMP
+	#pragma omp parallel for schedule(dynamic) if ((double)m * n * k >= GEMM_PARALLEL_MIN)
+	#endif
+	for (bi=0; bi<nb; bi++) {
+		int i, j, l, i0, i1, j0, j1, l0, l1;
+		double* ci;
+		const double* bl;
+		double ail;
+
+		i0 = bi * GEMM_BLOCK_M;
+		i1 = std::min(m, i0 + GEMM_BLOCK_M);
+
+		#ifndef KV_NOHWROUND
+		if (up) hwround::roundup();
+		#endif
+
+		for (i=i0; i<i1; i++) {
+			ci = c + i * ldc;
+			for (j=0; j<n; j++) ci[j] = 0.;
+		}
+
+		for (l0=0; l0<k; l0+=GEMM_BLOCK_K) {
+			l1 = std::min(k, l0 + GEMM_BLOCK_K);
+			for (j0=0; j0<n; j0+=GEMM_BLOCK_N) {
+				j1 = std::min(n, j0 + GEMM_BLOCK_N);
+				for (i=i0; i<i1; i++) {
+					ci = c + i * ldc;
+					for (l=l0; l<l1; l++) {
+						ail = a[i * lda + l];
+						bl = b + l * ldb;
+						for (j=j0; j<j1; j++) {
+							ci[j] += ail * bl[j];
+						}
+					}
+				}
+			}
+		}
+
+		#ifndef KV_NOHWROUND
+		if (up) hwround_state::restore();
+		#endif
+	}
+}
+
+} // namespace kv
+
+#endif // GEMM_HPP
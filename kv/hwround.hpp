@@ -211,6 +211,79 @@ struct hwround {
 
 #endif // KV_FASTROUND
 
+
+/*
+ * Upward Rounding Scope
+ *
+ *   {
+ *     kv::upward_scope u;    // rounding mode is upward in this scope
+ *     ... interval<double> operations ...
+ *     {
+ *       kv::nearest_scope n; // round to nearest temporarily
+ *       ... approximate computations by double, dd, ...
+ *     }
+ *   }
+ *
+ * With KV_USE_UPWARD, rop<double>::begin() and end() (rdouble-hwround.hpp)
+ * do not change the rounding mode in upward_scope, so that interval<double>
+ * operations in it need no rounding mode changes. The lower bounds are
+ * computed by down(x) = -up(-x) as before.
+ * In upward_scope all the double operations are rounded upward. The types
+ * which assume round to nearest (dd, the error-free transformations, ...)
+ * must be used in nearest_scope.
+ * The state is per thread. The scopes may be nested.
+ */
+
+struct hwround_state {
+	// number of nested upward_scope of the current thread
+	static int& depth() {
+		static int d = 0;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(d)
+		#endif
+		return d;
+	}
+
+	// rounding mode outside of the kernels which change it:
+	// upward in upward_scope, otherwise nearest
+	static void restore() {
+		if (depth() > 0) hwround::roundup();
+		else hwround::roundnear();
+	}
+};
+
+struct upward_scope {
+	upward_scope() {
+		if (hwround_state::depth()++ == 0) hwround::roundup();
+	}
+
+	~upward_scope() {
+		if (--hwround_state::depth() == 0) hwround::roundnear();
+	}
+
+	private:
+	upward_scope(const upward_scope&);
+	upward_scope& operator=(const upward_scope&);
+};
+
+struct nearest_scope {
+	int saved;
+
+	nearest_scope() : saved(hwround_state::depth()) {
+		hwround_state::depth() = 0;
+		if (saved > 0) hwround::roundnear();
+	}
+
+	~nearest_scope() {
+		hwround_state::depth() = saved;
+		if (saved > 0) hwround::roundup();
+	}
+
+	private:
+	nearest_scope(const nearest_scope&);
+	nearest_scope& operator=(const nearest_scope&);
+};
+
 } // namespace kv
 
 #endif // HWROUND_HPP
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef INTERVAL_BATCH_HPP
+#define INTERVAL_BATCH_HPP
+
+// interval arithmetic over contiguous arrays
+//
+// usage:
+//   kv::batch::add(x, y, r, n);     // r[i] = x[i] + y[i]
+//   kv::batch::sub(x, y, r, n);     // r[i] = x[i] - y[i]
+//   kv::batch::mul(x, y, r, n);     // r[i] = x[i] * y[i]
+//   kv::batch::div(x, y, r, n);     // r[i] = x[i] / y[i]
+//   kv::batch::fma(x, y, z, r, n);  // r[i] = x[i] * y[i] + z[i]
+//   kv::batch::sincos(x, s, c, n);  // s[i] = sin(x[i]), c[i] = cos(x[i])
+//
+// For interval<double>, the arrays are processed by SIMD kernels.
+// Each interval [a,b] is held in a register as (-a, b) and every
+// operation is rounded upward, so that the lower bound is obtained
+// by down(f(a,b)) = -up(-f(a,b)).
+//  - KV_USE_AVX512: AVX-512 with embedded rounding (no mode change)
+//  - __AVX__ (and not KV_NOHWROUND): AVX with the rounding mode set
+//    upward only once per call
+//  - otherwise: scalar loop using rop<double>
+// Lanes which produce NaN (0*inf, inf/inf, ...) are recomputed by the
+// scalar operators, so the results are always the same as those of the
+// scalar interval operations.
+
+#include <cstddef>
+#include <stdexcept>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+
+#if defined(KV_USE_AVX512) || (!defined(KV_NOHWROUND) && defined(__AVX__))
+#include <immintrin.h>
+#endif
+
+#if !defined(KV_USE_AVX512) && !defined(KV_NOHWROUND) && defined(__AVX__)
+#include <kv/hwround.hpp>
+#endif
+
+
+namespace kv {
+
+struct batch {
+
+	template <class T> static void add(const interval<T>* x, const interval<T>* y, interval<T>* r, std::size_t n) {
+		for (std::size_t i=0; i<n; i++) r[i] = x[i] + y[i];
+	}
+
+	template <class T> static void sub(const interval<T>* x, const interval<T>* y, interval<T>* r, std::size_t n) {
+		for (std::size_t i=0; i<n; i++) r[i] = x[i] - y[i];
+	}
+
+	template <class T> static void mul(const interval<T>* x, const interval<T>* y, interval<T>* r, std::size_t n) {
+		for (std::size_t i=0; i<n; i++) r[i] = x[i] * y[i];
+	}
+
+	template <class T> static void div(const interval<T>* x, const interval<T>* y, interval<T>* r, std::size_t n) {
+		for (std::size_t i=0; i<n; i++) r[i] = x[i] / y[i];
+	}
+
+	template <class T> static void fma(const interval<T>* x, const interval<T>* y, const interval<T>* z, interval<T>* r, std::size_t n) {
+		for (std::size_t i=0; i<n; i++) r[i] = x[i] * y[i] + z[i];
+	}
+
+	template <class T> static void sincos(const interval<T>* x, interval<T>* s, interval<T>* c, std::size_t n) {
+		interval<T> tmp;
+		for (std::size_t i=0; i<n; i++) {
+			tmp = x[i];
+			s[i] = sin(tmp);
+			c[i] = cos(tmp);
+		}
+	}
+
+	// argument reduction is shared by sin and cos
+	static void sincos(const interval<double>* x, interval<double>* s, interval<double>* c, std::size_t n) {
+		interval<double> tmp;
+		for (std::size_t i=0; i<n; i++) {
+			tmp = x[i];
+			if (!rdouble_elementary::sincos_range(tmp, true, true, s[i], c[i])) {
+				s[i] = sin(tmp);
+				c[i] = cos(tmp);
+			}
+		}
+	}
+
+#if defined(KV_USE_AVX512)
+
+	// 4 intervals per register
+
+	#define KV_BATCH_UP (_MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+
+	static __m512d neglow512() {
+		return _mm512_set_pd(0., -0., 0., -0., 0., -0., 0., -0.);
+	}
+
+	static __m512d load512(const interval<double>* x) {
+		return _mm512_xor_pd(_mm512_loadu_pd((const double*)x), neglow512());
+	}
+
+	static void store512(interval<double>* r, const __m512d& a) {
+		_mm512_storeu_pd((double*)r, _mm512_xor_pd(a, neglow512()));
+	}
+
+	// (-a, b) * (-c, d) -> (-lower, upper). returns false if NaN appears.
+	static bool mul512(const __m512d& a, const __m512d& b, __m512d& r) {
+		__m512d bi, bs, a2, p1, p2, p3, p4;
+		__mmask8 m;
+
+		// bi = (c, c), bs = (d, d), a2 = (-b, a)
+		bi = _mm512_xor_pd(_mm512_movedup_pd(b), _mm512_set1_pd(-0.));
+		bs = _mm512_permute_pd(b, 0xff);
+		a2 = _mm512_xor_pd(_mm512_permute_pd(a, 0x55), _mm512_set1_pd(-0.));
+
+		p1 = _mm512_mul_round_pd(a, bi, KV_BATCH_UP);
+		p2 = _mm512_mul_round_pd(a, bs, KV_BATCH_UP);
+		p3 = _mm512_mul_round_pd(a2, bi, KV_BATCH_UP);
+		p4 = _mm512_mul_round_pd(a2, bs, KV_BATCH_UP);
+
+		m = _mm512_cmp_pd_mask(p1, p2, _CMP_UNORD_Q) | _mm512_cmp_pd_mask(p3, p4, _CMP_UNORD_Q);
+		r = _mm512_max_pd(_mm512_max_pd(p1, p2), _mm512_max_pd(p3, p4));
+
+		return m == 0;
+	}
+
+	// (-a, b) / (-c, d) -> (-lower, upper). returns false if NaN appears.
+	static bool div512(const __m512d& a, const __m512d& b, __m512d& r) {
+		__m512d bi, bs, a2, p1, p2, p3, p4;
+		__mmask8 m;
+
+		bi = _mm512_xor_pd(_mm512_movedup_pd(b), _mm512_set1_pd(-0.));
+		bs = _mm512_permute_pd(b, 0xff);
+		a2 = _mm512_xor_pd(_mm512_permute_pd(a, 0x55), _mm512_set1_pd(-0.));
+
+		p1 = _mm512_div_round_pd(a, bi, KV_BATCH_UP);
+		p2 = _mm512_div_round_pd(a, bs, KV_BATCH_UP);
+		p3 = _mm512_div_round_pd(a2, bi, KV_BATCH_UP);
+		p4 = _mm512_div_round_pd(a2, bs, KV_BATCH_UP);
+
+		m = _mm512_cmp_pd_mask(p1, p2, _CMP_UNORD_Q) | _mm512_cmp_pd_mask(p3, p4, _CMP_UNORD_Q);
+		r = _mm512_max_pd(_mm512_max_pd(p1, p2), _mm512_max_pd(p3, p4));
+
+		return m == 0;
+	}
+
+	// true if one of 4 intervals (-c, d) contains 0
+	static bool zero_in512(const __m512d& b) {
+		unsigned int m;
+		m = _mm512_cmp_pd_mask(b, _mm512_setzero_pd(), _CMP_GE_OQ);
+		return (m & (m >> 1) & 0x55) != 0;
+	}
+
+	static void add(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i;
+
+		for (i=0; i+4<=n; i+=4) {
+			store512(r + i, _mm512_add_round_pd(load512(x + i), load512(y + i), KV_BATCH_UP));
+		}
+		for (; i<n; i++) r[i] = x[i] + y[i];
+	}
+
+	static void sub(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i;
+
+		for (i=0; i+4<=n; i+=4) {
+			// (-a, b) + (d, -c)
+			store512(r + i, _mm512_add_round_pd(load512(x + i), _mm512_permute_pd(load512(y + i), 0x55), KV_BATCH_UP));
+		}
+		for (; i<n; i++) r[i] = x[i] - y[i];
+	}
+
+	static void mul(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m512d z;
+
+		for (i=0; i+4<=n; i+=4) {
+			if (mul512(load512(x + i), load512(y + i), z)) {
+				store512(r + i, z);
+			} else {
+				for (j=i; j<i+4; j++) r[j] = x[j] * y[j];
+			}
+		}
+		for (; i<n; i++) r[i] = x[i] * y[i];
+	}
+
+	static void div(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m512d b, z;
+
+		for (i=0; i+4<=n; i+=4) {
+			b = load512(y + i);
+			if (zero_in512(b)) {
+				throw std::domain_error("interval: division by 0");
+			}
+			if (div512(load512(x + i), b, z)) {
+				store512(r + i, z);
+			} else {
+				for (j=i; j<i+4; j++) r[j] = x[j] / y[j];
+			}
+		}
+		for (; i<n; i++) r[i] = x[i] / y[i];
+	}
+
+	static void fma(const interval<double>* x, const interval<double>* y, const interval<double>* z, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m512d w;
+
+		for (i=0; i+4<=n; i+=4) {
+			if (mul512(load512(x + i), load512(y + i), w)) {
+				store512(r + i, _mm512_add_round_pd(w, load512(z + i), KV_BATCH_UP));
+			} else {
+				for (j=i; j<i+4; j++) r[j] = x[j] * y[j] + z[j];
+			}
+		}
+		for (; i<n; i++) r[i] = x[i] * y[i] + z[i];
+	}
+
+	#undef KV_BATCH_UP
+
+#elif !defined(KV_NOHWROUND) && defined(__AVX__)
+
+	// 2 intervals per register. The rounding mode is changed to upward
+	// at the beginning of the loop and restored at the end. Scalar
+	// operations in the loop restore the rounding mode to nearest,
+	// so it is set upward again after them.
+
+	static __m256d neglow256() {
+		return _mm256_set_pd(0., -0., 0., -0.);
+	}
+
+	static __m256d load256(const interval<double>* x) {
+		return _mm256_xor_pd(_mm256_loadu_pd((const double*)x), neglow256());
+	}
+
+	static void store256(interval<double>* r, const __m256d& a) {
+		_mm256_storeu_pd((double*)r, _mm256_xor_pd(a, neglow256()));
+	}
+
+	static bool mul256(const __m256d& a, const __m256d& b, __m256d& r) {
+		__m256d bi, bs, a2, p1, p2, p3, p4, m;
+
+		bi = _mm256_xor_pd(_mm256_movedup_pd(b), _mm256_set1_pd(-0.));
+		bs = _mm256_permute_pd(b, 0xf);
+		a2 = _mm256_xor_pd(_mm256_permute_pd(a, 0x5), _mm256_set1_pd(-0.));
+
+		p1 = _mm256_mul_pd(a, bi);
+		p2 = _mm256_mul_pd(a, bs);
+		p3 = _mm256_mul_pd(a2, bi);
+		p4 = _mm256_mul_pd(a2, bs);
+
+		m = _mm256_or_pd(_mm256_cmp_pd(p1, p2, _CMP_UNORD_Q), _mm256_cmp_pd(p3, p4, _CMP_UNORD_Q));
+		r = _mm256_max_pd(_mm256_max_pd(p1, p2), _mm256_max_pd(p3, p4));
+
+		return _mm256_movemask_pd(m) == 0;
+	}
+
+	static bool div256(const __m256d& a, const __m256d& b, __m256d& r) {
+		__m256d bi, bs, a2, p1, p2, p3, p4, m;
+
+		bi = _mm256_xor_pd(_mm256_movedup_pd(b), _mm256_set1_pd(-0.));
+		bs = _mm256_permute_pd(b, 0xf);
+		a2 = _mm256_xor_pd(_mm256_permute_pd(a, 0x5), _mm256_set1_pd(-0.));
+
+		p1 = _mm256_div_pd(a, bi);
+		p2 = _mm256_div_pd(a, bs);
+		p3 = _mm256_div_pd(a2, bi);
+		p4 = _mm256_div_pd(a2, bs);
+
+		m = _mm256_or_pd(_mm256_cmp_pd(p1, p2, _CMP_UNORD_Q), _mm256_cmp_pd(p3, p4, _CMP_UNORD_Q));
+		r = _mm256_max_pd(_mm256_max_pd(p1, p2), _mm256_max_pd(p3, p4));
+
+		return _mm256_movemask_pd(m) == 0;
+	}
+
+	static bool zero_in256(const __m256d& b) {
+		int m;
+		m = _mm256_movemask_pd(_mm256_cmp_pd(b, _mm256_setzero_pd(), _CMP_GE_OQ));
+		return (m & (m >> 1) & 0x5) != 0;
+	}
+
+	static void add(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i;
+
+		hwround::roundup();
+		for (i=0; i+2<=n; i+=2) {
+			store256(r + i, _mm256_add_pd(load256(x + i), load256(y + i)));
+		}
+		hwround_state::restore();
+		for (; i<n; i++) r[i] = x[i] + y[i];
+	}
+
+	static void sub(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i;
+
+		hwround::roundup();
+		for (i=0; i+2<=n; i+=2) {
+			store256(r + i, _mm256_add_pd(load256(x + i), _mm256_permute_pd(load256(y + i), 0x5)));
+		}
+		hwround_state::restore();
+		for (; i<n; i++) r[i] = x[i] - y[i];
+	}
+
+	static void mul(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m256d z;
+
+		hwround::roundup();
+		for (i=0; i+2<=n; i+=2) {
+			if (mul256(load256(x + i), load256(y + i), z)) {
+				store256(r + i, z);
+			} else {
+				for (j=i; j<i+2; j++) r[j] = x[j] * y[j];
+				hwround::roundup();
+			}
+		}
+		hwround_state::restore();
+		for (; i<n; i++) r[i] = x[i] * y[i];
+	}
+
+	static void div(const interval<double>* x, const interval<double>* y, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m256d b, z;
+
+		hwround::roundup();
+		for (i=0; i+2<=n; i+=2) {
+			b = load256(y + i);
+			if (zero_in256(b)) {
+				hwround_state::restore();
+				throw std::domain_error("interval: division by 0");
+			}
+			if (div256(load256(x + i), b, z)) {
+				store256(r + i, z);
+			} else {
+				for (j=i; j<i+2; j++) r[j] = x[j] / y[j];
+				hwround::roundup();
+			}
+		}
+		hwround_state::restore();
+		for (; i<n; i++) r[i] = x[i] / y[i];
+	}
+
+	static void fma(const interval<double>* x, const interval<double>* y, const interval<double>* z, interval<double>* r, std::size_t n) {
+		std::size_t i, j;
+		__m256d w;
+
+		hwround::roundup();
+		for (i=0; i+2<=n; i+=2) {
+			if (mul256(load256(x + i), load256(y + i), w)) {
+				store256(r + i, _mm256_add_pd(w, load256(z + i)));
+			} else {
+				for (j=i; j<i+2; j++) r[j] = x[j] * y[j] + z[j];
+				hwround::roundup();
+			}
+		}
+		hwround_state::restore();
+		for (; i<n; i++) r[i] = x[i] * y[i] + z[i];
+	}
+
+#endif
+};
+
+} // namespace kv
+
+#endif // INTERVAL_BATCH_HPP
@@ -174,7 +174,7 @@ inline void rounded_converter(const fp80& x, double& y, int rnd = 0)
 	r = x1;
 
 	if (rnd == 1 || rnd == -1) {
-		hwround::roundnear();
+		hwround_state::restore();
 	}
 
 	y = r;
@@ -286,7 +286,7 @@ inline void rounded_converter(const ddx& x, double& y, int rnd = 0)
 	r = x1 + x2;
 
 	if (rnd == 1 || rnd == -1) {
-		hwround::roundnear();
+		hwround_state::restore();
 	}
 
 	y = r;
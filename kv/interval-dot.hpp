@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef INTERVAL_DOT_HPP
+#define INTERVAL_DOT_HPP
+
+// accurate dot product of interval<double>
+//
+//   kv::interval_dot d;
+//   for (i=0; i<n; i++) d.add(x(i), y(i));  // double or interval<double>
+//   r = d.result();                         // contains sum x(i) * y(i)
+//
+// For each product, the end points which give its lower and upper
+// bounds are selected by the signs as in interval::operator*, so that
+// the bounds of the sum are two dot products of double vectors. They
+// are computed by Dot2 (T. Ogita, S. M. Rump, S. Oishi, Accurate sum
+// and dot product, SIAM J. Sci. Comput. 26 (2005)) with every
+// operation rounded upward:
+//   h = x * y, l = fma(x, y, -h)       : h + l >= x * y
+//   q = p + h, e = small - (q - big)   : q + e >= p + h
+//                                        (q - big is exact)
+//   result = p + sum (l + e)
+// The rounding errors of the sum are of order u^2 * sum |x * y|
+// instead of n * u * sum |x * y| of the naive interval summation.
+// The products whose both factors contain 0 and those with infinite
+// end points are added by the interval operations. If the result is
+// not finite, it is recomputed by the naive summation.
+// With KV_NOHWROUND, the naive summation is always used.
+//
+// kv::prod is overloaded for ub::matrix<double> or
+// ub::matrix< interval<double> > times a vector or matrix of
+// interval<double> (or double), so that unqualified prod(R, fc)
+// in allsol, kraw-approx, ... uses this. (ub::prod is not changed.)
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+
+#if !defined(KV_NOHWROUND)
+#include <kv/hwround.hpp>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+class interval_dot {
+	// selected end points: lower bound is -sum lx * ly,
+	// upper bound is sum ux * uy
+	std::vector<double> ux, uy, lx, ly;
+	int m;
+	interval<double> rest;
+	bool use_rest;
+
+	void push(double a, double b, double c, double d) {
+		if (m == (int)ux.size()) {
+			ux.push_back(a); uy.push_back(b);
+			lx.push_back(c); ly.push_back(d);
+		} else {
+			ux[m] = a; uy[m] = b;
+			lx[m] = c; ly[m] = d;
+		}
+		m++;
+	}
+
+	static bool finite(double x) {
+		return std::fabs(x) <= (std::numeric_limits<double>::max)();
+	}
+
+#if !defined(KV_NOHWROUND)
+	// upper bound of sum x[i] * y[i]. must be called with rounding upward.
+	static double dot_up(const double* x, const double* y, int n) {
+		double p, s, h, l, q, big, small;
+		int i;
+
+		p = 0.;
+		s = 0.;
+		for (i=0; i<n; i++) {
+			h = x[i] * y[i];
+			l = std::fma(x[i], y[i], -h);
+			q = p + h;
+			if (std::fabs(p) >= std::fabs(h)) {
+				big = p; small = h;
+			} else {
+				big = h; small = p;
+			}
+			s += (small - (q - big)) + l;
+			p = q;
+		}
+
+		return p + s;
+	}
+#endif
+
+	public:
+
+	interval_dot() : m(0), rest(0.), use_rest(false) {}
+
+	void clear() {
+		m = 0;
+		rest = 0.;
+		use_rest = false;
+	}
+
+	void add(const interval<double>& x, const interval<double>& y) {
+		const double& a = x.lower();
+		const double& b = x.upper();
+		const double& c = y.lower();
+		const double& d = y.upper();
+
+		if (!finite(a) || !finite(b) || !finite(c) || !finite(d)) {
+			rest += x * y;
+			use_rest = true;
+			return;
+		}
+
+		// same cases as interval::operator*
+		if (a >= 0.) {
+			if (c >= 0.) push(b, d, -a, c);
+			else if (d <= 0.) push(a, d, -b, c);
+			else push(b, d, -b, c);
+		} else if (b <= 0.) {
+			if (c >= 0.) push(b, c, -a, d);
+			else if (d <= 0.) push(a, c, -b, d);
+			else push(a, c, -a, d);
+		} else {
+			if (c >= 0.) push(b, d, -a, d);
+			else if (d <= 0.) push(a, c, -b, c);
+			else {
+				rest += x * y;
+				use_rest = true;
+			}
+		}
+	}
+
+	void add(double x, const interval<double>& y) {
+		const double& c = y.lower();
+		const double& d = y.upper();
+
+		if (!finite(x) || !finite(c) || !finite(d)) {
+			rest += x * y;
+			use_rest = true;
+			return;
+		}
+
+		if (x >= 0.) push(x, d, -x, c);
+		else push(x, c, -x, d);
+	}
+
+	void add(const interval<double>& x, double y) {
+		add(y, x);
+	}
+
+	void add(double x, double y) {
+		add(x, interval<double>(y));
+	}
+
+	interval<double> result() const {
+		double lo, up;
+		int i;
+
+#if !defined(KV_NOHWROUND)
+		if (m == 0) {
+			lo = up = 0.;
+		} else {
+			hwround::roundup();
+			up = dot_up(&ux[0], &uy[0], m);
+			lo = -dot_up(&lx[0], &ly[0], m);
+			hwround_state::restore();
+		}
+
+		if (!finite(lo) || !finite(up))
+#endif
+		{
+			lo = up = 0.;
+			for (i=0; i<m; i++) {
+				up = rop<double>::add_up(up, rop<double>::mul_up(ux[i], uy[i]));
+				lo = rop<double>::add_down(lo, -rop<double>::mul_up(lx[i], ly[i]));
+			}
+		}
+
+		if (use_rest) {
+			lo = rop<double>::add_down(lo, rest.lower());
+			up = rop<double>::add_up(up, rest.upper());
+		}
+
+		return interval<double>(lo, up);
+	}
+};
+
+
+namespace interval_dot_sub {
+
+template <class T> struct is_itv {
+	static const bool value = boost::is_same<T, interval<double> >::value;
+};
+
+template <class T> struct is_itv_or_double {
+	static const bool value = boost::is_same<T, interval<double> >::value || boost::is_same<T, double>::value;
+};
+
+template <class T1, class T2> struct result_type {
+	static const bool value = (is_itv<T1>::value && is_itv_or_double<T2>::value) || (boost::is_same<T1, double>::value && is_itv<T2>::value);
+};
+
+} // namespace interval_dot_sub
+
+
+// matrix * vector
+
+template <class T, class E>
+typename boost::enable_if_c< interval_dot_sub::result_type<T, typename E::value_type>::value, ub::vector< interval<double> > >::type
+prod(const ub::matrix<T>& a, const ub::vector_expression<E>& e) {
+	ub::vector<typename E::value_type> x(e);
+	int m = a.size1();
+	int n = a.size2();
+	int i, j;
+	ub::vector< interval<double> > r(m);
+	interval_dot d;
+
+	for (i=0; i<m; i++) {
+		d.clear();
+		for (j=0; j<n; j++) d.add(a(i, j), x(j));
+		r(i) = d.result();
+	}
+
+	return r;
+}
+
+// matrix * matrix
+
+template <class T, class E>
+typename boost::enable_if_c< interval_dot_sub::result_type<T, typename E::value_type>::value, ub::matrix< interval<double> > >::type
+prod(const ub::matrix<T>& a, const ub::matrix_expression<E>& e) {
+	ub::matrix<typename E::value_type> b(e);
+	int m = a.size1();
+	int n = a.size2();
+	int l = b.size2();
+	int i, j, k;
+	ub::matrix< interval<double> > r(m, l);
+	interval_dot d;
+
+	for (i=0; i<m; i++) {
+		for (k=0; k<l; k++) {
+			d.clear();
+			for (j=0; j<n; j++) d.add(a(i, j), b(j, k));
+			r(i, k) = d.result();
+		}
+	}
+
+	return r;
+}
+
+} // namespace kv
+
+#endif // INTERVAL_DOT_HPP
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef INTERVAL_GEMM_HPP
+#define INTERVAL_GEMM_HPP
+
+// verified product of interval matrices
+//
+// mm_mult(a, b, c) computes c which contains a * b, where a and/or b
+// are matrices of interval<double>.
+// the product is calculated by the midpoint-radius method
+// (S. M. Rump, Fast and parallel interval arithmetic, BIT 39 (1999)):
+//   a = <ma, ra>, b = <mb, rb>
+//   a * b is included in [down(ma * mb) - rr, up(ma * mb) + rr],
+//   rr = up(|ma| * rb + ra * (|mb| + rb))
+// so that it is reduced to two products of double matrices which are
+// computed by the blocked kernel gemm() with rounding upward.
+// the result is wider than that of prod (at most 1.5 times and the
+// rounding errors), so this is used only for matrices larger than
+// INTERVAL_GEMM_MIN. smaller ones use prod of interval-dot.hpp.
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-vector.hpp>
+#include <kv/interval-dot.hpp>
+#include <kv/gemm.hpp>
+#include <kv/matrix-inversion.hpp>
+
+
+#ifndef INTERVAL_GEMM_MIN
+#define INTERVAL_GEMM_MIN 32
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+namespace interval_gemm_sub {
+
+// midpoint and radius of x (must be called with rounding upward).
+// return false if they are not finite.
+inline bool midrad_up(const interval<double>& x, double& m, double& r) {
+	m = rop<double>::mul_up(rop<double>::add_up(x.lower(), x.upper()), 0.5);
+	r = rop<double>::sub_up(m, x.lower());
+	return std::fabs(m) <= (std::numeric_limits<double>::max)() && r <= (std::numeric_limits<double>::max)();
+}
+
+// c = a * b, where a = <ma, ra> (m x k) and b = <mb, rb> (k x n).
+// ra == NULL or rb == NULL means point matrix.
+inline void mult(int m, int n, int k, const double* ma, const double* ra, const double* mb, const double* rb, ub::matrix< interval<double> >& c) {
+	int i, j;
+	std::vector<double> p((std::size_t)2 * m * k), q, s, c1((std::size_t)2 * m * n), c2((std::size_t)m * n);
+	int k2;
+
+	// p = [ma; -ma]
+	for (i=0; i<m*k; i++) {
+		p[i] = ma[i];
+		p[m * k + i] = - ma[i];
+	}
+
+	// q = [|ma| ra], s = [rb; |mb| + rb]
+	// the part for ra or rb which is NULL is omitted
+	k2 = ((ra != NULL && rb != NULL) ? 2 : 1) * k;
+	q.resize((std::size_t)m * k2);
+	s.resize((std::size_t)k2 * n);
+
+	rop<double>::begin();
+	for (i=0; i<m; i++) {
+		for (j=0; j<k; j++) {
+			if (rb != NULL) {
+				q[i * k2 + j] = std::fabs(ma[i * k + j]);
+				if (ra != NULL) q[i * k2 + k + j] = ra[i * k + j];
+			} else {
+				q[i * k2 + j] = ra[i * k + j];
+			}
+		}
+	}
+	for (i=0; i<k; i++) {
+		for (j=0; j<n; j++) {
+			if (rb != NULL) {
+				s[i * n + j] = rb[i * n + j];
+				if (ra != NULL) s[(k + i) * n + j] = rop<double>::add_up(std::fabs(mb[i * n + j]), rb[i * n + j]);
+			} else {
+				s[i * n + j] = std::fabs(mb[i * n + j]);
+			}
+		}
+	}
+	rop<double>::end();
+
+	// c1 = [up(ma * mb); up(-ma * mb)]
+	gemm(2 * m, n, k, &p[0], k, mb, n, &c1[0], n, true);
+
+	// c2 = up(q * s)
+	gemm(m, n, k2, &q[0], k2, &s[0], n, &c2[0], n, true);
+
+	c.resize(m, n, false);
+	rop<double>::begin();
+	for (i=0; i<m; i++) {
+		for (j=0; j<n; j++) {
+			c(i, j).assign(
+				- rop<double>::add_up(c1[(m + i) * n + j], c2[i * n + j]),
+				rop<double>::add_up(c1[i * n + j], c2[i * n + j])
+			);
+		}
+	}
+	rop<double>::end();
+}
+
+// split interval matrix into midpoint and radius
+inline bool split(const ub::matrix< interval<double> >& a, std::vector<double>& m, std::vector<double>& r) {
+	int i, j;
+	int s1 = a.size1();
+	int s2 = a.size2();
+	bool ok = true;
+
+	m.resize((std::size_t)s1 * s2);
+	r.resize((std::size_t)s1 * s2);
+
+	rop<double>::begin();
+	for (i=0; i<s1; i++) {
+		for (j=0; j<s2; j++) {
+			if (!midrad_up(a(i, j), m[i * s2 + j], r[i * s2 + j])) {
+				ok = false;
+				break;
+			}
+		}
+		if (!ok) break;
+	}
+	rop<double>::end();
+
+	return ok;
+}
+
+inline bool use_gemm(int m, int n, int k) {
+	#ifdef KV_NOHWROUND
+	return false;
+	#else
+	return m >= INTERVAL_GEMM_MIN && n >= INTERVAL_GEMM_MIN && k >= INTERVAL_GEMM_MIN;
+	#endif
+}
+
+} // namespace interval_gemm_sub
+
+
+// generic versions for mixed products
+
+template <class T>
+void mm_mult(const ub::matrix<T>& a, const ub::matrix< interval<T> >& b, ub::matrix< interval<T> >& c) {
+	c = ub::prod(a, b);
+}
+
+template <class T>
+void mm_mult(const ub::matrix< interval<T> >& a, const ub::matrix<T>& b, ub::matrix< interval<T> >& c) {
+	c = ub::prod(a, b);
+}
+
+
+inline void mm_mult(const ub::matrix< interval<double> >& a, const ub::matrix< interval<double> >& b, ub::matrix< interval<double> >& c) {
+	int m = a.size1();
+	int k = a.size2();
+	int n = b.size2();
+	std::vector<double> ma, ra, mb, rb;
+
+	if (!interval_gemm_sub::use_gemm(m, n, k) || !interval_gemm_sub::split(a, ma, ra) || !interval_gemm_sub::split(b, mb, rb)) {
+		c = prod(a, b);
+		return;
+	}
+
+	interval_gemm_sub::mult(m, n, k, &ma[0], &ra[0], &mb[0], &rb[0], c);
+}
+
+inline void mm_mult(const ub::matrix<double>& a, const ub::matrix< interval<double> >& b, ub::matrix< interval<double> >& c) {
+	int m = a.size1();
+	int k = a.size2();
+	int n = b.size2();
+	std::vector<double> mb, rb;
+
+	if (!interval_gemm_sub::use_gemm(m, n, k) || !interval_gemm_sub::split(b, mb, rb)) {
+		c = prod(a, b);
+		return;
+	}
+
+	// ub::matrix<double> is stored in row major order
+	interval_gemm_sub::mult(m, n, k, &a.data()[0], NULL, &mb[0], &rb[0], c);
+}
+
+inline void mm_mult(const ub::matrix< interval<double> >& a, const ub::matrix<double>& b, ub::matrix< interval<double> >& c) {
+	int m = a.size1();
+	int k = a.size2();
+	int n = b.size2();
+	std::vector<double> ma, ra;
+
+	if (!interval_gemm_sub::use_gemm(m, n, k) || !interval_gemm_sub::split(a, ma, ra)) {
+		c = prod(a, b);
+		return;
+	}
+
+	interval_gemm_sub::mult(m, n, k, &ma[0], &ra[0], &b.data()[0], NULL, c);
+}
+
+} // namespace kv
+
+#endif // INTERVAL_GEMM_HPP
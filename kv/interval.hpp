@@ -1395,12 +1395,32 @@ template <class T> class interval {
 		return -cos_origin(pi - I);
 	}
 
+	// specialized implementation for each T can be given by
+	// specializing sin_special, cos_special and tan_special.
+	// they return false if the generic algorithm should be used.
+
+	static bool sin_special(const interval&, interval&) {
+		return false;
+	}
+
+	static bool cos_special(const interval&, interval&) {
+		return false;
+	}
+
+	static bool tan_special(const interval&, interval&) {
+		return false;
+	}
+
 	friend interval sin(const interval& I) {
+		interval r;
+
+		if (sin_special(I, r)) return r;
+
 		const interval pi = constants<interval>::pi();
 		const interval pi2 = pi * 2.;
 
 		T n;
-		interval r, I2;
+		interval I2;
 
 		using std::abs;
 		if (abs(I.lower()) == std::numeric_limits<T>::infinity()) {
@@ -1443,11 +1463,15 @@ template <class T> class interval {
 	}
 
 	friend interval cos(const interval& I) {
+		interval r;
+
+		if (cos_special(I, r)) return r;
+
 		const interval pi = constants<interval>::pi();
 		const interval pi2 = pi * 2.;
 
 		T n;
-		interval r, I2;
+		interval I2;
 
 		using std::abs;
 		if (abs(I.lower()) == std::numeric_limits<T>::infinity()) {
@@ -1498,6 +1522,10 @@ template <class T> class interval {
 	}
 
 	friend interval tan(const interval& I) {
+		interval r;
+
+		if (tan_special(I, r)) return r;
+
 		const interval pi = constants<interval>::pi();
 		const interval pih = pi * 0.5;
 
@@ -25,7 +25,7 @@ void jointrange(const affine<T>& x, const affine<T>& y, const matplotlib& g, con
 	ub::vector<T> vx, vy;
 	ub::matrix<int> signcache;
 
-	n = std::max(x.a.size(), y.a.size()) - 1;
+	n = std::max(x.get_maxindex(), y.get_maxindex());
 
 #if AFFINE_SIMPLE >= 1
 	vx.resize(n+3);
@@ -35,24 +35,16 @@ void jointrange(const affine<T>& x, const affine<T>& y, const matplotlib& g, con
 	vy.resize(n+1);
 #endif
 
-	for (i=0; i<x.a.size(); i++) {
-		vx(i) = x.a(i);
-	}
-	for (i=x.a.size(); i<=n; i++) {
-		vx(i) = 0.;
-	}
-	for (i=0; i<y.a.size(); i++) {
-		vy(i) = y.a(i);
-	}
-	for (i=y.a.size(); i<=n; i++) {
-		vy(i) = 0.;
+	for (i=0; i<=n; i++) {
+		vx(i) = x.get_coef(i);
+		vy(i) = y.get_coef(i);
 	}
 
 #if AFFINE_SIMPLE >= 1
-	vx(n+1) = x.er;
+	vx(n+1) = x.get_err();
 	vy(n+1) = 0.;
 	vx(n+2) = 0.;
-	vy(n+2) = y.er;
+	vy(n+2) = y.get_err();
 	n += 2;
 #endif
 
@@ -11,6 +11,15 @@
 
 #include <kv/interval.hpp>
 #include <kv/autodif.hpp>
+#include <kv/autodif-reverse.hpp>
+
+// 0: calculate the gradient of the objective function by autodif
+// 1: calculate it by autodif_reverse (reverse mode)
+
+#ifndef KKT_REVERSE
+#define KKT_REVERSE 0
+#endif
+
 
 namespace kv {
 
@@ -176,7 +185,11 @@ struct KKT_equation {
 		xx.resize(sf);
 		for (i=0; i<sf; i++) xx(i) = x(i);
 
+#if KKT_REVERSE == 1
+		autodif_reverse<T>::split(f(autodif_reverse<T>::init(xx)), dummy, fv);
+#else
 		autodif<T>::split(f(autodif<T>::init(xx)), dummy, fv);
+#endif
 
 		autodif<T>::split(g(autodif<T>::init(xx)), gv, gm);
 		sg = gv.size();
@@ -15,6 +15,7 @@
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
+#include <kv/interval-dot.hpp>
 #include <kv/autodif.hpp>
 #include <kv/matrix-inversion.hpp>
 #include <kv/make-candidate.hpp>
@@ -48,7 +49,7 @@ krawczyk_approx(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result,
 	for (i=0; i<newton_max; i++) {
 		C = c2;
 		try {
-			autodif< interval<T> >::split(f(autodif< interval<T> >::init(C)), fc, fdc);
+			autodif_eval<F>::split(f, C, fc, fdc);
 		}
 		catch (std::domain_error& e) {
 			return false;
@@ -75,7 +76,7 @@ krawczyk_approx(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result,
 
 	C = c2;
 	try {
-		autodif< interval<T> >::split(f(autodif< interval<T> >::init(C)), fc, fdc);
+		autodif_eval<F>::split(f, C, fc, fdc);
 	}
 	catch (std::domain_error& e) {
 		return false;
@@ -105,7 +106,7 @@ krawczyk_approx(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result,
 	}
 
 	try {
-		autodif< interval<T> >::split(f(autodif< interval<T> >::init(I)), fi, fdi);
+		autodif_eval<F>::split(f, I, fi, fdi);
 	}
 	catch (std::domain_error& e) {
 		return false;
@@ -7,13 +7,22 @@
 
 #include <stdexcept>
 #include <list>
+#include <vector>
 #include <limits>
+#include <algorithm>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 
 
+// number of pivots between refactorizations of the basis in lp_solver
+
+#ifndef LP_REFACTOR
+#define LP_REFACTOR 50
+#endif
+
+
 namespace kv {
 
 namespace ub = boost::numeric::ublas;
@@ -262,6 +271,378 @@ template <class T> inline T lp_minimize_verified(ub::vector<T>& objfunc, std::li
 	return a(0, 0);
 }
 
+/*
+ * revised simplex method with warm start
+ *
+ *   kv::lp_solver<double> lp;
+ *   lp.set_constraints(constraints);
+ *   r1 = lp.minimize(objfunc1);          // approximate minimum
+ *   r2 = lp.minimize_verified(objfunc2); // lower bound of minimum
+ *
+ * the problem is the same as lp_minimize:
+ *   minimize objfunc(0) + sum objfunc(j) x_j
+ *   subject to c(0) + sum c(j) x_j <= 0 for each c in constraints,
+ *              x_j >= 0,
+ *   c(0) <= 0 (x = 0 is feasible).
+ * the constraint matrix is stored by sparse columns. the inverse of
+ * the basis matrix is kept and updated at each pivot (recomputed every
+ * LP_REFACTOR pivots). each solve starts from the last optimal basis:
+ * it is still feasible for a new objective with the same constraints,
+ * and it is used for new constraints of the same size if it is
+ * feasible for them.
+ *
+ * minimize_verified checks the approximate dual y >= 0 by the weak
+ * duality in interval arithmetic:
+ *   min >= objfunc(0) - b^T y + sum_j min(0, r_j) xbar_j,
+ *   r = objfunc(1..n) + A^T y, b = -c(0),
+ * where xbar_j is an upper bound of x_j obtained from the constraints
+ * with nonnegative coefficients. if xbar_j is needed but not available,
+ * lp_minimize_verified(objfunc, constraints, -1) is used instead.
+ */
+
+template <class T> class lp_solver {
+	int m, n;
+	std::list< ub::vector<T> > rows;
+	bool changed;
+
+	// A (m x n) by columns, b = -c(0)
+	std::vector<int> cstart, crow;
+	std::vector<T> cval, b, xbar;
+	std::vector<bool> bounded;
+
+	// basis: basic(i) in [0, n+m), n+i is the slack of row i
+	std::vector<int> basic, pos;
+	std::vector<T> binv; // m x m, row major
+	std::vector<T> xb, cost, pi, u;
+	bool has_basis;
+	int eta_count;
+
+	void setup(int n1) {
+		int i, j, k;
+		typename std::list< ub::vector<T> >::iterator p;
+		interval<T> tmp;
+		bool nonneg;
+
+		n = n1;
+		cstart.assign(n + 1, 0);
+		crow.clear();
+		cval.clear();
+		b.resize(m);
+		xbar.assign(n, T(0.));
+		bounded.assign(n, false);
+
+		for (j=0; j<n; j++) {
+			cstart[j] = crow.size();
+			p = rows.begin();
+			for (i=0; i<m; i++, p++) {
+				if (j + 1 < (int)(*p).size() && (*p)(j + 1) != 0.) {
+					crow.push_back(i);
+					cval.push_back((*p)(j + 1));
+				}
+			}
+		}
+		cstart[n] = crow.size();
+
+		p = rows.begin();
+		for (i=0; i<m; i++, p++) {
+			b[i] = -(*p)(0);
+
+			// upper bounds of x_j from the rows with nonnegative
+			// coefficients: x_j <= b_i / a_ij
+			nonneg = true;
+			for (j=1; j<(int)(*p).size() && j<=n; j++) {
+				if ((*p)(j) < 0.) {
+					nonneg = false;
+					break;
+				}
+			}
+			if (!nonneg) continue;
+			for (j=1; j<(int)(*p).size() && j<=n; j++) {
+				if ((*p)(j) == 0.) continue;
+				tmp = interval<T>(b[i]) / (*p)(j);
+				k = j - 1;
+				if (!bounded[k] || tmp.upper() < xbar[k]) {
+					xbar[k] = tmp.upper();
+					bounded[k] = true;
+				}
+			}
+		}
+
+		if ((int)basic.size() != m) has_basis = false;
+		for (i=0; i<(int)basic.size(); i++) {
+			if (basic[i] >= n + m) has_basis = false;
+		}
+		changed = false;
+	}
+
+	// u = column k of [A I]
+	void column(int k, std::vector<T>& v) {
+		int i;
+
+		for (i=0; i<m; i++) v[i] = 0.;
+		if (k >= n) {
+			v[k - n] = 1.;
+		} else {
+			for (i=cstart[k]; i<cstart[k+1]; i++) v[crow[i]] = cval[i];
+		}
+	}
+
+	// pi^T a_k
+	T dot_column(int k) {
+		int i;
+		T r;
+
+		if (k >= n) return pi[k - n];
+		r = 0.;
+		for (i=cstart[k]; i<cstart[k+1]; i++) r += pi[crow[i]] * cval[i];
+		return r;
+	}
+
+	void slack_basis() {
+		int i;
+
+		basic.resize(m);
+		pos.assign(n + m, -1);
+		binv.assign(m * m, T(0.));
+		xb.resize(m);
+		for (i=0; i<m; i++) {
+			binv[i * m + i] = 1.;
+			basic[i] = n + i;
+			pos[n + i] = i;
+			xb[i] = b[i];
+		}
+		eta_count = 0;
+		has_basis = true;
+	}
+
+	// binv = B^-1 by Gauss-Jordan, xb = B^-1 b.
+	// return false if B is singular or the basis is not feasible
+	bool factorize() {
+		int i, j, k, p;
+		T tmp, mx;
+		ub::matrix<T> a(m, m);
+		std::vector<T> v(m);
+
+		using std::abs;
+
+		for (j=0; j<m; j++) {
+			column(basic[j], v);
+			for (i=0; i<m; i++) a(i, j) = v[i];
+		}
+		binv.assign(m * m, T(0.));
+		for (i=0; i<m; i++) binv[i * m + i] = 1.;
+
+		for (k=0; k<m; k++) {
+			p = k;
+			mx = 0.;
+			for (i=k; i<m; i++) {
+				tmp = abs(a(i, k));
+				if (tmp > mx) {
+					mx = tmp;
+					p = i;
+				}
+			}
+			if (mx <= std::numeric_limits<T>::epsilon()) return false;
+			if (p != k) {
+				for (j=0; j<m; j++) {
+					std::swap(a(k, j), a(p, j));
+					std::swap(binv[k * m + j], binv[p * m + j]);
+				}
+			}
+			tmp = a(k, k);
+			for (j=0; j<m; j++) {
+				a(k, j) /= tmp;
+				binv[k * m + j] /= tmp;
+			}
+			for (i=0; i<m; i++) {
+				if (i == k) continue;
+				tmp = a(i, k);
+				if (tmp == 0.) continue;
+				for (j=0; j<m; j++) {
+					a(i, j) -= a(k, j) * tmp;
+					binv[i * m + j] -= binv[k * m + j] * tmp;
+				}
+			}
+		}
+
+		xb.resize(m);
+		for (i=0; i<m; i++) {
+			tmp = 0.;
+			for (j=0; j<m; j++) tmp += binv[i * m + j] * b[j];
+			if (tmp < -tolerance() * (1. + b[i])) return false;
+			xb[i] = tmp;
+		}
+		pos.assign(n + m, -1);
+		for (i=0; i<m; i++) pos[basic[i]] = i;
+		eta_count = 0;
+		return true;
+	}
+
+	static T tolerance() {
+		return std::numeric_limits<T>::epsilon() * 1024.;
+	}
+
+	public:
+
+	// number of pivots of the last solve
+	int pivots;
+
+	lp_solver() : m(0), n(-1), changed(true), has_basis(false), eta_count(0), pivots(0) {}
+
+	void set_constraints(const std::list< ub::vector<T> >& constraints) {
+		typename std::list< ub::vector<T> >::const_iterator p;
+
+		for (p=constraints.begin(); p!=constraints.end(); p++) {
+			if ((*p)(0) > 0) {
+				throw std::domain_error("lp_minimize: constraints sign error");
+			}
+		}
+		rows = constraints;
+		m = rows.size();
+		changed = true;
+	}
+
+	T minimize(const ub::vector<T>& objfunc) {
+		int i, j, k, q, r, limit;
+		T tmp, best, d, theta;
+		bool bland;
+
+		using std::abs;
+
+		if (changed || (int)objfunc.size() - 1 != n) {
+			setup(objfunc.size() - 1);
+			if (!has_basis || !factorize()) slack_basis();
+		}
+
+		cost.assign(n + m, T(0.));
+		for (j=0; j<n; j++) cost[j] = objfunc(j + 1);
+		pi.resize(m);
+		u.resize(m);
+
+		pivots = 0;
+		bland = false;
+		limit = 10 * (n + m);
+		while (true) {
+			if (eta_count >= LP_REFACTOR && !factorize()) {
+				slack_basis();
+			}
+
+			// pi^T = c_B^T B^-1
+			for (j=0; j<m; j++) pi[j] = 0.;
+			for (i=0; i<m; i++) {
+				tmp = cost[basic[i]];
+				if (tmp == 0.) continue;
+				for (j=0; j<m; j++) pi[j] += tmp * binv[i * m + j];
+			}
+
+			// pricing (Dantzig, Bland after many pivots)
+			q = -1;
+			best = 0.;
+			for (k=0; k<n+m; k++) {
+				if (pos[k] >= 0) continue;
+				d = cost[k] - dot_column(k);
+				if (d >= -tolerance() * (1. + abs(cost[k]))) continue;
+				if (bland) {
+					q = k;
+					break;
+				}
+				if (d < best) {
+					best = d;
+					q = k;
+				}
+			}
+			if (q == -1) break;
+
+			// u = B^-1 a_q
+			if (q >= n) {
+				for (i=0; i<m; i++) u[i] = binv[i * m + q - n];
+			} else {
+				for (i=0; i<m; i++) {
+					tmp = 0.;
+					for (k=cstart[q]; k<cstart[q+1]; k++) tmp += binv[i * m + crow[k]] * cval[k];
+					u[i] = tmp;
+				}
+			}
+
+			// ratio test
+			r = -1;
+			best = std::numeric_limits<T>::max();
+			for (i=0; i<m; i++) {
+				if (u[i] <= tolerance()) continue;
+				tmp = std::max(xb[i], T(0.)) / u[i];
+				if (tmp < best || (bland && r >= 0 && tmp == best && basic[i] < basic[r])) {
+					best = tmp;
+					r = i;
+				}
+			}
+			if (r == -1) {
+				throw std::domain_error("lp_minimize: no optimal solution");
+			}
+
+			// pivot
+			theta = best;
+			for (i=0; i<m; i++) {
+				if (i == r) continue;
+				xb[i] -= theta * u[i];
+			}
+			xb[r] = theta;
+			tmp = u[r];
+			for (j=0; j<m; j++) binv[r * m + j] /= tmp;
+			for (i=0; i<m; i++) {
+				if (i == r || u[i] == 0.) continue;
+				tmp = u[i];
+				for (j=0; j<m; j++) binv[i * m + j] -= binv[r * m + j] * tmp;
+			}
+			pos[basic[r]] = -1;
+			basic[r] = q;
+			pos[q] = r;
+			eta_count++;
+
+			pivots++;
+			if (pivots > limit) {
+				if (bland) throw std::domain_error("lp_minimize: too many pivots");
+				bland = true;
+				limit *= 2;
+			}
+		}
+
+		tmp = objfunc(0);
+		for (i=0; i<m; i++) tmp += cost[basic[i]] * xb[i];
+		return tmp;
+	}
+
+	T minimize_verified(const ub::vector<T>& objfunc) {
+		int i, j, k;
+		interval<T> lb, rj;
+		std::vector<T> y(m);
+		ub::vector<T> obj;
+
+		minimize(objfunc);
+
+		// y = -pi >= 0 is an approximate solution of the dual
+		for (i=0; i<m; i++) y[i] = std::max(-pi[i], T(0.));
+
+		lb = objfunc(0);
+		for (i=0; i<m; i++) {
+			if (y[i] != 0.) lb -= interval<T>(b[i]) * y[i];
+		}
+		for (j=0; j<n; j++) {
+			rj = objfunc(j + 1);
+			for (k=cstart[j]; k<cstart[j+1]; k++) {
+				if (y[crow[k]] != 0.) rj += interval<T>(cval[k]) * y[crow[k]];
+			}
+			if (rj.lower() >= 0.) continue;
+			if (!bounded[j]) {
+				obj = objfunc;
+				return lp_minimize_verified(obj, rows, -1);
+			}
+			lb += interval<T>(rj.lower()) * xbar[j];
+		}
+
+		return lb.lower();
+	}
+};
+
 } // namespace kv
 
 #endif // LP_HPP
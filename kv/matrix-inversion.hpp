@@ -22,6 +22,19 @@
 #endif
 
 
+#include <vector>
+#include <cmath>
+#include <kv/gemm.hpp>
+
+
+// invert<double> uses the Gauss-Jordan elimination in this file
+// instead of ublas' LU decomposition if the size is not smaller than this
+
+#ifndef INVERT_NATIVE_MIN
+#define INVERT_NATIVE_MIN 32
+#endif
+
+
 #ifdef USE_LAPACK
 #include <boost/numeric/bindings/traits/ublas_matrix.hpp>
 #include <boost/numeric/bindings/lapack/gesv.hpp>
@@ -61,6 +74,69 @@ bool invert(const ub::matrix<T>& a, ub::matrix<T>& b) {
 	return true;
 }
 
+// Gauss-Jordan elimination with partial pivoting.
+// elimination of rows is done in parallel.
+
+inline bool invert_gauss_jordan(const ub::matrix<double>& a, ub::matrix<double>& b) {
+	int n = a.size1();
+	int n2 = 2 * n;
+	int i, j, p, mi;
+	double tmp, m;
+	std::vector<double> w((std::size_t)n * n2);
+
+	// w = [a | I]
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			w[i * n2 + j] = a(i, j);
+			w[i * n2 + n + j] = (i == j) ? 1. : 0.;
+		}
+	}
+
+	for (p=0; p<n; p++) {
+		mi = p;
+		m = std::fabs(w[p * n2 + p]);
+		for (i=p+1; i<n; i++) {
+			tmp = std::fabs(w[i * n2 + p]);
+			if (tmp > m) {
+				m = tmp; mi = i;
+			}
+		}
+		if (m == 0.) return false;
+		if (mi != p) {
+			for (j=p; j<n2; j++) std::swap(w[p * n2 + j], w[mi * n2 + j]);
+		}
+
+		tmp = 1. / w[p * n2 + p];
+		for (j=p; j<n2; j++) w[p * n2 + j] *= tmp;
+
+		#ifdef _OPENMP
+		#pragma omp parallel for if ((double)n * n >= GEMM_PARALLEL_MIN)
+		#endif
+		for (i=0; i<n; i++) {
+			int j;
+			double f;
+			double* wi;
+			const double* wp;
+
+			if (i == p) continue;
+			wi = &w[i * n2];
+			wp = &w[p * n2];
+			f = wi[p];
+			if (f == 0.) continue;
+			for (j=p; j<n2; j++) wi[j] -= f * wp[j];
+		}
+	}
+
+	b.resize(n, n);
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			b(i, j) = w[i * n2 + n + j];
+		}
+	}
+
+	return true;
+}
+
 // special version for double
 #if defined(USE_LAPACK) || defined(USE_ATLAS)
 template <>
@@ -81,6 +157,29 @@ inline bool invert(const ub::matrix<double>& a, ub::matrix<double>& b) {
 
 	return true;
 }
+#else // defined(USE_LAPACK) || defined(USE_ATLAS)
+template <>
+inline bool invert(const ub::matrix<double>& a, ub::matrix<double>& b) {
+	if ((int)a.size1() >= INVERT_NATIVE_MIN) {
+		return invert_gauss_jordan(a, b);
+	}
+
+	ub::matrix<double> tmp(a);
+	ub::permutation_matrix<> pm(tmp.size1());
+
+	if (ub::lu_factorize(tmp, pm) != 0) return false;
+
+	b = ub::identity_matrix<double>(tmp.size1());
+
+	try {
+		ub::lu_substitute(tmp, pm, b);
+	}
+	catch (...) {
+		return false;
+	}
+
+	return true;
+}
 #endif // defined(USE_LAPACK) || defined(USE_ATLAS)
 
 
@@ -147,6 +246,24 @@ inline void mm_mult(const ub::matrix<double>& a, const ub::matrix<double>& b, ub
 
 	c = cc;
 }
+#else // defined(USE_LAPACK) || defined(USE_ATLAS)
+template <>
+inline void mm_mult(const ub::matrix<double>& a, const ub::matrix<double>& b, ub::matrix<double>& c) {
+	int m = a.size1();
+	int k = a.size2();
+	int n = b.size2();
+	ub::matrix<double> r(m, n);
+
+	if (m == 0 || n == 0 || k == 0) {
+		c = ub::zero_matrix<double>(m, n);
+		return;
+	}
+
+	// ub::matrix<double> is stored in row major order
+	gemm(m, n, k, &a.data()[0], k, &b.data()[0], n, &r.data()[0], n);
+
+	c.swap(r);
+}
 #endif // defined(USE_LAPACK) || defined(USE_ATLAS)
 
 } // namespace kv
@@ -8,12 +8,85 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
 #include <kv/convert.hpp>
 #include <kv/constants.hpp>
 #include <mpfr.h>
 
+/*
+ * if MPFR_POOL == 1, mpfr<N> takes its mpfr_t from a per-thread free
+ * list of initialized mpfr_t of precision N instead of mpfr_init2 and
+ * returns it to the list instead of mpfr_clear, so that the temporaries
+ * do not allocate and free the limbs.
+ * at most MPFR_POOL_MAX mpfr_t are kept for each thread and N.
+ * the destructors of threadprivate objects are not called for the
+ * worker threads of OpenMP, so the lists of the workers are not freed
+ * (at most MPFR_POOL_MAX mpfr_t per worker and N, which are reused by
+ * the later parallel regions) until the process exits.
+ */
+
+#ifndef MPFR_POOL
+#define MPFR_POOL 1
+#endif
+
+#ifndef MPFR_POOL_MAX
+#define MPFR_POOL_MAX 256
+#endif
+
 namespace kv {
 
+template <int N> struct mpfr_pool {
+	std::vector<__mpfr_struct> v;
+
+	~mpfr_pool() {
+		std::size_t i;
+		for (i=0; i<v.size(); i++) mpfr_clear(&v[i]);
+		alive() = false;
+	}
+
+	// false after the list of this thread is destroyed
+	// (mpfr<N> with static storage are destroyed after that)
+	static bool& alive() {
+		static bool a = true;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(a)
+		#endif
+		return a;
+	}
+
+	static mpfr_pool& get() {
+		static mpfr_pool p;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(p)
+		#endif
+		return p;
+	}
+
+	// an mpfr_t is moved by copying the struct (the limbs are not copied)
+	static void init(mpfr_ptr x) {
+		if (alive()) {
+			mpfr_pool& p = get();
+			if (!p.v.empty()) {
+				*x = p.v.back();
+				p.v.pop_back();
+				return;
+			}
+		}
+		mpfr_init2(x, N);
+	}
+
+	static void clear(mpfr_ptr x) {
+		if (alive()) {
+			mpfr_pool& p = get();
+			if (p.v.size() < MPFR_POOL_MAX) {
+				p.v.push_back(*x);
+				return;
+			}
+		}
+		mpfr_clear(x);
+	}
+};
+
 template <int N> class mpfr;
 
 template <class C, int N> struct convertible<C, mpfr<N> > {
@@ -27,32 +100,54 @@ template <class C, int N> struct acceptable_s<C, mpfr<N> > {
 };
 
 template <int N = 53> class mpfr {
+	static void init(mpfr_ptr x) {
+		#if MPFR_POOL == 1
+		mpfr_pool<N>::init(x);
+		#else
+		mpfr_init2(x, N);
+		#endif
+	}
+
+	static void clear(mpfr_ptr x) {
+		#if MPFR_POOL == 1
+		mpfr_pool<N>::clear(x);
+		#else
+		mpfr_clear(x);
+		#endif
+	}
+
 	public:
 	mpfr_t a;
 
 	mpfr () {
-		mpfr_init2(a, N);
+		init(a);
 		mpfr_set_si(a, 0, MPFR_RNDN);
 	}
 
 	// copy constructor is needed
 	mpfr (const mpfr& x) {
-		mpfr_init2(a, N);
+		init(a);
 		mpfr_set(a, x.a, MPFR_RNDN);
 	}
 
+	// the temporaries are moved by swapping the limbs
+	mpfr (mpfr&& x) {
+		init(a);
+		mpfr_swap(a, x.a);
+	}
+
 	template <class C> explicit mpfr(const C& x, typename boost::enable_if_c< acceptable_n<C, mpfr>::value >::type* =0) {
-		mpfr_init2(a, N);
+		init(a);
 		mpfr_set_d(a, (double)x, MPFR_RNDN);
 	}
 
 	template <class C> explicit mpfr(const C& x, typename boost::enable_if_c< acceptable_s<C, mpfr>::value >::type* =0) {
-		mpfr_init2(a, N);
+		init(a);
 		mpfr_set_str(a, std::string(x).c_str(), 10, MPFR_RNDN);
 	}
 
 	~mpfr () {
-		mpfr_clear(a);
+		clear(a);
 	}
 
 	// assignment operator must be overloaded
@@ -61,6 +156,11 @@ template <int N = 53> class mpfr {
 		return *this;
 	}
 
+	mpfr& operator=(mpfr&& x) {
+		mpfr_swap(a, x.a);
+		return *this;
+	}
+
 	template <class C> typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator=(const C& x) {
 		mpfr_set_d(a, (double)x, MPFR_RNDN);
 		return *this;
@@ -98,12 +198,12 @@ template <int N = 53> class mpfr {
 	}
 
 	friend mpfr& operator+=(mpfr& x, const mpfr& y) {
-		x = x + y;
+		mpfr_add(x.a, x.a, y.a, MPFR_RNDN);
 		return x;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator+=(mpfr& x, const C& y) {
-		x = x + y;
+		mpfr_add_d(x.a, x.a, (double)y, MPFR_RNDN);
 		return x;
 	}
 
@@ -139,12 +239,12 @@ template <int N = 53> class mpfr {
 	}
 
 	friend mpfr& operator-=(mpfr& x, const mpfr& y) {
-		x = x - y;
+		mpfr_sub(x.a, x.a, y.a, MPFR_RNDN);
 		return x;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator-=(mpfr& x, const C& y) {
-		x = x - y;
+		mpfr_sub_d(x.a, x.a, (double)y, MPFR_RNDN);
 		return x;
 	}
 
@@ -188,12 +288,12 @@ template <int N = 53> class mpfr {
 	}
 
 	friend mpfr& operator*=(mpfr& x, const mpfr& y) {
-		x = x * y;
+		mpfr_mul(x.a, x.a, y.a, MPFR_RNDN);
 		return x;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator*=(mpfr& x, const C& y) {
-		x = x * y;
+		mpfr_mul_d(x.a, x.a, (double)y, MPFR_RNDN);
 		return x;
 	}
 
@@ -229,12 +329,12 @@ template <int N = 53> class mpfr {
 	}
 
 	friend mpfr& operator/=(mpfr& x, const mpfr& y) {
-		x = x / y;
+		mpfr_div(x.a, x.a, y.a, MPFR_RNDN);
 		return x;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator/=(mpfr& x, const C& y) {
-		x = x / y;
+		mpfr_div_d(x.a, x.a, (double)y, MPFR_RNDN);
 		return x;
 	}
 
@@ -243,6 +343,15 @@ template <int N = 53> class mpfr {
 		return x;
 	}
 
+	// x * y + z with one rounding
+	friend mpfr fma(const mpfr& x, const mpfr& y, const mpfr& z) {
+		mpfr r;
+
+		mpfr_fma(r.a, x.a, y.a, z.a, MPFR_RNDN);
+
+		return r;
+	}
+
 	friend mpfr sqrt(const mpfr& x) {
 		mpfr r;
 
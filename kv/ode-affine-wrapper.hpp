@@ -51,7 +51,7 @@ ode_wrapper(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 
 	new_init.resize(n);
 	for (i=0; i<n; i++) {
-		new_init(i) = init(i).a(0) + (affine<T>)(init_rad(i) * interval<T>(-1.,1));
+		new_init(i) = init(i).get_mid() + (affine<T>)(init_rad(i) * interval<T>(-1.,1));
 	}
 
 	// ep_reduce must be 0
@@ -71,8 +71,8 @@ ode_wrapper(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 
 	for (i=0; i<n; i++) {
 		split(result(i), n, s1, s2);
-		result_c(i) = s1.a(0);
-		for (j=0; j<n; j++) result_m(i, j) = s1.a(j+1);
+		result_c(i) = s1.get_mid();
+		for (j=0; j<n; j++) result_m(i, j) = s1.get_coef(j+1);
 		result_i(i) = to_interval(s2);
 	}
 
@@ -80,7 +80,7 @@ ode_wrapper(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 
 	result2 = init;
 	for (i=0; i<n; i++) {
-		result2(i).a(0) = 0.;
+		result2(i).set_mid(0.);
 		if (init_rad(i) != 0.) result2(i) /= init_rad(i);
 	}
 	result2 = prod(result_m, result2) + result_c;
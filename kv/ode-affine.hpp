@@ -92,6 +92,8 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 	}
 	tolerance = m * p.epsilon;
 
+	stats_timer timer(p.stats, "ode_taylor");
+
 	x = init;
 	torg.v.resize(2);
 	torg.v(0) = start; torg.v(1) = 1.;
@@ -140,6 +142,8 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 		radius = std::pow((double)tolerance, 1./p.order) / radius;
 	}
 
+	timer.lap("ode_verify");
+
 	psa< affine<T> >::mode() = 2;
 
 	restart = 0;
@@ -183,11 +187,13 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 					std::cout << " -> " << radius << "\n";
 				}
 				restart++;
+				if (p.stats != NULL) p.stats->add("ode_restarts");
 				continue;
 			} else {
 				throw std::domain_error("ode_affine: evaluation error");
 			}
 		}
+		if (p.stats != NULL) p.stats->add("ode_picard");
 
 		for (i=0; i<n; i++) {
 			temp = integrate(w(i));
@@ -231,11 +237,13 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 				// do nothing, not continue
 			} else {
 				radius = radius_tmp;
+				if (p.stats != NULL) p.stats->add("ode_resized");
 				continue;
 			}
 		}
 
 		w = f(z, t);
+		if (p.stats != NULL) p.stats->add("ode_picard");
 		for (i=0; i<n; i++) {
 			temp = integrate(w(i));
 			w(i) = setorder(temp, p.order);
@@ -285,8 +293,22 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 			std::cout << " -> " << radius << "\n";
 		}
 		restart++;
+		if (p.stats != NULL) p.stats->add("ode_rejected");
 	}
 
+	if (p.stats != NULL) {
+		if (ret_val == 0) {
+			p.stats->add("ode_failures");
+		} else {
+			p.stats->add("ode_steps");
+			p.stats->add("ode_picard", p.iteration);
+			p.stats->record("ode_step_size", (double)deltat.upper());
+			p.stats->record("ode_order", p.order);
+		}
+	}
+
+	timer.lap("ode_refine");
+
 	if (ret_val != 0) {
 		for (j=0; j<p.iteration; j++) {
 			w = f(w, t);
@@ -345,6 +367,7 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 		} else {
 			epsilon_reduce(result, p.ep_reduce, p.ep_reduce_limit);
 		}
+		if (p.stats != NULL) p.stats->record("ode_noise_symbols", affine<T>::maxnum());
 
 		init = result;
 		if (ret_val == 1) end = end2;
@@ -62,7 +62,7 @@ template <class F, class T> struct MakeVariationalEq {
 		}
 		t2 = setorder(t, order);
 
-		autodif< psa<T> >::split(f(autodif< psa<T> >::init(solution2), autodif< psa<T> >(t2)), rv, rm);
+		autodif_eval<F>::split(f, solution2, t2, rv, rm);
 
 		rm = prod(rm, x2);
 
@@ -121,7 +121,9 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 
 	p2.set_autostep(true);
 	p2.set_epsilon(std::numeric_limits<T>::infinity());
+	p2.set_stats(NULL); // not counted as steps
 
+	stats_timer timer(p.stats, "ode_variational");
 	r = ode(g, fdI_tmp, start, end2, p2);
 	if (r == 0) return 0;
 	if (r == 1) {
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ODE_ENSEMBLE_HPP
+#define ODE_ENSEMBLE_HPP
+
+// verified integration of many initial sets (ensemble)
+//
+// ode_ensemble(f, init, start, end, result, hull, p, ep)
+//   init: list of initial boxes (or affine sets)
+//   result: list of ode_ensemble_result (one for each piece)
+//   hull: interval hull of the solutions at end of all the pieces
+//         which reached end
+//   return value: 1 if all the pieces reached end, 0 otherwise
+//
+// each piece is integrated by odelong_maffine (or odelong_lohner).
+// a piece which does not reach end (or whose solution is wider than
+// ep.max_width) is bisected along its widest component and both
+// halves are integrated again, up to ep.max_depth times.
+// compiled with OpenMP, each piece is processed as a task, so the
+// pieces whose computational times differ much are balanced by
+// the OpenMP runtime. the results are sorted so that they do not
+// depend on the scheduling of threads.
+
+#include <iostream>
+#include <list>
+#include <limits>
+#include <stdexcept>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-vector.hpp>
+#include <kv/affine.hpp>
+#include <kv/ode-param.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-lohner.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+// method
+//   0: odelong_maffine
+//   1: odelong_lohner (affine initial sets are converted to boxes)
+// max_depth
+//   maximum number of bisections of each initial piece
+// max_width
+//   bisect the piece if the width of the solution at end is larger
+//   than this (0 means no limit)
+
+template <class T> struct ode_ensemble_param {
+	int method;
+	int max_depth;
+	T max_width;
+	int verbose;
+
+	ode_ensemble_param() :
+		method(0),
+		max_depth(4),
+		max_width(0.),
+		verbose(0)
+	{}
+
+	ode_ensemble_param& set_method(int x) {
+		method = x;
+		return *this;
+	}
+	ode_ensemble_param& set_max_depth(int x) {
+		max_depth = x;
+		return *this;
+	}
+	ode_ensemble_param& set_max_width(T x) {
+		max_width = x;
+		return *this;
+	}
+	ode_ensemble_param& set_verbose(int x) {
+		verbose = x;
+		return *this;
+	}
+};
+
+
+template <class T> struct ode_ensemble_result {
+	int index; // number of initial piece in the input list
+	int depth; // number of bisections
+	ub::vector< interval<T> > init; // initial box of this piece
+	ub::vector< interval<T> > x; // solution at end
+	interval<T> end; // time which the solution reached
+	int ret; // return value of odelong_*
+};
+
+
+namespace ode_ensemble_sub {
+
+template <class T> struct piece {
+	int index;
+	int depth;
+	ub::vector< interval<T> > box;
+	ub::vector< affine<T> > aff; // affine initial set if size() != 0
+};
+
+// order of results: index, then lexicographic order of init
+template <class T> struct result_less {
+	bool operator() (const ode_ensemble_result<T>& a, const ode_ensemble_result<T>& b) const {
+		int i;
+		if (a.index != b.index) return a.index < b.index;
+		for (i=0; i<(int)a.init.size(); i++) {
+			if (a.init(i).lower() < b.init(i).lower()) return true;
+			if (a.init(i).lower() > b.init(i).lower()) return false;
+		}
+		return false;
+	}
+};
+
+template <class T, class F> struct ensemble_worker {
+	F f;
+	interval<T> start, end;
+	ode_param<T> p;
+	ode_ensemble_param<T> ep;
+	int maxnum; // maxnum of affine in the caller
+	std::list< ode_ensemble_result<T> > result;
+
+	ensemble_worker(F f, const interval<T>& start, const interval<T>& end, const ode_param<T>& p, const ode_ensemble_param<T>& ep) : f(f), start(start), end(end), p(p), ep(ep) {
+		maxnum = affine<T>::maxnum();
+	}
+
+	// integrate one piece. the halves are appended to next if the
+	// piece is bisected.
+	void process(const piece<T>& P, std::list< piece<T> >& next) {
+		ode_ensemble_result<T> r;
+		ub::vector< affine<T> > a;
+		ub::vector< interval<T> > x;
+		interval<T> t = end;
+		int ret;
+		int i, im;
+		bool ok;
+		T w, wm;
+
+		if (P.aff.size() != 0) {
+			r.init = to_interval(P.aff);
+		} else {
+			r.init = P.box;
+		}
+
+		try {
+			if (P.aff.size() != 0 && ep.method == 0) {
+				// noise symbols of the initial set are shared with
+				// the caller
+				affine<T>::maxnum() = maxnum;
+				a = P.aff;
+				ret = odelong_maffine(f, a, start, t, p);
+				x = to_interval(a);
+			} else {
+				x = r.init;
+				if (ep.method == 0) {
+					ret = odelong_maffine(f, x, start, t, p);
+				} else {
+					ret = odelong_lohner(f, x, start, t, p);
+				}
+			}
+		}
+		catch (std::domain_error& e) {
+			ret = 0;
+		}
+
+		ok = (ret == 2);
+		if (ok && ep.max_width > 0.) {
+			for (i=0; i<(int)x.size(); i++) {
+				if (width(x(i)) > ep.max_width) {
+					ok = false;
+					break;
+				}
+			}
+		}
+
+		if (!ok && P.depth < ep.max_depth) {
+			// bisect the widest component
+			im = 0;
+			wm = width(r.init(0));
+			for (i=1; i<(int)r.init.size(); i++) {
+				w = width(r.init(i));
+				if (w > wm) {
+					wm = w;
+					im = i;
+				}
+			}
+			piece<T> Q;
+			Q.index = P.index;
+			Q.depth = P.depth + 1;
+			Q.box = r.init;
+			Q.box(im) = interval<T>(r.init(im).lower(), mid(r.init(im)));
+			next.push_back(Q);
+			Q.box(im) = interval<T>(mid(r.init(im)), r.init(im).upper());
+			next.push_back(Q);
+			if (ep.verbose >= 1) {
+				#ifdef _OPENMP
+				#pragma omp critical (cout)
+				#endif
+				{
+				std::cout << "ode_ensemble: piece " << P.index << " (depth " << P.depth << ") reached " << t << ", bisected\n";
+				}
+			}
+			return;
+		}
+
+		r.index = P.index;
+		r.depth = P.depth;
+		r.x = x;
+		r.end = t;
+		r.ret = ret;
+
+		#ifdef _OPENMP
+		#pragma omp critical (ode_ensemble_result)
+		#endif
+		{
+		result.push_back(r);
+		}
+	}
+
+	void run(std::list< piece<T> >& targets) {
+		#ifdef _OPENMP
+		typename std::list< piece<T> >::iterator q;
+
+		#pragma omp parallel
+		#pragma omp single
+		{
+		for (q=targets.begin(); q!=targets.end(); q++) {
+			piece<T> P = *q;
+			#pragma omp task firstprivate(P)
+			process_task(P);
+		}
+		}
+		#else
+		piece<T> P;
+
+		while (!targets.empty()) {
+			P = targets.front();
+			targets.pop_front();
+			process(P, targets);
+		}
+		#endif
+
+		affine<T>::maxnum() = maxnum;
+	}
+
+#ifdef _OPENMP
+	void process_task(const piece<T>& P) {
+		std::list< piece<T> > next;
+		typename std::list< piece<T> >::iterator q;
+
+		process(P, next);
+
+		for (q=next.begin(); q!=next.end(); q++) {
+			piece<T> Q = *q;
+			#pragma omp task firstprivate(Q)
+			process_task(Q);
+		}
+	}
+#endif // _OPENMP
+};
+
+template <class T, class F>
+int
+ensemble(
+	F f,
+	std::list< piece<T> >& targets,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::list< ode_ensemble_result<T> >& result,
+	ub::vector< interval<T> >& hull,
+	const ode_param<T>& p,
+	const ode_ensemble_param<T>& ep
+) {
+	ensemble_worker<T, F> w(f, start, end, p, ep);
+	typename std::list< ode_ensemble_result<T> >::iterator q;
+	bool first = true;
+	int ret = 1;
+	int i;
+
+	w.run(targets);
+	w.result.sort(result_less<T>());
+	result.swap(w.result);
+
+	hull.resize(0);
+	for (q=result.begin(); q!=result.end(); q++) {
+		if (q->ret != 2) {
+			ret = 0;
+			continue;
+		}
+		if (first) {
+			hull = q->x;
+			first = false;
+		} else {
+			for (i=0; i<(int)hull.size(); i++) {
+				hull(i) = interval<T>::hull(hull(i), q->x(i));
+			}
+		}
+	}
+
+	return ret;
+}
+
+} // namespace ode_ensemble_sub
+
+
+template <class T, class F>
+int
+ode_ensemble(
+	F f,
+	const std::list< ub::vector< interval<T> > >& init,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::list< ode_ensemble_result<T> >& result,
+	ub::vector< interval<T> >& hull,
+	const ode_param<T>& p = ode_param<T>(),
+	const ode_ensemble_param<T>& ep = ode_ensemble_param<T>()
+) {
+	std::list< ode_ensemble_sub::piece<T> > targets;
+	typename std::list< ub::vector< interval<T> > >::const_iterator q;
+	ode_ensemble_sub::piece<T> P;
+	int n = 0;
+
+	for (q=init.begin(); q!=init.end(); q++) {
+		P.index = n++;
+		P.depth = 0;
+		P.box = *q;
+		targets.push_back(P);
+	}
+
+	return ode_ensemble_sub::ensemble(f, targets, start, end, result, hull, p, ep);
+}
+
+// affine initial sets.
+// the affine sets are integrated as they are. if a piece must be
+// bisected, its interval hull is bisected.
+
+template <class T, class F>
+int
+ode_ensemble(
+	F f,
+	const std::list< ub::vector< affine<T> > >& init,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::list< ode_ensemble_result<T> >& result,
+	ub::vector< interval<T> >& hull,
+	const ode_param<T>& p = ode_param<T>(),
+	const ode_ensemble_param<T>& ep = ode_ensemble_param<T>()
+) {
+	std::list< ode_ensemble_sub::piece<T> > targets;
+	typename std::list< ub::vector< affine<T> > >::const_iterator q;
+	ode_ensemble_sub::piece<T> P;
+	int n = 0;
+
+	for (q=init.begin(); q!=init.end(); q++) {
+		P.index = n++;
+		P.depth = 0;
+		P.aff = *q;
+		targets.push_back(P);
+	}
+
+	return ode_ensemble_sub::ensemble(f, targets, start, end, result, hull, p, ep);
+}
+
+} // namespace kv
+
+#endif // ODE_ENSEMBLE_HPP
@@ -188,6 +188,17 @@ ode_lohner(F f, ub::vector< interval<T> >& init, const interval<T>& start, inter
 			std::cout << " -> " << radius << "\n";
 		}
 		restart++;
+		if (p.stats != NULL) p.stats->add("ode_rejected");
+	}
+
+	if (p.stats != NULL) {
+		if (ret_val == 0) {
+			p.stats->add("ode_failures");
+		} else {
+			p.stats->add("ode_steps");
+			p.stats->record("ode_step_size", (double)deltat.upper());
+			p.stats->record("ode_order", p.order);
+		}
 	}
 
 	if (ret_val != 0) {
@@ -434,6 +445,17 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 			std::cout << " -> " << radius << "\n";
 		}
 		restart++;
+		if (p.stats != NULL) p.stats->add("ode_rejected");
+	}
+
+	if (p.stats != NULL) {
+		if (ret_val == 0) {
+			p.stats->add("ode_failures");
+		} else {
+			p.stats->add("ode_steps");
+			p.stats->record("ode_step_size", (double)deltat.upper());
+			p.stats->record("ode_order", p.order);
+		}
 	}
 
 	if (ret_val != 0) {
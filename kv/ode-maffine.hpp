@@ -80,8 +80,10 @@ ode_maffine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 	// below ode call is without autodif and point input,
 	// below ode call is supposed to be easier to succeed than above.
 	// If below ode call fails, force success by increasing order.
+	stats_timer timer(p.stats, "ode_affine");
 	ode_param<T> p2 = p;
 	p2.set_autostep(false);
+	p2.set_stats(NULL);
 	while (true) {
 		r = ode(f, fc, start, end2, p2);
 		if (r != 0) break;
@@ -102,6 +104,7 @@ ode_maffine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 	} else {
 		epsilon_reduce(result, p.ep_reduce, p.ep_reduce_limit);
 	}
+	if (p.stats != NULL) p.stats->record("ode_noise_symbols", affine<T>::maxnum());
 
 	init = result;
 	if (ret_val == 1) end = end2;
@@ -216,6 +216,7 @@ ode_maffine2(F f, ub::vector< affine<T> >& init, const interval<T>& start, inter
 	} else {
 		epsilon_reduce(result, p.ep_reduce, p.ep_reduce_limit);
 	}
+	if (p.stats != NULL) p.stats->record("ode_noise_symbols", affine<T>::maxnum());
 
 	init = result;
 	if (r == 1) end = end2;
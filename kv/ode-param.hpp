@@ -2,6 +2,7 @@
 #define ODE_PARAM_HPP
 
 #include <limits>
+#include <kv/solver-stats.hpp>
 
 namespace kv {
 
@@ -15,6 +16,7 @@ template <class T> struct ode_param {
 	int ep_reduce;
 	int ep_reduce_limit;
 	int restart_max;
+	solver_stats* stats; // NULL: no statistics
 
 	ode_param() :
 		order(24),
@@ -24,7 +26,8 @@ template <class T> struct ode_param {
 		verbose(0),
 		ep_reduce(0),
 		ep_reduce_limit(0),
-		restart_max(2)
+		restart_max(2),
+		stats(NULL)
 	{}
 
 	ode_param& set_order(int x) {
@@ -59,6 +62,10 @@ template <class T> struct ode_param {
 		restart_max = x;
 		return *this;
 	}
+	ode_param& set_stats(solver_stats* x) {
+		stats = x;
+		return *this;
+	}
 };
 
 } // namespace kv
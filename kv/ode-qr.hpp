@@ -15,6 +15,7 @@
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
 #include <kv/qr.hpp>
+#include <kv/interval-gemm.hpp>
 #include <kv/vleq.hpp>
 #include <kv/ode.hpp>
 #include <kv/ode-autodif.hpp>
@@ -110,7 +111,7 @@ odelong_qr(
 		result_d =  mid(result_d);
 		#endif
 
-		AQ = prod(result_d, Q);
+		mm_mult(result_d, Q, AQ);
 		bo = qr(mid(AQ), Q2, R);
 		if (bo == false) break;
 		Q2i = Q2;
@@ -138,7 +139,7 @@ odelong_qr(
 
 		ret_val = 1;
 
-		if (mat != NULL) M = prod(result_d, M);
+		if (mat != NULL) mm_mult(result_d, M, M);
 
 		if (p.verbose == 1) {
 			std::cout << "t: " << t1 << "\n";
@@ -198,7 +199,7 @@ odelong_qr(
 
 	if (r == 0) return 0;
 
-	M = prod(M_tmp, M);
+	mm_mult(M_tmp, M, M);
 
 	for (i=0; i<s; i++) {
 		init(i).v = x(i);
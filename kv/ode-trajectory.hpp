@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ODE_TRAJECTORY_HPP
+#define ODE_TRAJECTORY_HPP
+
+// store the whole trajectory of verified ODE solvers to files
+//
+//   kv::trajectory_writer<double> w("lorenz.traj");
+//   kv::odelong_maffine(f, x, start, end, p, kv::ode_callback_trajectory<double>(w));
+//   w.close();
+//
+//   kv::trajectory_reader<double> r("lorenz.traj");
+//   r.eval(t, y);   // y contains the solution at time t
+//
+// two files are written:
+//   name     : header (16 bytes) and the Taylor coefficients of
+//              each step (lower and upper bounds of each coefficient,
+//              n components x m coefficients, padded by zero)
+//   name.idx : fixed size record (trajectory_index) for each step
+// the steps are written in the order of time, so the step
+// containing given time is found by binary search on name.idx and
+// only that step is read from name.
+// T must be a plain type which can be written by its bytes
+// (double, float, dd, ...). files are not portable between machines
+// of different byte order.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/psa.hpp>
+#include <kv/ode-callback.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T> struct trajectory_index {
+	T start_lower, start_upper;
+	T end_lower, end_upper;
+	long long offset; // position of coefficients in data file
+	int n; // number of components
+	int m; // number of coefficients of each component
+};
+
+
+namespace trajectory_sub {
+
+static const char magic[8] = {'K', 'V', 'T', 'R', 'A', 'J', '1', '\0'};
+
+// eval of psa (hidden by trajectory_reader::eval)
+template <class T> inline interval<T> eval_psa(const psa< interval<T> >& x, const interval<T>& t) {
+	return eval(x, t);
+}
+
+} // namespace trajectory_sub
+
+
+template <class T> class trajectory_writer {
+	public:
+	std::ofstream data, index;
+	long long offset;
+	long long count;
+
+	trajectory_writer() : offset(0), count(0) {}
+
+	trajectory_writer(const std::string& name) : offset(0), count(0) {
+		open(name);
+	}
+
+	bool open(const std::string& name) {
+		int h[2];
+
+		close();
+		data.open(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		index.open((name + ".idx").c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!data || !index) return false;
+
+		h[0] = sizeof(T);
+		h[1] = 0;
+		data.write(trajectory_sub::magic, 8);
+		data.write((const char*)h, sizeof(h));
+		offset = 8 + sizeof(h);
+		count = 0;
+
+		return good();
+	}
+
+	void close() {
+		if (data.is_open()) data.close();
+		if (index.is_open()) index.close();
+	}
+
+	bool good() const {
+		return data.good() && index.good();
+	}
+
+	long long size() const {
+		return count;
+	}
+
+	bool write(const interval<T>& start, const interval<T>& end, const ub::vector< psa< interval<T> > >& result) {
+		int i, j, k;
+		int n = result.size();
+		int m = 0;
+		trajectory_index<T> e;
+		std::vector<T> buf;
+
+		for (i=0; i<n; i++) {
+			k = result(i).v.size();
+			if (k > m) m = k;
+		}
+
+		buf.resize((std::size_t)2 * n * m);
+		for (i=0; i<n; i++) {
+			k = result(i).v.size();
+			for (j=0; j<m; j++) {
+				if (j < k) {
+					buf[2 * (i * m + j)] = result(i).v(j).lower();
+					buf[2 * (i * m + j) + 1] = result(i).v(j).upper();
+				} else {
+					buf[2 * (i * m + j)] = 0.;
+					buf[2 * (i * m + j) + 1] = 0.;
+				}
+			}
+		}
+
+		std::memset(&e, 0, sizeof(e));
+		e.start_lower = start.lower();
+		e.start_upper = start.upper();
+		e.end_lower = end.lower();
+		e.end_upper = end.upper();
+		e.offset = offset;
+		e.n = n;
+		e.m = m;
+
+		if (!buf.empty()) data.write((const char*)&buf[0], sizeof(T) * buf.size());
+		index.write((const char*)&e, sizeof(e));
+		offset += sizeof(T) * buf.size();
+		count++;
+
+		return good();
+	}
+
+	~trajectory_writer() {
+		close();
+	}
+};
+
+
+template <class T> class trajectory_reader {
+	public:
+	mutable std::ifstream data, index;
+	long long count;
+
+	trajectory_reader() : count(0) {}
+
+	trajectory_reader(const std::string& name) : count(0) {
+		open(name);
+	}
+
+	bool open(const std::string& name) {
+		char m[8];
+		int h[2];
+
+		count = 0;
+		if (data.is_open()) data.close();
+		if (index.is_open()) index.close();
+		data.open(name.c_str(), std::ios::in | std::ios::binary);
+		index.open((name + ".idx").c_str(), std::ios::in | std::ios::binary);
+		if (!data || !index) return false;
+
+		data.read(m, 8);
+		data.read((char*)h, sizeof(h));
+		if (!data || std::memcmp(m, trajectory_sub::magic, 8) != 0 || h[0] != (int)sizeof(T)) {
+			data.close();
+			index.close();
+			return false;
+		}
+
+		index.seekg(0, std::ios::end);
+		count = (long long)index.tellg() / sizeof(trajectory_index<T>);
+
+		return true;
+	}
+
+	// number of steps
+	long long size() const {
+		return count;
+	}
+
+	bool read_index(long long i, trajectory_index<T>& e) const {
+		if (i < 0 || i >= count) return false;
+		index.clear();
+		index.seekg(i * sizeof(trajectory_index<T>));
+		index.read((char*)&e, sizeof(e));
+		return index.good();
+	}
+
+	// i-th step
+	bool get(long long i, interval<T>& start, interval<T>& end, ub::vector< psa< interval<T> > >& result) const {
+		trajectory_index<T> e;
+		std::vector<T> buf;
+		int j, k;
+
+		if (!read_index(i, e)) return false;
+
+		buf.resize((std::size_t)2 * e.n * e.m);
+		data.clear();
+		data.seekg(e.offset);
+		if (!buf.empty()) data.read((char*)&buf[0], sizeof(T) * buf.size());
+		if (!data) return false;
+
+		start.assign(e.start_lower, e.start_upper);
+		end.assign(e.end_lower, e.end_upper);
+		result.resize(e.n);
+		for (j=0; j<e.n; j++) {
+			result(j).v.resize(e.m);
+			for (k=0; k<e.m; k++) {
+				result(j).v(k).assign(buf[2 * (j * e.m + k)], buf[2 * (j * e.m + k) + 1]);
+			}
+		}
+
+		return true;
+	}
+
+	// first step whose end is not less than t (size() if none)
+	long long lower_bound(const T& t) const {
+		long long lo = 0, hi = count, c;
+		trajectory_index<T> e;
+
+		while (lo < hi) {
+			c = lo + (hi - lo) / 2;
+			if (!read_index(c, e)) return count;
+			if (e.end_upper < t) lo = c + 1;
+			else hi = c;
+		}
+		return lo;
+	}
+
+	// step containing t (-1 if none)
+	long long find(const T& t) const {
+		long long i = lower_bound(t);
+		trajectory_index<T> e;
+
+		if (!read_index(i, e)) return -1;
+		if (e.start_lower > t) return -1;
+		return i;
+	}
+
+	// y contains the solution at all the time in t.
+	// return false if t is not covered by the trajectory.
+	bool eval(const interval<T>& t, ub::vector< interval<T> >& y) const {
+		long long i;
+		interval<T> start, end, tt;
+		ub::vector< psa< interval<T> > > result;
+		ub::vector< interval<T> > z;
+		bool first = true;
+		T reach;
+		int j;
+
+		i = lower_bound(t.lower());
+		reach = t.lower();
+
+		for ( ; i<count; i++) {
+			if (!get(i, start, end, result)) return false;
+			if (start.lower() > reach) return false; // gap
+			if (start.lower() > t.upper()) break;
+
+			using std::max;
+			using std::min;
+			tt.assign(max(t.lower(), start.lower()), min(t.upper(), end.upper()));
+			tt = tt - start;
+
+			z.resize(result.size());
+			for (j=0; j<(int)result.size(); j++) {
+				z(j) = trajectory_sub::eval_psa(result(j), tt);
+			}
+			if (first) {
+				y = z;
+				first = false;
+			} else {
+				for (j=0; j<(int)y.size(); j++) {
+					y(j) = interval<T>::hull(y(j), z(j));
+				}
+			}
+
+			if (end.upper() > reach) reach = end.upper();
+			if (reach >= t.upper()) return true;
+		}
+
+		return false;
+	}
+};
+
+
+// callback function for writing trajectory to files
+
+template <class T> struct ode_callback_trajectory : ode_callback<T> {
+	trajectory_writer<T>& w;
+
+	ode_callback_trajectory(trajectory_writer<T>& w) : w(w) {}
+
+	virtual bool operator()(const interval<T>& start, const interval<T>& end, const ub::vector< interval<T> >&, const ub::vector< interval<T> >&, const ub::vector< psa< interval<T> > >& result) const {
+		// stop the solver if the files can not be written
+		return w.write(start, end, result);
+	}
+};
+
+} // namespace kv
+
+#endif // ODE_TRAJECTORY_HPP
@@ -95,6 +95,8 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 	tolerance = m * p.epsilon;
 	#endif
 
+	stats_timer timer(p.stats, "ode_taylor");
+
 	x = init;
 	torg.v.resize(2);
 	torg.v(0) = start; torg.v(1) = 1.;
@@ -166,6 +168,8 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 		#endif // ODE_STEP_COMPONENT
 	}
 
+	timer.lap("ode_verify");
+
 	psa< interval<T> >::mode() = 2;
 
 	restart = 0;
@@ -206,11 +210,13 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 					std::cout << " -> " << radius << "\n";
 				}
 				restart++;
+				if (p.stats != NULL) p.stats->add("ode_restarts");
 				continue;
 			} else {
 				throw std::domain_error("ode: evaluation error");
 			}
 		}
+		if (p.stats != NULL) p.stats->add("ode_picard");
 
 		for (i=0; i<n; i++) {
 			temp = integrate(w(i));
@@ -245,6 +251,7 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 				// do nothing, not continue
 			} else {
 				radius = radius_tmp;
+				if (p.stats != NULL) p.stats->add("ode_resized");
 				continue;
 			}
 		}
@@ -263,11 +270,13 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 					std::cout << " -> " << radius << "\n";
 				}
 				restart++;
+				if (p.stats != NULL) p.stats->add("ode_restarts");
 				continue;
 			} else {
 				throw std::domain_error("ode: evaluation error");
 			}
 		}
+		if (p.stats != NULL) p.stats->add("ode_picard");
 
 		for (i=0; i<n; i++) {
 			temp = integrate(w(i));
@@ -303,8 +312,22 @@ ode(F f, ub::vector< interval<T> >& init, const interval<T>& start, interval<T>&
 			std::cout << " -> " << radius << "\n";
 		}
 		restart++;
+		if (p.stats != NULL) p.stats->add("ode_rejected");
 	}
 
+	if (p.stats != NULL) {
+		if (ret_val == 0) {
+			p.stats->add("ode_failures");
+		} else {
+			p.stats->add("ode_steps");
+			p.stats->add("ode_picard", p.iteration);
+			p.stats->record("ode_step_size", (double)deltat.upper());
+			p.stats->record("ode_order", p.order);
+		}
+	}
+
+	timer.lap("ode_refine");
+
 	if (ret_val != 0) {
 		for (j=0; j<p.iteration; j++) {
 			z = w;
@@ -7,6 +7,8 @@
 
 #include <iostream>
 #include <list>
+#include <vector>
+#include <algorithm>
 #include <limits>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
@@ -15,6 +17,12 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <kv/autodif.hpp>
+#include <kv/autodif-reverse.hpp>
+#include <kv/checkpoint.hpp>
+#include <kv/solver-stats.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 // 0: Do not use TRIM
@@ -34,6 +42,37 @@
 #define OPTIMIZE_USESLOPE 1
 #endif
 
+// order of processing boxes
+// 0: FIFO (breadth-first)
+// 1: best-first (box with the smallest lower bound of f first)
+// 2: depth-first
+// 3: depth-first, but jump to the best box
+//    every OPTIMIZE_PRUNE_INTERVAL boxes
+
+#ifndef OPTIMIZE_ORDER
+#define OPTIMIZE_ORDER 0
+#endif
+
+// remove boxes whose lower bound of f exceeds delta from the queue
+// every OPTIMIZE_PRUNE_INTERVAL boxes (OPTIMIZE_ORDER >= 1)
+
+#ifndef OPTIMIZE_PRUNE_INTERVAL
+#define OPTIMIZE_PRUNE_INTERVAL 1024
+#endif
+
+// 1: run in parallel if compiled with OpenMP
+
+#ifndef OPTIMIZE_PARALLEL
+#define OPTIMIZE_PARALLEL 0
+#endif
+
+// 0: calculate the gradient by autodif (forward mode)
+// 1: calculate the gradient by autodif_reverse (reverse mode)
+
+#ifndef OPTIMIZE_REVERSE
+#define OPTIMIZE_REVERSE 0
+#endif
+
 
 namespace kv {
 
@@ -60,22 +99,317 @@ template <class F> struct Opt_MakeVec {
 };
 
 
+namespace optimize_sub {
+
+// queue of boxes waiting for processing.
+// each box has key, a lower bound of f on the box.
+
+template <class T> struct box_entry {
+	T key;
+	unsigned long serial;
+	int slot;
+};
+
+// smaller key first, and older first for the same key
+template <class T> struct box_entry_greater {
+	bool operator() (const box_entry<T>& x, const box_entry<T>& y) const {
+		if (x.key != y.key) return x.key > y.key;
+		return x.serial > y.serial;
+	}
+};
+
+template <class T> class box_queue {
+	// used for OPTIMIZE_ORDER == 0
+	std::list< ub::vector< interval<T> > > fifo;
+
+	// used for OPTIMIZE_ORDER >= 1
+	// the boxes are kept in slots and only the entries are moved
+	std::vector< ub::vector< interval<T> > > slots;
+	std::vector<int> free_slots;
+	std::vector< box_entry<T> > entries;
+	unsigned long serial;
+	int npop;
+
+	public:
+
+	box_queue() : serial(0), npop(0) {}
+
+	bool empty() const {
+#if OPTIMIZE_ORDER == 0
+		return fifo.empty();
+#else
+		return entries.empty();
+#endif
+	}
+
+	int size() const {
+#if OPTIMIZE_ORDER == 0
+		return fifo.size();
+#else
+		return entries.size();
+#endif
+	}
+
+#if OPTIMIZE_ORDER == 0
+	void push(const ub::vector< interval<T> >& I, const T&) {
+		fifo.push_back(I);
+	}
+#else
+	void push(const ub::vector< interval<T> >& I, const T& key) {
+		box_entry<T> e;
+
+		if (free_slots.empty()) {
+			e.slot = slots.size();
+			slots.push_back(I);
+		} else {
+			e.slot = free_slots.back();
+			free_slots.pop_back();
+			slots[e.slot] = I;
+		}
+		e.key = key;
+		e.serial = serial++;
+		entries.push_back(e);
+#if OPTIMIZE_ORDER == 1
+		std::push_heap(entries.begin(), entries.end(), box_entry_greater<T>());
+#endif
+	}
+#endif
+
+	// push all boxes in l and clear l. return number of boxes.
+	int push_all(std::list< ub::vector< interval<T> > >& l, const T& key) {
+		int n = 0;
+
+		while (!l.empty()) {
+			push(l.front(), key);
+			l.pop_front();
+			n++;
+		}
+		return n;
+	}
+
+	// remove boxes whose key is larger than delta.
+	// return number of removed boxes.
+	int prune(const T& delta) {
+		int i, j, m;
+
+		j = 0;
+		for (i=0; i<(int)entries.size(); i++) {
+			if (entries[i].key > delta) {
+				free_slots.push_back(entries[i].slot);
+			} else {
+				entries[j++] = entries[i];
+			}
+		}
+		m = entries.size() - j;
+		entries.resize(j);
+#if OPTIMIZE_ORDER == 1
+		std::make_heap(entries.begin(), entries.end(), box_entry_greater<T>());
+#endif
+		return m;
+	}
+
+	// called before each pop.
+	// prune the queue every OPTIMIZE_PRUNE_INTERVAL boxes.
+	// return number of removed boxes.
+#if OPTIMIZE_ORDER == 0
+	int update(const T&) {
+		return 0;
+	}
+#else
+	int update(const T& delta) {
+		int m;
+
+		if (++npop < OPTIMIZE_PRUNE_INTERVAL) return 0;
+		npop = 0;
+		m = prune(delta);
+#if OPTIMIZE_ORDER == 3
+		// jump to the best box
+		int i, mi;
+
+		if (entries.empty()) return m;
+		mi = 0;
+		for (i=1; i<(int)entries.size(); i++) {
+			if (box_entry_greater<T>()(entries[mi], entries[i])) mi = i;
+		}
+		std::swap(entries[mi], entries.back());
+#endif
+		return m;
+	}
+#endif
+
+	void pop(ub::vector< interval<T> >& I) {
+#if OPTIMIZE_ORDER == 0
+		I = fifo.front();
+		fifo.pop_front();
+#else
+		box_entry<T> e;
+
+#if OPTIMIZE_ORDER == 1
+		std::pop_heap(entries.begin(), entries.end(), box_entry_greater<T>());
+#endif
+		e = entries.back();
+		entries.pop_back();
+		I.swap(slots[e.slot]);
+		free_slots.push_back(e.slot);
+#endif
+	}
+
+	// write the boxes in the queue order with their keys
+	bool save(std::FILE* fp) const {
+		long long m = size();
+
+		if (!checkpoint_sub::write_value(fp, serial)) return false;
+		if (!checkpoint_sub::write_value(fp, npop)) return false;
+		if (!checkpoint_sub::write_value(fp, m)) return false;
+#if OPTIMIZE_ORDER == 0
+		typename std::list< ub::vector< interval<T> > >::const_iterator p;
+		for (p=fifo.begin(); p!=fifo.end(); p++) {
+			if (!write_box(fp, *p)) return false;
+		}
+#else
+		long long i;
+		for (i=0; i<m; i++) {
+			if (!checkpoint_sub::write_value(fp, entries[i].key)) return false;
+			if (!checkpoint_sub::write_value(fp, entries[i].serial)) return false;
+			if (!write_box(fp, slots[entries[i].slot])) return false;
+		}
+#endif
+		return true;
+	}
+
+	// replace the contents by the boxes written by save
+	bool load(std::FILE* fp, int s) {
+		long long i, m;
+		ub::vector< interval<T> > I;
+
+		fifo.clear();
+		slots.clear();
+		free_slots.clear();
+		entries.clear();
+		if (!checkpoint_sub::read_value(fp, serial)) return false;
+		if (!checkpoint_sub::read_value(fp, npop)) return false;
+		if (!checkpoint_sub::read_value(fp, m)) return false;
+		for (i=0; i<m; i++) {
+#if OPTIMIZE_ORDER == 0
+			if (!read_box(fp, s, I)) return false;
+			fifo.push_back(I);
+#else
+			box_entry<T> e;
+			if (!checkpoint_sub::read_value(fp, e.key)) return false;
+			if (!checkpoint_sub::read_value(fp, e.serial)) return false;
+			if (!read_box(fp, s, I)) return false;
+			// same order of entries keeps the heap as it was
+			e.slot = slots.size();
+			slots.push_back(I);
+			entries.push_back(e);
+#endif
+		}
+		return true;
+	}
+};
+
+
+// save the state of optimize (queue, solutions and delta) to the
+// checkpoint file
+
+template <class T> bool save_checkpoint(const checkpoint_param& cp, unsigned long long key, int s, const T& delta, const box_queue<T>& targets, const std::list< ub::vector< interval<T> > >& solutions) {
+	std::FILE* fp;
+	bool ok;
+
+	fp = checkpoint_sub::begin_write(cp);
+	if (fp == NULL) return false;
+
+	ok = checkpoint_sub::write_header(fp, "optimize", sizeof(T), key)
+		&& checkpoint_sub::write_value(fp, s)
+		&& checkpoint_sub::write_value(fp, delta)
+		&& targets.save(fp)
+		&& checkpoint_sub::write_list(fp, solutions);
+
+	return checkpoint_sub::end_write(cp, fp, ok);
+}
+
+// restore the state saved by save_checkpoint.
+// return false if there is no valid checkpoint of the same problem.
+
+template <class T> bool load_checkpoint(const checkpoint_param& cp, unsigned long long key, int s, T& delta, box_queue<T>& targets, std::list< ub::vector< interval<T> > >& solutions) {
+	std::FILE* fp;
+	bool ok;
+	int s2;
+
+	fp = checkpoint_sub::begin_read(cp);
+	if (fp == NULL) return false;
+
+	ok = checkpoint_sub::read_header(fp, "optimize", sizeof(T), key)
+		&& checkpoint_sub::read_value(fp, s2)
+		&& s2 == s
+		&& checkpoint_sub::read_value(fp, delta)
+		&& targets.load(fp, s)
+		&& checkpoint_sub::read_list(fp, s, solutions);
+
+	std::fclose(fp);
+
+	return ok;
+}
+
+} // namespace optimize_sub
+
+
+// cp: save the state to cp.file every cp.interval boxes, and resume
+// from it if exists (see checkpoint.hpp)
+// stats: if not NULL, the numbers of tested, pruned and divided boxes
+// and the elapsed time are added (see solver-stats.hpp)
+
 template <class T, class F>
 std::list< ub::vector< interval<T> > >
-optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true, int verbose = 0)
+optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true, int verbose = 0, const checkpoint_param& cp = checkpoint_param(), solver_stats* stats = NULL)
 {
-	// valid in C++11
-	// std::list< ub::vector< interval<T> > > targets{init};
-	std::list< ub::vector< interval<T> > > targets;
-	targets.push_back(init);
+	stats_timer timer(stats, "optimize");
+	optimize_sub::box_queue<T> targets;
+	std::list< ub::vector< interval<T> > > solutions;
+	T delta = std::numeric_limits<T>::max();
 
 	int s = init.size();
+
+	// fingerprint of the problem. maximize is distinguished from
+	// minimize by the type of the function (Opt_MakeMinus<F>).
+	unsigned long long key = checkpoint_sub::hash_init<F>("optimize");
+	checkpoint_sub::hash_value(key, limit);
+	checkpoint_sub::hash_value(key, unify);
+	checkpoint_sub::hash_box(key, init);
+
+	// start from the checkpoint if exists
+	if (optimize_sub::load_checkpoint(cp, key, s, delta, targets, solutions)) {
+		if (verbose >= 1) {
+			std::cout << "resume from " << cp.file << ": " << targets.size() << " boxes, " << solutions.size() << " solutions\n";
+		}
+	} else {
+		targets = optimize_sub::box_queue<T>();
+		solutions.clear();
+		delta = std::numeric_limits<T>::max();
+		targets.push(init, -std::numeric_limits<T>::infinity());
+	}
+
+	long long count_box = 0; // processed boxes after last checkpoint
+
+#if defined(_OPENMP) && OPTIMIZE_PARALLEL == 1
+	// delta is the local copy of shared_delta in each thread.
+	// they are synchronized whenever the thread accesses the queue.
+	T shared_delta = delta;
+	int count_unknown = targets.size();
+	int inflight = 0; // boxes being processed
+
+	#pragma omp parallel firstprivate(delta)
+#endif
+	{
+
 	ub::vector< interval<T> > I, C, I1, I2, IR, fdi, C2;
 	interval<T> fc, fi, mvf, fc2; 
 	T tmp, tmp2;
-	std::list< ub::vector< interval<T> > > solutions;
+	T key; // lower bound of f on I
+	std::list< ub::vector< interval<T> > > next; // boxes generated from I
 	typename std::list< ub::vector< interval<T> > >::iterator p;
 	int i, j, k, mi;
+	int npruned; // boxes removed from the queue
 	bool flag, errflag;
 	interval<T> A, B, J, J2, Itmp; 
 #if OPTIMIZE_TRIM == 3
@@ -83,12 +417,64 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 #endif // OPTIMIZE_TRIM == 3
 
 	C2.resize(s);
+	key = -std::numeric_limits<T>::infinity();
 
-	T delta = std::numeric_limits<T>::max();
+	while (true) {
 
-	while (!targets.empty()) {
-		I = targets.front();
-		targets.pop_front();
+#if defined(_OPENMP) && OPTIMIZE_PARALLEL == 1
+
+		int iflag = 0;
+		#pragma omp critical (optimize_targets)
+		{
+		// I is finished at this point except the first time
+		if (I.size() != 0) {
+			count_unknown += targets.push_all(next, key) - 1;
+			inflight--;
+		}
+		if (delta < shared_delta) shared_delta = delta;
+		else delta = shared_delta;
+		// all the threads have returned their boxes
+		if (cp.enabled() && count_box >= cp.interval && inflight == 0) {
+			if (!optimize_sub::save_checkpoint(cp, key, s, shared_delta, targets, solutions) && verbose >= 1) {
+				std::cout << "checkpoint: can not write " << cp.file << "\n";
+			}
+			count_box = 0;
+		}
+		npruned = targets.update(delta);
+		if (stats != NULL && npruned > 0) stats->add("optimize_pruned", npruned);
+		if (count_unknown == 0) iflag = 2;
+		else if (targets.empty() || (cp.enabled() && count_box >= cp.interval)) iflag = 1;
+		else {
+			targets.pop(I);
+			count_box++;
+			inflight++;
+		}
+		}
+		if (iflag == 2) break;
+		if (iflag == 1) {
+			I.resize(0);
+			continue;
+		}
+
+#else // _OPENMP && OPTIMIZE_PARALLEL
+
+		targets.push_all(next, key);
+		if (cp.enabled() && count_box >= cp.interval) {
+			if (!optimize_sub::save_checkpoint(cp, key, s, delta, targets, solutions) && verbose >= 1) {
+				std::cout << "checkpoint: can not write " << cp.file << "\n";
+			}
+			count_box = 0;
+		}
+		npruned = targets.update(delta);
+		if (stats != NULL && npruned > 0) stats->add("optimize_pruned", npruned);
+		if (targets.empty()) break;
+		targets.pop(I);
+		count_box++;
+
+#endif // _OPENMP && OPTIMIZE_PARALLEL
+
+		if (stats != NULL) stats->add("optimize_tested");
+		key = -std::numeric_limits<T>::infinity();
 		errflag = false; // evaluation error occurs or not
 
 		try {
@@ -100,13 +486,19 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 		}
 
 		if (fi.lower() > delta) {
+			if (stats != NULL) stats->add("optimize_pruned");
 			continue;
 		}
+		key = fi.lower();
 
 		C = mid(I);
 		try {
 			fc = f(C);
-			autodif< interval<T> >::split(f(autodif< interval<T> >::init(I)), fi, fdi);
+#if OPTIMIZE_REVERSE == 1
+			autodif_reverse< interval<T> >::split(f(autodif_reverse< interval<T> >::init(I)), fi, fdi);
+#else
+			autodif_eval<F>::split(f, I, fi, fdi);
+#endif
 		}
 		catch (std::domain_error& e) {
 			// errflag = true;
@@ -116,8 +508,10 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 		fdi.resize(s); // prepare for constant f
 		mvf = fc + inner_prod(fdi, I - C);
 		if (mvf.lower() > delta) {
+			if (stats != NULL) stats->add("optimize_pruned");
 			continue;
 		}
+		if (mvf.lower() > key) key = mvf.lower();
 
 #if OPTIMIZE_USESLOPE == 1
 		flag = false;
@@ -128,7 +522,10 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 				flag = true; break;
 			}
 		}
-		if (flag) continue;
+		if (flag) {
+			if (stats != NULL) stats->add("optimize_pruned");
+			continue;
+		}
 #endif // OPTIMiZE_USESLOPE
 
 		// update delta at C
@@ -227,8 +624,8 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 						I2 = IR;
 						I1(j) = intersect(IR(j), J);
 						I2(j) = intersect(IR(j), J2);
-						targets.push_back(I1);
-						targets.push_back(I2);
+						next.push_back(I1);
+						next.push_back(I2);
 						flag = true;
 						break;
 #else
@@ -261,6 +658,10 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 
 		// non-existence in I turns out
 		if (flag == true) {
+			if (stats != NULL) {
+				if (next.empty()) stats->add("optimize_pruned");
+				else stats->add("optimize_divided");
+			}
 			continue;
 		}
 
@@ -279,6 +680,10 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 		}
 
 		if (tmp2 < limit && errflag == false) {
+#if defined(_OPENMP) && OPTIMIZE_PARALLEL == 1
+			#pragma omp critical (optimize_solutions)
+#endif
+			{
 			if (verbose >= 1) {
 				std::cout << I << "\n";
 			}
@@ -299,6 +704,8 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 				}
 			}
 			solutions.push_back(I);
+			}
+			if (stats != NULL) stats->add("optimize_solutions");
 			continue;
 		}
 
@@ -306,10 +713,19 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 		I1 = I; I2 = I;
 		I1(mi).assign(I1(mi).lower(), tmp);
 		I2(mi).assign(tmp, I2(mi).upper());
-		targets.push_back(I1);
-		targets.push_back(I2);
+		next.push_back(I1);
+		next.push_back(I2);
+		if (stats != NULL) stats->add("optimize_divided");
 	}
 
+	} // pragma omp parallel
+
+	checkpoint_sub::finish(cp);
+
+#if defined(_OPENMP) && OPTIMIZE_PARALLEL == 1
+	delta = shared_delta;
+#endif
+
 	if (verbose >= 1) {
 		std::cout << delta << "\n";
 	}
@@ -320,9 +736,9 @@ optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true,
 // rename of optimize
 template <class T, class F>
 std::list< ub::vector< interval<T> > >
-minimize(const ub::vector< interval<T> >& x, F f, T limit, bool unify = true, int verbose = 0)
+minimize(const ub::vector< interval<T> >& x, F f, T limit, bool unify = true, int verbose = 0, const checkpoint_param& cp = checkpoint_param(), solver_stats* stats = NULL)
 {
-        return optimize(x, f, limit, unify, verbose);
+        return optimize(x, f, limit, unify, verbose, cp, stats);
 }
 
 // specify maximum number of subdivision instead of width limit
@@ -393,9 +809,9 @@ minimize_value(const ub::vector< interval<T> >& x, F f, int n = 1000, int verbos
 
 template <class T, class F>
 std::list< ub::vector< interval<T> > >
-maximize(const ub::vector< interval<T> >& x, F f, T limit, bool unify = true, int verbose = 0)
+maximize(const ub::vector< interval<T> >& x, F f, T limit, bool unify = true, int verbose = 0, const checkpoint_param& cp = checkpoint_param(), solver_stats* stats = NULL)
 {
-        return minimize(x, Opt_MakeMinus<F>(f), limit, unify, verbose);
+        return minimize(x, Opt_MakeMinus<F>(f), limit, unify, verbose, cp, stats);
 }
 
 template <class T, class F>
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+// allocator which recycles memory blocks through per-thread free lists.
+// blocks are classified by size (powers of two), so repeated allocation
+// and deallocation of small arrays of the same size (e.g. coefficients
+// of power series in the Taylor loop of ODE solvers) does not call
+// malloc/free after the first few steps.
+
+#include <cstddef>
+#include <new>
+#include <limits>
+
+// maximum bytes of cached blocks per size class and thread.
+// (at least one block is cached for each class)
+
+#ifndef POOL_ALLOCATOR_CACHE_BYTES
+#define POOL_ALLOCATOR_CACHE_BYTES (1 << 20)
+#endif
+
+namespace kv {
+
+struct pool_memory {
+	// block sizes: 2^min_shift, ..., 2^(min_shift + nclass - 1) bytes
+	static const int min_shift = 5;
+	static const int nclass = 16;
+	// maximum number of cached blocks per size class
+	static const int max_cache = 4096;
+
+	// number of blocks of class c which may be cached
+	static int cache_limit(int c) {
+		std::size_t n = (std::size_t)(POOL_ALLOCATOR_CACHE_BYTES) >> (c + min_shift);
+		if (n < 1) return 1;
+		if (n > (std::size_t)max_cache) return max_cache;
+		return (int)n;
+	}
+
+	struct free_list {
+		void* head[nclass];
+		int count[nclass];
+	};
+
+	static free_list& list() {
+		static free_list l;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(l)
+		#endif
+		return l;
+	}
+
+	// size class of n bytes, or -1 if too large
+	static int size_class(std::size_t n) {
+		int c = 0;
+		std::size_t s = (std::size_t)1 << min_shift;
+
+		while (s < n) {
+			s <<= 1;
+			c++;
+			if (c >= nclass) return -1;
+		}
+		return c;
+	}
+
+	static void* allocate(std::size_t n) {
+		int c = size_class(n);
+		void* p;
+
+		if (c < 0) return ::operator new(n);
+
+		free_list& l = list();
+		p = l.head[c];
+		if (p != 0) {
+			l.head[c] = *(void**)p;
+			l.count[c]--;
+			return p;
+		}
+		return ::operator new((std::size_t)1 << (c + min_shift));
+	}
+
+	static void deallocate(void* p, std::size_t n) {
+		int c = size_class(n);
+
+		if (c < 0) {
+			::operator delete(p);
+			return;
+		}
+
+		free_list& l = list();
+		if (l.count[c] >= cache_limit(c)) {
+			::operator delete(p);
+			return;
+		}
+		*(void**)p = l.head[c];
+		l.head[c] = p;
+		l.count[c]++;
+	}
+
+	// return all cached blocks of this thread to the system
+	static void release() {
+		int c;
+		void* p;
+		free_list& l = list();
+
+		for (c=0; c<nclass; c++) {
+			while ((p = l.head[c]) != 0) {
+				l.head[c] = *(void**)p;
+				::operator delete(p);
+			}
+			l.count[c] = 0;
+		}
+	}
+};
+
+
+template <class T> class pool_allocator {
+	public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <class U> struct rebind {
+		typedef pool_allocator<U> other;
+	};
+
+	pool_allocator() {
+	}
+
+	template <class U> pool_allocator(const pool_allocator<U>&) {
+	}
+
+	pointer address(reference x) const {
+		return &x;
+	}
+
+	const_pointer address(const_reference x) const {
+		return &x;
+	}
+
+	pointer allocate(size_type n, const void* = 0) {
+		return (pointer)pool_memory::allocate(n * sizeof(T));
+	}
+
+	void deallocate(pointer p, size_type n) {
+		pool_memory::deallocate((void*)p, n * sizeof(T));
+	}
+
+	size_type max_size() const {
+		return std::numeric_limits<size_type>::max() / sizeof(T);
+	}
+
+	void construct(pointer p, const T& x) {
+		new((void*)p) T(x);
+	}
+
+	void destroy(pointer p) {
+		p->~T();
+	}
+
+	friend bool operator==(const pool_allocator&, const pool_allocator&) {
+		return true;
+	}
+
+	friend bool operator!=(const pool_allocator&, const pool_allocator&) {
+		return false;
+	}
+};
+
+} // namespace kv
+
+#endif // POOL_ALLOCATOR_HPP
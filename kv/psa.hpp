@@ -8,12 +8,36 @@
 // Power Series Arithmetic Type I and II with recording
 
 #include <iostream>
-#include <list>
+#include <vector>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <kv/convert.hpp>
+#include <kv/pool-allocator.hpp>
+
+/*
+ * storage of coefficients
+ *
+ *  0: ub::vector<T> with std::allocator
+ *  1: ub::vector<T> with per-thread pool_allocator (default)
+ */
+
+#ifndef PSA_POOL
+#define PSA_POOL 1
+#endif
+
+/*
+ * the multiplication of psa with at least PSA_KARATSUBA_MIN
+ * coefficients uses psa_mul (Karatsuba) if it is enabled for T
+ */
+
+#ifndef PSA_KARATSUBA_MIN
+#define PSA_KARATSUBA_MIN 64
+#endif
 
 namespace kv {
 
@@ -32,9 +56,296 @@ template <class C, class T> struct acceptable_n<C, psa<T> > {
 
 
 
+/*
+ * tape of coefficients recorded by psa operations (history).
+ *
+ * Operations of the Picard iteration are repeated in the same order
+ * with one more coefficient, so records are read by a cursor in the
+ * order they were written (first in, first out).  Records of the
+ * previous pass are read from a, records of the current pass are
+ * written to b, and a and b are exchanged when a is exhausted.
+ * Storage of a consumed record is moved to the written record, so
+ * already computed coefficients are neither copied nor reallocated.
+ */
+
+template <class T> class psa_tape {
+	public:
+	std::vector< std::vector<T> > a, b;
+	int na; // number of records in a
+	int rd; // read cursor in a
+	int wr; // number of records in b
+
+	psa_tape() : na(0), rd(0), wr(0) {
+	}
+
+	int size() const {
+		return na - rd + wr;
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	void clear() {
+		na = rd = wr = 0;
+	}
+
+	std::vector<T>& front() {
+		if (rd == na) {
+			a.swap(b);
+			na = wr;
+			rd = wr = 0;
+		}
+		return a[rd];
+	}
+
+	// returns the storage of the consumed record
+	std::vector<T>& pop_front() {
+		std::vector<T>& r = front();
+		rd++;
+		return r;
+	}
+
+	std::vector<T>& push_back() {
+		if (wr == (int)b.size()) b.push_back(std::vector<T>());
+		return b[wr++];
+	}
+};
+
+
+/*
+ * sum of products in the multiplication:
+ *   psa_dot<T>::conv(a, b, i, j0, j1) = sum_{j=j0}^{j1} a(j) * b(i-j)
+ * specialized for interval<dd> in dd-batch.hpp and for interval<mpfr<N>>
+ * in rmpfr.hpp.
+ */
+
+template <class T> struct psa_dot {
+	template <class V> static T conv(const V& a, const V& b, int i, int j0, int j1) {
+		T sum;
+		int j;
+
+		sum = 0.;
+		for (j=j0; j<=j1; j++) {
+			sum += a(j) * b(i-j);
+		}
+		return sum;
+	}
+};
+
+
+/*
+ * common part of two enclosures of the same value:
+ *   psa_intersect<T>::f(a, b)
+ * used for the remainder of type-II psa if enabled.
+ */
+
+template <class T> struct psa_intersect {
+	static const bool enabled = false;
+	static T f(const T& a, const T& b) {
+		return a;
+	}
+};
+
+template <class T> class interval;
+class dd;
+
+template <class T> struct psa_intersect< interval<T> > {
+	static const bool enabled = true;
+	static interval<T> f(const interval<T>& a, const interval<T>& b) {
+		return intersect(a, b);
+	}
+};
+
+
+/*
+ * full product of coefficient vectors a and b of same size s:
+ *   psa_mul<T>::mul(a, b, c), c(k) = sum_{i+j=k} a(i) b(j), k < 2s-1
+ * used by operator* if enabled and s >= PSA_KARATSUBA_MIN.
+ *
+ * for interval<T>, the product is computed in midpoint-radius form:
+ *   a(i) in ma(i) +- ra(i), b(j) in mb(j) +- rb(j)
+ *   c = ma * mb +- (|ma| * rb + ra * (|mb| + rb))
+ * ma * mb is computed by Karatsuba with thin intervals, so that its
+ * rounding errors are included. the radius is computed by Karatsuba
+ * with interval<double>. before the products, t is scaled by q = 2^g
+ * so that the magnitudes of the coefficients are uniform, which keeps
+ * the cancellation in Karatsuba small.
+ * it is enabled for interval<T> except for T = double and dd, for which
+ * the naive convolution (and psa_dot) is faster up to several hundred
+ * coefficients.
+ */
+
+namespace psa_sub {
+
+// c[0..2n-2] = a[0..n-1] * b[0..n-1]. w: work area of size 4n + 64
+template <class X> void karatsuba(const X* a, const X* b, X* c, int n, X* w) {
+	int i, j, m, h;
+	X *sa, *sb, *p;
+
+	if (n <= 16) {
+		for (i=0; i<2*n-1; i++) c[i] = 0.;
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				c[i+j] += a[i] * b[j];
+			}
+		}
+		return;
+	}
+
+	// a = a0 + t^m a1, b = b0 + t^m b1
+	m = (n + 1) / 2;
+	h = n - m;
+
+	karatsuba(a, b, c, m, w);
+	c[2*m-1] = 0.;
+	karatsuba(a + m, b + m, c + 2*m, h, w);
+
+	// (a0 + a1) (b0 + b1) - a0 b0 - a1 b1
+	sa = w;
+	sb = w + m;
+	p = w + 2*m;
+	for (i=0; i<m; i++) {
+		sa[i] = a[i];
+		sb[i] = b[i];
+		if (i < h) {
+			sa[i] += a[m+i];
+			sb[i] += b[m+i];
+		}
+	}
+	karatsuba(sa, sb, p, m, w + 4*m - 1);
+	for (i=0; i<2*m-1; i++) p[i] -= c[i];
+	for (i=0; i<2*h-1; i++) p[i] -= c[2*m+i];
+	for (i=0; i<2*m-1; i++) c[m+i] += p[i];
+}
+
+// interval<double> for the radii. it depends on T so that the
+// operators of interval<double> are looked up at the instantiation
+template <class T> struct radius_type {
+	typedef interval<double> type;
+};
+
+// upper bound of x as double
+template <class T> inline double double_up(const T& x) {
+	double d = x;
+	return std::nextafter(d, std::numeric_limits<double>::infinity());
+}
+
+// exponent of |x|, or INT_MIN for 0
+template <class T> inline int exponent(const T& x) {
+	int e;
+	using std::frexp;
+	if (x == 0.) return std::numeric_limits<int>::min();
+	frexp(x, &e);
+	return e;
+}
+
+// g such that |x(k)| 2^(g k) is roughly uniform
+template <class V> inline bool decay_rate(const V& x, double& g) {
+	int k, k0 = -1, k1 = -1, e, e0 = 0, e1 = 0;
+
+	for (k=0; k<(int)x.size(); k++) {
+		e = exponent(mag(x(k)));
+		if (e == std::numeric_limits<int>::min()) continue;
+		if (k0 < 0) {
+			k0 = k;
+			e0 = e;
+		}
+		k1 = k;
+		e1 = e;
+	}
+	if (k1 <= k0) return false;
+	g = (double)(e0 - e1) / (k1 - k0);
+	return true;
+}
+
+} // namespace psa_sub
+
+template <class T> struct psa_mul {
+	static const bool enabled = false;
+	template <class V> static void mul(const V& a, const V& b, V& c) {
+	}
+};
+
+template <class T> struct psa_mul< interval<T> > {
+	static const bool enabled = !boost::is_same<T, double>::value && !boost::is_same<T, dd>::value;
+
+	template <class V> static void mul(const V& a, const V& b, V& c) {
+		typedef typename psa_sub::radius_type<T>::type R;
+		int s = a.size();
+		int n = 2 * s - 1;
+		int i;
+		double g, ga, gb, q;
+		bool fa, fb, ok;
+		std::vector< interval<T> > sc(s), isc(s), ma(s), mb(s), mc(n), w(4 * s + 64);
+		std::vector<R> am(s), ar(s), bm(s), br(s), r1(n), r2(n), w2(4 * s + 64);
+		interval<T> tmp;
+		T m, r;
+
+		using std::abs;
+
+		// scaling factors sc(k) = q^k, isc(k) = q^(-k), q = 2^g
+		fa = psa_sub::decay_rate(a, ga);
+		fb = psa_sub::decay_rate(b, gb);
+		if (fa && fb) g = (ga + gb) * 0.5;
+		else if (fa) g = ga;
+		else if (fb) g = gb;
+		else g = 0.;
+		g = std::max(-1000., std::min(1000., g));
+		while (true) {
+			if (std::fabs(g) < 0.5) g = 0.;
+			q = std::pow(2., g);
+			sc[0] = 1.;
+			isc[0] = 1.;
+			for (i=1; i<s; i++) {
+				sc[i] = sc[i-1] * q;
+				isc[i] = isc[i-1] / q;
+			}
+			// avoid overflow and underflow for the types with
+			// small exponent range
+			ok = mag(sc[s-1]) < std::numeric_limits<double>::infinity() && mig(sc[s-1]) > 0. && mag(isc[s-1]) < std::numeric_limits<double>::infinity() && mig(isc[s-1]) > 0.;
+			if (ok || g == 0.) break;
+			g *= 0.5;
+		}
+
+		for (i=0; i<s; i++) {
+			tmp = a(i) * sc[i];
+			midrad(tmp, m, r);
+			ma[i] = m;
+			am[i] = psa_sub::double_up(abs(m));
+			ar[i] = psa_sub::double_up(r);
+
+			tmp = b(i) * sc[i];
+			midrad(tmp, m, r);
+			mb[i] = m;
+			bm[i] = psa_sub::double_up(abs(m));
+			br[i] = psa_sub::double_up(r);
+			bm[i] += br[i];
+		}
+
+		psa_sub::karatsuba(&ma[0], &mb[0], &mc[0], s, &w[0]);
+		psa_sub::karatsuba(&am[0], &br[0], &r1[0], s, &w2[0]);
+		psa_sub::karatsuba(&ar[0], &bm[0], &r2[0], s, &w2[0]);
+
+		c.resize(n);
+		for (i=0; i<n; i++) {
+			r1[i] += r2[i];
+			tmp = interval<T>(-r1[i].upper(), r1[i].upper());
+			// q^(-i) may be out of range, multiply in two steps
+			c(i) = (mc[i] + tmp) * isc[i/2] * isc[i-i/2];
+		}
+	}
+};
+
 template <class T> class psa {
 	public:
-	ub::vector<T> v;
+	#if PSA_POOL == 1
+	typedef ub::vector< T, ub::unbounded_array< T, pool_allocator<T> > > vector_type;
+	#else
+	typedef ub::vector<T> vector_type;
+	#endif
+
+	vector_type v;
 
 	typedef T base_type;
 
@@ -61,16 +372,16 @@ template <class T> class psa {
 	}
 
 
-	static std::list<psa>& history() {
+	static psa_tape<T>& history() {
 #ifdef _OPENMP // hack for non-POD thread local storage
-		static std::list<psa>* hist = NULL;
+		static psa_tape<T>* hist = NULL;
 		#pragma omp threadprivate (hist)
 		if (hist == NULL) {
-			hist = new std::list<psa>();
+			hist = new psa_tape<T>();
 		}
 		return *hist;
 #else
-		static std::list<psa> hist;
+		static psa_tape<T> hist;
 		return hist;
 #endif
 	}
@@ -91,6 +402,45 @@ template <class T> class psa {
 		return uh;
 	}
 
+	// resize r to s and copy known coefficients from the record of
+	// this operation. returns the number of copied coefficients.
+	static int read_history(psa& r, int s) {
+		const std::vector<T>& h = history().front();
+		int i, n;
+
+		n = std::min((int)h.size(), s);
+		if (mode() == 2) {
+			n = std::min(n, s - 1);
+		}
+		r.v.resize(s);
+		for (i=0; i<n; i++) r.v(i) = h[i];
+		return n;
+	}
+
+	// consume the record of this operation and record r.
+	// first n coefficients of r are same as the consumed record.
+	static void update_history(const psa& r, int n) {
+		std::vector<T>* used = NULL;
+		int i, s;
+
+		if (use_history() == true) {
+			used = &history().pop_front();
+		} else {
+			n = 0;
+		}
+
+		if (record_history() == true) {
+			std::vector<T>& h = history().push_back();
+			if (used != NULL) h.swap(*used);
+			s = r.v.size();
+			// last coefficient is not reusable in mode 2
+			if (mode() == 2) s--;
+			n = std::min(n, s);
+			h.resize(s);
+			for (i=n; i<s; i++) h[i] = r.v(i);
+		}
+	}
+
 	psa() {
 		v.resize(1);
 		v(0) = 0.;
@@ -109,6 +459,7 @@ template <class T> class psa {
 
 	friend psa operator+(const psa& a, const psa& b) {
 		psa r;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			r.v = b.v;
@@ -118,13 +469,8 @@ template <class T> class psa {
 			r.v(0) += b.v(0);
 		} else {
 			if (use_history() == true) {
-				r = history().front();
-				int old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
+				old_size = read_history(r, a.v.size());
 				int i;
-				r.v.resize(a.v.size(), true);
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) + b.v(i);
 				}
@@ -133,19 +479,7 @@ template <class T> class psa {
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -180,6 +514,7 @@ template <class T> class psa {
 
 	friend psa operator-(const psa& a, const psa& b) {
 		psa r;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			r.v = - b.v;
@@ -189,13 +524,8 @@ template <class T> class psa {
 			r.v(0) -= b.v(0);
 		} else {
 			if (use_history() == true) {
-				r = history().front();
-				int old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
+				old_size = read_history(r, a.v.size());
 				int i;
-				r.v.resize(a.v.size(), true);
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) - b.v(i);
 				}
@@ -204,19 +534,7 @@ template <class T> class psa {
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -259,18 +577,12 @@ template <class T> class psa {
 
 	friend psa operator*(const psa& a, const psa& b) {
 		psa r;
-		int i, j, s;
-		T sum;
-		int old_size;
+		int i, s;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)b.v.size() - 1);
-				}
-				r.v.resize(b.v.size(), true);
+				old_size = read_history(r, b.v.size());
 				for (i=old_size; i<b.v.size(); i++) {
 					r.v(i) = a.v(0) * b.v(i);
 				}
@@ -279,12 +591,7 @@ template <class T> class psa {
 			}
 		} else if (b.v.size() == 1) {
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
-				r.v.resize(a.v.size(), true);
+				old_size = read_history(r, a.v.size());
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) * b.v(0);
 				}
@@ -294,68 +601,49 @@ template <class T> class psa {
 		} else {
 			s = a.v.size();
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)s - 1);
-				}
-				r.v.resize(s, true);
+				old_size = read_history(r, s);
 			} else {
-				old_size = 0;
 				r.v.resize(s);
 			}
-			for (i=old_size; i<s; i++) {
-				sum = 0.;
-				for (j=0; j<=i; j++) {
-					sum += a.v(j) * b.v(i-j);
+			if (psa_mul<T>::enabled && s >= PSA_KARATSUBA_MIN && (mode() == 2 || s - old_size >= PSA_KARATSUBA_MIN)) {
+				vector_type c;
+				psa_mul<T>::mul(a.v, b.v, c);
+				for (i=old_size; i<s; i++) {
+					r.v(i) = c(i);
+				}
+				if (mode() == 2) {
+					r.v(s-1) = polyrange(c, s-1, 2*s-2, domain());
+				}
+			} else {
+				for (i=old_size; i<s; i++) {
+					r.v(i) = psa_dot<T>::conv(a.v, b.v, i, 0, i);
 				}
-				r.v(i) = sum;
-			}
 
-			if (mode() == 2) {
-				// history may be able to be used for
-				// calculating tmp, but we do not use yet.
-				ub::vector<T> tmp(s);
-				tmp(0) = r.v(s-1);
-				for (i=1; i<s; i++) {
-					sum = 0.;
-					for (j=i; j<s; j++) {
-						sum += a.v(j) * b.v(i-j+s-1);
+				if (mode() == 2) {
+					// history may be able to be used for
+					// calculating tmp, but we do not use yet.
+					vector_type tmp(s);
+					tmp(0) = r.v(s-1);
+					for (i=1; i<s; i++) {
+						tmp(i) = psa_dot<T>::conv(a.v, b.v, i+s-1, i, s-1);
 					}
-					tmp(i) = sum;
+					r.v(s-1) = polyrange(tmp, 0, s-1, domain());
 				}
-				r.v(s-1) = polyrange(tmp, 0, s-1, domain());
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, psa>::value, psa >::type operator*(const psa& a, const C& b) {
 		psa r;
+		int old_size = 0;
 
 		if (use_history() == true) {
-			r = history().front();
-			int old_size = r.v.size();
-			if (mode() == 2) {
-				old_size = std::min(old_size, (int)a.v.size() - 1);
-			}
+			old_size = read_history(r, a.v.size());
 			int i;
-			r.v.resize(a.v.size(), true);
 			for (i=old_size; i<a.v.size(); i++) {
 				r.v(i) = a.v(i) * b;
 			}
@@ -364,34 +652,18 @@ template <class T> class psa {
 			r.v = a.v * T(b); // assist for VC++
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, psa>::value, psa >::type operator*(const C& a, const psa& b) {
 		psa r;
+		int old_size = 0;
 
 		if (use_history() == true) {
-			r = history().front();
-			int old_size = r.v.size();
-			if (mode() == 2) {
-				old_size = std::min(old_size, (int)b.v.size() - 1);
-			}
+			old_size = read_history(r, b.v.size());
 			int i;
-			r.v.resize(b.v.size(), true);
 			for (i=old_size; i<b.v.size(); i++) {
 				r.v(i) = a * b.v(i);
 			}
@@ -400,19 +672,7 @@ template <class T> class psa {
 			r.v = T(a) * b.v; // assist for VC++
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -454,341 +714,497 @@ template <class T> class psa {
 		return a;
 	}
 
-	friend psa inv(const psa& x) {
-		T a, xn, xn2, range;
-		psa h, hn, r;
+	/*
+	 * inv, sin, cos, exp, sqrt and log are computed by the recurrences
+	 * of the Taylor coefficients, so that all the coefficients cost
+	 * O(N^2) (and O(N) for each new coefficient with the history).
+	 * each call uses exactly one history record.
+	 *
+	 * for type-II psa, x(t) = p(t) + x(n) t^n (n = size - 1), the
+	 * coefficients 0, ..., n-1 are same as type-I. let F_k be the
+	 * Taylor coefficients of f(p(t)). the last coefficient is
+	 *   sum_{k=n}^{2n-1} F_k t^(k-n) + F_2n(domain) t^n + f'(range) x(n)
+	 * evaluated on the domain, where F_2n(domain) is computed by the
+	 * same recurrence with the coefficients of p(domain + u) in u
+	 * (shift_domain) and range contains x(t) and p(t). like the
+	 * multiplication, the terms up to t^(2n-1) are folded by polyrange.
+	 * this is much tighter than the composition with the Lagrange
+	 * remainder (lagrange_coef) when the domain is small compared with
+	 * the radius of convergence (as in ode), and wider when it is not,
+	 * so the two are intersected if psa_intersect is enabled. otherwise
+	 * only the latter is used.
+	 * the domain must contain 0 (same as evalrange based remainders).
+	 */
+
+	// number of coefficients computed by the recurrence
+	static int coef_size(int s) {
+		if (mode() == 2 && s > 1) return s - 1;
+		return s;
+	}
+
+	// y(k) = x(k) for k < n, 0 for n <= k <= m
+	static void truncate_coef(const vector_type& x, int n, int m, vector_type& y) {
 		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
 
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+		y.resize(m + 1);
+		for (i=0; i<n; i++) y(i) = x(i);
+		for (i=n; i<=m; i++) y(i) = 0.;
+	}
 
-		r = 1./a;
-		hn = 1.;
-		xn = 1./a;
-		if (mode() == 2) {
-			range = evalrange(x);
-			xn2 = 1./range;
-		}
-		if (use_history() == true) {
-			old_size = history().front().v.size();
-		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
+	// coefficients q(k) (k = 0, ..., m) of sum_{j<n} x(j) (d + u)^j
+	// in u, which contain the values for all d in the domain.
+	static void shift_domain(const vector_type& x, int n, int m, vector_type& q) {
+		int i, j;
+
+		truncate_coef(x, n, m, q);
+		for (i=0; i<n-1; i++) {
+			for (j=n-2; j>=i; j--) {
+				q(j) += domain() * q(j+1);
 			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				// scaling: hn->hn/a^i, xn->xn*a^i
-				// hn *= h;
-				hn *= h / a;
-				// xn2 = -xn2 / range;
-				xn2 = -xn2 / range * a;
-				r += xn2 * hn;
-			} else {
-				// hn *= h;
-				hn *= h / a;
-				// xn = -xn / a;
-				xn = -xn;
-				if (mode() == 2) {
-					// xn2 = -xn2 / range;
-					xn2 = -xn2 / range * a;
-				}
-				r += xn * hn;
+		}
+	}
+
+	// range of p(t) + theta x(n) t^n, t in domain, 0 <= theta <= 1
+	// (q(0) is the range of p)
+	static T remainder_range(const vector_type& q, const vector_type& x, int n) {
+		T dn;
+		int i;
+
+		dn = 1.;
+		for (i=0; i<n; i++) dn *= domain();
+		return q(0) + x(n) * dn;
+	}
+
+	// sum_{k=n}^{2n-1} rp(k) t^(k-n) + rq(2n) t^n on the domain, where
+	// rp and rq are the Taylor coefficients at 0 and at the domain.
+	// the expansions with rq(n+K) (K = 0, ..., n-1) are also valid, so
+	// they are intersected if psa_intersect is enabled.
+	static T remainder_coef(vector_type& rp, const vector_type& rq, int n) {
+		T r, tmp;
+		int i;
+
+		rp(2 * n) = rq(2 * n);
+		r = polyrange(rp, n, 2 * n, domain());
+		if (psa_intersect<T>::enabled) {
+			for (i=n; i<2*n; i++) {
+				tmp = rp(i);
+				rp(i) = rq(i);
+				r = psa_intersect<T>::f(r, polyrange(rp, n, i, domain()));
+				rp(i) = tmp;
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
+		return r;
+	}
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+	// c = a * b in type-II with m = size coefficients
+	static void mul_type2(const vector_type& a, const vector_type& b, int m, vector_type& c) {
+		vector_type tmp;
+		int i;
+
+		c.resize(m);
+		for (i=0; i<m-1; i++) c(i) = psa_dot<T>::conv(a, b, i, 0, i);
+		tmp.resize(m);
+		for (i=0; i<m; i++) tmp(i) = psa_dot<T>::conv(a, b, i + m - 1, i, m - 1);
+		c(m-1) = polyrange(tmp, 0, m - 1, domain());
 	}
 
-	friend psa sin (const psa& x) {
-		T a, xn, xn2, range, fact_n, table[4], tmp;
-		psa h, hn, r;
+	// the last coefficient of sum_{j<n} c(j) h^j + c(n) h^n in type-II
+	// (h = x - x(0)), i.e. the composition with the Lagrange remainder
+	// where c(j) (j < n) are the Taylor coefficients of f at x(0) and
+	// c(n) is the n-th one at evalrange(x). h = t g is expanded by the
+	// Horner scheme q = c(j) + t g q, where q needs only n - j
+	// coefficients, so this costs about n^3/3 multiplications.
+	static T lagrange_coef(const vector_type& x, const vector_type& c, int n) {
+		vector_type g, p, q;
+		int i, j, m;
+
+		q.resize(1);
+		q(0) = c(n);
+		g.resize(n);
+		for (j=n-1; j>=0; j--) {
+			m = n - j;
+			for (i=0; i<m-1; i++) g(i) = x(i+1);
+			g(m-1) = polyrange(x, m, n, domain());
+			mul_type2(g, q, m, p);
+			q.resize(m + 1);
+			q(0) = c(j);
+			for (i=0; i<m; i++) q(i+1) = p(i);
+		}
+		return q(n);
+	}
+
+	// u = a + t with n + 1 coefficients
+	static void unit_coef(const T& a, int n, vector_type& u) {
 		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
 
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+		u.resize(n + 1);
+		u(0) = a;
+		u(1) = 1.;
+		for (i=2; i<=n; i++) u(i) = 0.;
+	}
 
-		using std::sin;
-		using std::cos;
+	typedef void (*coef_func)(const vector_type&, vector_type&, int, int);
+
+	// c for lagrange_coef computed by the recurrence f with
+	// fa = f(a) and fb = f(b), where a = x(0) and b = evalrange(x)
+	static void lagrange_taylor(coef_func f, const T& a, const T& fa, const T& b, const T& fb, int n, vector_type& c) {
+		vector_type u, cb;
+
+		unit_coef(a, n, u);
+		c.resize(n + 1);
+		c(0) = fa;
+		f(u, c, 1, n - 1);
+		unit_coef(b, n, u);
+		cb.resize(n + 1);
+		cb(0) = fb;
+		f(u, cb, 1, n);
+		c(n) = cb(n);
+	}
 
-		table[0] = sin(a);
-		table[1] = cos(a);
-		table[2] = -table[0];
-		table[3] = -table[1];
+	// d(j) = j * x(j) for j = 0, ..., n-1
+	static void deriv_coef(const vector_type& x, int n, vector_type& d) {
+		int j;
+
+		d.resize(n);
+		if (n > 0) d(0) = 0.;
+		for (j=1; j<n; j++) d(j) = (double)j * x(j);
+	}
+
+	// the recurrences below compute r(k) for k = i0, ..., i1 (i0 >= 1)
+	// from r(0), ..., r(k-1) and x(0), ..., x(k).
+
+	// r = 1 / x : x r = 1
+	static void inv_coef(const vector_type& x, vector_type& r, int i0, int i1) {
+		int k;
+
+		for (k=i0; k<=i1; k++) {
+			r(k) = -psa_dot<T>::conv(x, r, k, 1, k) / x(0);
+		}
+	}
+
+	// r = exp(x) : r' = x' r
+	static void exp_coef(const vector_type& x, vector_type& r, int i0, int i1) {
+		vector_type dx;
+		int k;
+
+		deriv_coef(x, i1 + 1, dx);
+		for (k=i0; k<=i1; k++) {
+			r(k) = psa_dot<T>::conv(dx, r, k, 1, k) / (double)k;
+		}
+	}
+
+	// r = log(x) : x r' = x'
+	static void log_coef(const vector_type& x, vector_type& r, int i0, int i1) {
+		vector_type dr;
+		int k;
+
+		deriv_coef(r, i0, dr);
+		dr.resize(i1 + 1);
+		for (k=i0; k<=i1; k++) {
+			r(k) = (x(k) - psa_dot<T>::conv(dr, x, k, 1, k-1) / (double)k) / x(0);
+			dr(k) = (double)k * r(k);
+		}
+	}
+
+	// r = sqrt(x) : r r = x
+	static void sqrt_coef(const vector_type& x, vector_type& r, int i0, int i1) {
+		int k;
+
+		for (k=i0; k<=i1; k++) {
+			r(k) = (x(k) - psa_dot<T>::conv(r, r, k, 1, k-1)) / (2. * r(0));
+		}
+	}
+
+	// rs = sin(x), rc = cos(x) : rs' = x' rc, rc' = -x' rs
+	static void sincos_coef(const vector_type& x, vector_type& rs, vector_type& rc, int i0, int i1) {
+		vector_type dx;
+		int k;
+
+		deriv_coef(x, i1 + 1, dx);
+		for (k=i0; k<=i1; k++) {
+			rs(k) = psa_dot<T>::conv(dx, rc, k, 1, k) / (double)k;
+			rc(k) = -psa_dot<T>::conv(dx, rs, k, 1, k) / (double)k;
+		}
+	}
+
+	// read_history and update_history for sin and cos, which record
+	// both sequences alternately in one record.
+	static int read_history2(psa& r1, psa& r2, int s) {
+		const std::vector<T>& h = history().front();
+		int i, n;
+
+		n = std::min((int)h.size() / 2, s);
+		if (mode() == 2) {
+			n = std::min(n, s - 1);
+		}
+		r1.v.resize(s);
+		r2.v.resize(s);
+		for (i=0; i<n; i++) {
+			r1.v(i) = h[2*i];
+			r2.v(i) = h[2*i+1];
+		}
+		return n;
+	}
+
+	static void update_history2(const psa& r1, const psa& r2, int n) {
+		std::vector<T>* used = NULL;
+		int i, s;
 
-		r = table[0];
-		hn = 1.;
-		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			used = &history().pop_front();
+		} else {
+			n = 0;
 		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
+
+		if (record_history() == true) {
+			std::vector<T>& h = history().push_back();
+			if (used != NULL) h.swap(*used);
+			s = r1.v.size();
+			if (mode() == 2) s--;
+			n = std::min(n, s);
+			h.resize(2 * s);
+			for (i=n; i<s; i++) {
+				h[2*i] = r1.v(i);
+				h[2*i+1] = r2.v(i);
 			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				hn *= h;
-				fact_n /= (double)i;
-				range = evalrange(x);
-				switch (i%4) {
-				case 0: tmp = sin(range); break;
-				case 1: tmp = cos(range); break;
-				case 2: tmp = -sin(range); break;
-				case 3: tmp = -cos(range); break;
-				}
-				r += fact_n * tmp * hn;
-			} else {
-				hn *= h;
-				fact_n /= (double)i;
-				r += fact_n * table[i % 4] * hn;
+		}
+	}
+
+	friend psa inv(const psa& x) {
+		psa r;
+		vector_type xp, rp, q, rq, c;
+		T range;
+		int s = x.v.size();
+		int n, old_size;
+
+		if (use_history() == true) {
+			old_size = read_history(r, s);
+		} else {
+			r.v.resize(s);
+			old_size = 0;
+		}
+		n = coef_size(s);
+
+		if (old_size == 0) r.v(0) = 1. / x.v(0);
+		inv_coef(x.v, r.v, std::max(old_size, 1), n - 1);
+
+		if (n < s) {
+			range = evalrange(x);
+			lagrange_taylor(inv_coef, x.v(0), r.v(0), range, 1. / range, n, c);
+			r.v(n) = lagrange_coef(x.v, c, n);
+			if (psa_intersect<T>::enabled) {
+				truncate_coef(x.v, n, 2 * n, xp);
+				truncate_coef(r.v, n, 2 * n, rp);
+				inv_coef(xp, rp, n, 2 * n - 1);
+				shift_domain(x.v, n, 2 * n, q);
+				rq.resize(2 * n + 1);
+				rq(0) = 1. / q(0);
+				inv_coef(q, rq, 1, 2 * n);
+				range = remainder_range(q, x.v, n);
+				r.v(n) = psa_intersect<T>::f(r.v(n), remainder_coef(rp, rq, n) - x.v(n) / (range * range));
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+		update_history(r, old_size);
+		return r;
 	}
 
-	friend psa cos (const psa& x) {
-		T a, xn, xn2, range, fact_n, table[4], tmp;
-		psa h, hn, r;
-		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
-
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+	static void sin_cos(const psa& x, psa& rs, psa& rc) {
+		vector_type xp, sp, cp, q, sq, cq, u;
+		T range;
+		int s = x.v.size();
+		int n, old_size;
 
 		using std::sin;
 		using std::cos;
 
-		table[0] = cos(a);
-		table[1] = -sin(a);
-		table[2] = -table[0];
-		table[3] = -table[1];
-
-		r = table[0];
-		hn = 1.;
-		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
-		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
-			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				hn *= h;
-				fact_n /= (double)i;
-				range = evalrange(x);
-				switch (i%4) {
-				case 0: tmp = cos(range); break;
-				case 1: tmp = -sin(range); break;
-				case 2: tmp = -cos(range); break;
-				case 3: tmp = sin(range); break;
-				}
-				r += fact_n * tmp * hn;
-			} else {
-				hn *= h;
-				fact_n /= (double)i;
-				r += fact_n * table[i % 4] * hn;
+			old_size = read_history2(rs, rc, s);
+		} else {
+			rs.v.resize(s);
+			rc.v.resize(s);
+			old_size = 0;
+		}
+		n = coef_size(s);
+
+		if (old_size == 0) {
+			rs.v(0) = sin(x.v(0));
+			rc.v(0) = cos(x.v(0));
+		}
+		sincos_coef(x.v, rs.v, rc.v, std::max(old_size, 1), n - 1);
+
+		if (n < s) {
+			// lagrange_taylor for sin and cos
+			unit_coef(x.v(0), n, u);
+			sp.resize(n + 1);
+			cp.resize(n + 1);
+			sp(0) = rs.v(0);
+			cp(0) = rc.v(0);
+			sincos_coef(u, sp, cp, 1, n - 1);
+			range = evalrange(x);
+			unit_coef(range, n, u);
+			sq.resize(n + 1);
+			cq.resize(n + 1);
+			sq(0) = sin(range);
+			cq(0) = cos(range);
+			sincos_coef(u, sq, cq, 1, n);
+			sp(n) = sq(n);
+			cp(n) = cq(n);
+			rs.v(n) = lagrange_coef(x.v, sp, n);
+			rc.v(n) = lagrange_coef(x.v, cp, n);
+			if (psa_intersect<T>::enabled) {
+				truncate_coef(x.v, n, 2 * n, xp);
+				truncate_coef(rs.v, n, 2 * n, sp);
+				truncate_coef(rc.v, n, 2 * n, cp);
+				sincos_coef(xp, sp, cp, n, 2 * n - 1);
+				shift_domain(x.v, n, 2 * n, q);
+				sq.resize(2 * n + 1);
+				cq.resize(2 * n + 1);
+				sq(0) = sin(q(0));
+				cq(0) = cos(q(0));
+				sincos_coef(q, sq, cq, 1, 2 * n);
+				range = remainder_range(q, x.v, n);
+				rs.v(n) = psa_intersect<T>::f(rs.v(n), remainder_coef(sp, sq, n) + cos(range) * x.v(n));
+				rc.v(n) = psa_intersect<T>::f(rc.v(n), remainder_coef(cp, cq, n) - sin(range) * x.v(n));
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+		update_history2(rs, rc, old_size);
 	}
 
-	friend psa exp (const psa& x) {
-		T a, xn, xn2, range, fact_n, ea;
-		psa h, hn, r;
-		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
+	friend psa sin (const psa& x) {
+		psa rs, rc;
 
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+		sin_cos(x, rs, rc);
+		return rs;
+	}
 
-		using std::exp;
+	friend psa cos (const psa& x) {
+		psa rs, rc;
 
-		ea = exp(a);
+		sin_cos(x, rs, rc);
+		return rc;
+	}
+
+	friend psa exp (const psa& x) {
+		psa r;
+		vector_type xp, rp, q, rq, c;
+		T range;
+		int s = x.v.size();
+		int n, old_size;
+
+		using std::exp;
 
-		r = ea;
-		hn = 1.;
-		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = read_history(r, s);
+		} else {
+			r.v.resize(s);
+			old_size = 0;
 		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
-			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				hn *= h;
-				fact_n /= (double)i;
-				range = evalrange(x);
-				r += fact_n * exp(range) * hn;
-			}else {
-				hn *= h;
-				fact_n /= (double)i;
-				r += fact_n * ea * hn;
+		n = coef_size(s);
+
+		if (old_size == 0) r.v(0) = exp(x.v(0));
+		exp_coef(x.v, r.v, std::max(old_size, 1), n - 1);
+
+		if (n < s) {
+			range = evalrange(x);
+			lagrange_taylor(exp_coef, x.v(0), r.v(0), range, exp(range), n, c);
+			r.v(n) = lagrange_coef(x.v, c, n);
+			if (psa_intersect<T>::enabled) {
+				truncate_coef(x.v, n, 2 * n, xp);
+				truncate_coef(r.v, n, 2 * n, rp);
+				exp_coef(xp, rp, n, 2 * n - 1);
+				shift_domain(x.v, n, 2 * n, q);
+				rq.resize(2 * n + 1);
+				rq(0) = exp(q(0));
+				exp_coef(q, rq, 1, 2 * n);
+				r.v(n) = psa_intersect<T>::f(r.v(n), remainder_coef(rp, rq, n) + exp(remainder_range(q, x.v, n)) * x.v(n));
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+		update_history(r, old_size);
+		return r;
 	}
 
 	friend psa sqrt(const psa& x) {
-		T a, xn, xn2, sqrt_a, range;
-		psa h, hn, r;
-		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
-
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+		psa r;
+		vector_type xp, rp, q, rq, c;
+		T range;
+		int s = x.v.size();
+		int n, old_size;
 
 		using std::sqrt;
 
-		sqrt_a = sqrt(a);
-
-		r = sqrt_a;
-		hn = 1.;
-		xn = 1./(2. * sqrt_a);
-		if (mode() == 2) {
-			range = evalrange(x);
-			xn2 = 1./(2. * sqrt(range));
-		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = read_history(r, s);
+		} else {
+			r.v.resize(s);
+			old_size = 0;
 		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
-			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				hn *= h;
-				r += xn2 * hn;
-			} else {
-				hn *= h;
-				r += xn * hn;
-				xn *= (1./2. - i) / a / (i + 1.);
-				if (mode() == 2) {
-					xn2 *= (1./2. - i) / range / (i + 1.);
-				}
+		n = coef_size(s);
+
+		if (old_size == 0) r.v(0) = sqrt(x.v(0));
+		sqrt_coef(x.v, r.v, std::max(old_size, 1), n - 1);
+
+		if (n < s) {
+			range = evalrange(x);
+			lagrange_taylor(sqrt_coef, x.v(0), r.v(0), range, sqrt(range), n, c);
+			r.v(n) = lagrange_coef(x.v, c, n);
+			if (psa_intersect<T>::enabled) {
+				truncate_coef(x.v, n, 2 * n, xp);
+				truncate_coef(r.v, n, 2 * n, rp);
+				sqrt_coef(xp, rp, n, 2 * n - 1);
+				shift_domain(x.v, n, 2 * n, q);
+				rq.resize(2 * n + 1);
+				rq(0) = sqrt(q(0));
+				sqrt_coef(q, rq, 1, 2 * n);
+				r.v(n) = psa_intersect<T>::f(r.v(n), remainder_coef(rp, rq, n) + x.v(n) / (2. * sqrt(remainder_range(q, x.v, n))));
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+		update_history(r, old_size);
+		return r;
 	}
 
 	friend psa log(const psa& x) {
-		T a, xn, xn2, range;
-		psa h, hn, r;
-		int i;
-		int old_size;
-		bool recover_uh = false;
-		bool recover_rh = false;
-
-		a = x.v(0);
-		// h = x - a;
-		h = x; h.v(0) = 0.;
+		psa r;
+		vector_type xp, rp, q, rq, c;
+		T range;
+		int s = x.v.size();
+		int n, old_size;
 
 		using std::log;
 
-		r = log(a);
-		hn = 1.;
-		xn = -1.;
-		if (mode() == 2) {
-			range = evalrange(x);
-			xn2 = -1.;
-		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = read_history(r, s);
+		} else {
+			r.v.resize(s);
+			old_size = 0;
 		}
-		for (i=1; i<x.v.size(); i++) {
-			if (use_history() == true && i >= old_size) {
-				use_history() = false;
-				recover_uh = true;
-			}
-			if (mode() == 2 && i == x.v.size() - 1) {
-				if (record_history() == true) {
-					record_history() = false;
-					recover_rh = true;
-				}
-				hn *= h;
-				xn2 = -xn2 / range;
-				r += xn2 / (double)i * hn;
-			} else {
-				hn *= h;
-				xn = -xn / a;
-				if (mode() == 2) {
-					xn2 = -xn2 / range;
-				}
-				r += xn / (double)i * hn;
+		n = coef_size(s);
+
+		// the product turns [-0,0] = log([1,1]) into [0,0]
+		if (old_size == 0) r.v(0) = log(x.v(0)) * T(1.);
+		log_coef(x.v, r.v, std::max(old_size, 1), n - 1);
+
+		if (n < s) {
+			range = evalrange(x);
+			lagrange_taylor(log_coef, x.v(0), r.v(0), range, log(range), n, c);
+			r.v(n) = lagrange_coef(x.v, c, n);
+			if (psa_intersect<T>::enabled) {
+				truncate_coef(x.v, n, 2 * n, xp);
+				truncate_coef(r.v, n, 2 * n, rp);
+				log_coef(xp, rp, n, 2 * n - 1);
+				shift_domain(x.v, n, 2 * n, q);
+				rq.resize(2 * n + 1);
+				rq(0) = log(q(0));
+				log_coef(q, rq, 1, 2 * n);
+				r.v(n) = psa_intersect<T>::f(r.v(n), remainder_coef(rp, rq, n) + x.v(n) / remainder_range(q, x.v, n));
 			}
 		}
-		if (recover_uh) use_history() = true;
-		if (recover_rh) record_history() = true;
 
-		// dirty hack
-		// to ensure that history buffer will be used at least once.
-		return r * 1.;
+		update_history(r, old_size);
+		return r;
 	}
 
 	friend psa sinh (const psa& x) {
@@ -813,7 +1229,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -869,7 +1285,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -942,7 +1358,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1004,7 +1420,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1065,7 +1481,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1127,7 +1543,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1189,7 +1605,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1250,7 +1666,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1297,7 +1713,7 @@ template <class T> class psa {
 			xn2 = y * pow(range, y - 1);
 		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1435,7 +1851,7 @@ template <class T> class psa {
 	/*
 	 *  evaluate { p[x] + p[x+1]t + ... p[y]t^(y-x) | a \in d }
 	 */
-	template <class T1> static T1 inline polyrange (const ub::vector<T>& p, int x, int y, const T1& d)
+	template <class V, class T1> static T1 inline polyrange (const V& p, int x, int y, const T1& d)
 	{
 		int i;
 		T1 r;
@@ -0,0 +1,688 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef RDOUBLE_ELEMENTARY_HPP
+#define RDOUBLE_ELEMENTARY_HPP
+
+// table driven exp, log and fast sin, cos, tan for interval<double>
+//
+// exp: x = k * ln2/64 + r, |r| <= ln2/128 (Cody-Waite reduction)
+//      exp(x) = 2^(k/64) * exp(r)
+//      2^(j/64) (j=0,...,63) are stored as hi + [lo]
+//      exp(r) - 1 is computed by Taylor polynomial of degree 6
+//      with remainder term.
+// log: x = 2^e * m, sqrt(2)/2 <= m < sqrt(2), m = c * (1 + u),
+//      c = 1 + j/64, |u| < 1/90
+//      log(x) = e * ln2 + log(c) + log1p(u)
+//      log(c) (j=-20,...,28) are stored as hi + [lo]
+//      log1p(u) is computed by Taylor polynomial of degree 9
+//      with remainder term.
+// sin, cos, tan:
+//      x = k * pi/2 + r, |r| <= pi/4 (+ rounding error)
+//      pi/2 = p1 + p2 + p3 + [p4], p1, p2, p3 have 30 significant bits,
+//      so k * p1, k * p2, k * p3 are exact for |k| < 2^23.
+//      sin(r) and cos(r) are computed by Taylor polynomials of degree
+//      17 and 16 with remainder terms.
+//      for |x| >= 1e7 the generic algorithm is used.
+//
+// All the computations are done by rop<double> between begin() and
+// end(), so the results are verified with every rounding backend.
+// The width of the results is 1 or 2 ulps.
+// The generic algorithm in interval.hpp is still used for other types.
+
+#include <cmath>
+#include <limits>
+#include <kv/interval.hpp>
+
+
+namespace kv {
+
+struct rdouble_elementary {
+
+	struct exp_table {
+		double hi[64], lo_inf[64], lo_sup[64];
+		double l1, l2_inf, l2_sup;
+		double c_inf[7], c_sup[7];
+
+		exp_table() {
+			static const char *s[64][3] = {
+				{"1", "0", "0"},
+				{"1.0108892860517004752551883939304389059543609619140625", "-1.523477860336857838156623e-17", "-1.523477860336857838156622e-17"},
+				{"1.02189714865411662714222984504885971546173095703125", "5.109225028973443972432040e-17", "5.109225028973443972432041e-17"},
+				{"1.0330248790212284148992694099433720111846923828125", "7.600838874027088906901842e-18", "7.600838874027088906901843e-18"},
+				{"1.0442737824274137548030694233602844178676605224609375", "8.551889705537964459091694e-17", "8.551889705537964459091695e-17"},
+				{"1.055645178360557157049015586380846798419952392578125", "1.759325738772091853739952e-18", "1.759325738772091853739953e-18"},
+				{"1.0671404006768236971680607894086278975009918212890625", "-7.899853966841581873489410e-17", "-7.899853966841581873489409e-17"},
+				{"1.07876079775711986030728439800441265106201171875", "-6.656660436056592969257111e-17", "-6.656660436056592969257110e-17"},
+				{"1.0905077326652576896748314538854174315929412841796875", "-3.046782079812470945260024e-17", "-3.046782079812470945260023e-17"},
+				{"1.1023825833078408908960454937187023460865020751953125", "5.266036871570694451142459e-17", "5.266036871570694451142460e-17"},
+				{"1.114386742595892432206028388463892042636871337890625", "1.041027845684557110251635e-16", "1.041027845684557110251636e-16"},
+				{"1.126521618608241848136231055832467973232269287109375", "5.165856758795456680440139e-17", "5.165856758795456680440140e-17"},
+				{"1.1387886347566915645757035235874354839324951171875", "8.912812676025407577078774e-17", "8.912812676025407577078775e-17"},
+				{"1.1511892299529826733106574465637095272541046142578125", "3.250710218863827300886603e-17", "3.250710218863827300886604e-17"},
+				{"1.1637248587775774755215252298512496054172515869140625", "3.829204836924093570692581e-17", "3.829204836924093570692582e-17"},
+				{"1.1763969916502812207426131863030605018138885498046875", "5.554203254218078813923913e-17", "5.554203254218078813923914e-17"},
+				{"1.1892071150027210268973476559040136635303497314453125", "3.982015231465646225176262e-17", "3.982015231465646225176263e-17"},
+				{"1.2021567314527030756465819649747572839260101318359375", "6.644981499252300859207447e-17", "6.644981499252300859207448e-17"},
+				{"1.2152473599804689552428271781536750495433807373046875", "-7.712630692681487659191958e-17", "-7.712630692681487659191957e-17"},
+				{"1.2284805361068700246818252708180807530879974365234375", "-1.898781631302529891272542e-17", "-1.898781631302529891272541e-17"},
+				{"1.241857812073484002013401550357230007648468017578125", "4.658027591836936559786257e-17", "4.658027591836936559786258e-17"},
+				{"1.255380757024691096290780478739179670810699462890625", "-6.711389821296878476212846e-18", "-6.711389821296878476212845e-18"},
+				{"1.2690509571917332198864869496901519596576690673828125", "2.667932131342186045057629e-18", "2.667932131342186045057630e-18"},
+				{"1.282870016078778263590720598585903644561767578125", "1.713594918243561040654906e-17", "1.713594918243561040654907e-17"},
+				{"1.2968395546510096405512513229041360318660736083984375", "2.538250279488831512796927e-17", "2.538250279488831512796928e-17"},
+				{"1.3109612115247644137383531415252946317195892333984375", "-7.181536135519453878235383e-17", "-7.181536135519453878235382e-17"},
+				{"1.325236643159741323216849195887334644794464111328125", "-2.858731210038861297068132e-17", "-2.858731210038861297068131e-17"},
+				{"1.339667524053302916087204721407033503055572509765625", "8.927282594831731907296756e-17", "8.927282594831731907296757e-17"},
+				{"1.3542555469368926512885309421108104288578033447265625", "7.700948379802989237548545e-17", "7.700948379802989237548546e-17"},
+				{"1.3690024229745905159916219417937099933624267578125", "9.593797919118848283880498e-17", "9.593797919118848283880499e-17"},
+				{"1.3839098819638320225777761152130551636219024658203125", "-6.770511658794786234561959e-17", "-6.770511658794786234561958e-17"},
+				{"1.3989796725383112363516602272284217178821563720703125", "-9.614213209051322674867611e-17", "-9.614213209051322674867610e-17"},
+				{"1.4142135623730951454746218587388284504413604736328125", "-9.667293313452913037187169e-17", "-9.667293313452913037187168e-17"},
+				{"1.4296133383919700232667082673287950456142425537109375", "-1.203164248905365513952708e-17", "-1.203164248905365513952707e-17"},
+				{"1.44518080697704665027458759141154587268829345703125", "-3.023758134993987496700986e-17", "-3.023758134993987496700985e-17"},
+				{"1.4609177941806470446550747510627843439579010009765625", "-5.600377186075216281080374e-17", "-5.600377186075216281080373e-17"},
+				{"1.4768261459394993462268530493020080029964447021484375", "-3.483994556892795807907281e-17", "-3.483994556892795807907280e-17"},
+				{"1.492907728291264835007723377202637493610382080078125", "1.419292015428403604806414e-17", "1.419292015428403604806415e-17"},
+				{"1.5091644275934228414115523264626972377300262451171875", "-1.016455327754295037063103e-16", "-1.016455327754295037063102e-16"},
+				{"1.5255981507445384171006708129425533115863800048828125", "-1.102494171234256123569769e-16", "-1.102494171234256123569768e-16"},
+				{"1.5422108254079407441139437651145271956920623779296875", "7.949834809697620764561475e-17", "7.949834809697620764561476e-17"},
+				{"1.559004400237836929221657555899582803249359130859375", "3.781207053357527507824207e-17", "3.781207053357527507824208e-17"},
+				{"1.5759808451078864965921866314602084457874298095703125", "-1.013691647127830343688187e-17", "-1.013691647127830343688186e-17"},
+				{"1.593142151342266998881314066238701343536376953125", "-1.009440654231196326076680e-16", "-1.009440654231196326076679e-16"},
+				{"1.610490331949254283472328097559511661529541015625", "2.470719256979788892192989e-17", "2.470719256979788892192990e-17"},
+				{"1.6280274218573478339777693690848536789417266845703125", "-6.712955084707083900171298e-17", "-6.712955084707083900171297e-17"},
+				{"1.6457554781539649457755558614735491573810577392578125", "-1.012567991367477267117138e-16", "-1.012567991367477267117137e-16"},
+				{"1.6636765803267363761364094898453913629055023193359375", "5.890992696713099908236857e-17", "5.890992696713099908236858e-17"},
+				{"1.6817928305074290040721507466514594852924346923828125", "8.199010020581497030478763e-17", "8.199010020581497030478764e-17"},
+				{"1.7001063537185234775250819438952021300792694091796875", "-8.023719370397699794990610e-18", "-8.023719370397699794990609e-18"},
+				{"1.7186192981224779341431485590874217450618743896484375", "-1.851380418263110924054568e-17", "-1.851380418263110924054567e-17"},
+				{"1.737333835273706217350309088942594826221466064453125", "3.164389299292957193402729e-17", "3.164389299292957193402730e-17"},
+				{"1.75625216037329945351075366488657891750335693359375", "2.960140695448873430379099e-17", "2.960140695448873430379100e-17"},
+				{"1.7753764925265211882532412346336059272289276123046875", "6.429731796556571728052983e-17", "6.429731796556571728052984e-17"},
+				{"1.7947090750031071682002448142156936228275299072265625", "1.822745842791208819152691e-17", "1.822745842791208819152692e-17"},
+				{"1.81425217550039885594514998956583440303802490234375", "-9.969531538920349406057211e-17", "-9.969531538920349406057210e-17"},
+				{"1.8340080864093424306560109471320174634456634521484375", "3.283107224245627139263164e-17", "3.283107224245627139263165e-17"},
+				{"1.8539791250833854707735781630617566406726837158203125", "9.761887490727593999884893e-17", "9.761887490727593999884894e-17"},
+				{"1.8741676341102999625576330799958668649196624755859375", "-6.122763413004142033048025e-17", "-6.122763413004142033048024e-17"},
+				{"1.894575981586965607306183301261626183986663818359375", "3.403403535216529843076578e-17", "3.403403535216529843076579e-17"},
+				{"1.915206561397147400072071832255460321903228759765625", "-1.061994605619596294340530e-16", "-1.061994605619596294340529e-16"},
+				{"1.9360617934922943472741962978034280240535736083984375", "1.033238596067632635007828e-16", "1.033238596067632635007829e-16"},
+				{"1.9571441241754001794106443412601947784423828125", "8.960767791036667671274784e-17", "8.960767791036667671274785e-17"},
+				{"1.9784560263879509278694968088530004024505615234375", "4.038875310927816693309878e-17", "4.038875310927816693309879e-17"},
+			};
+			int i;
+			double f;
+
+			for (i=0; i<64; i++) {
+				hi[i] = rop<double>::fromstring_down(s[i][0]);
+				lo_inf[i] = rop<double>::fromstring_down(s[i][1]);
+				lo_sup[i] = rop<double>::fromstring_up(s[i][2]);
+			}
+
+			// ln2/64 = l1 + [l2], l1 has 32 significant bits
+			l1 = rop<double>::fromstring_down("0.01083042469326755963265895843505859375");
+			l2_inf = rop<double>::fromstring_down("2.981585826985293462725415e-12");
+			l2_sup = rop<double>::fromstring_up("2.981585826985293462725416e-12");
+
+			// c[i] = 1/i!
+			rop<double>::begin();
+			f = 1.;
+			for (i=0; i<7; i++) {
+				if (i != 0) f *= i;
+				c_inf[i] = rop<double>::div_down(1., f);
+				c_sup[i] = rop<double>::div_up(1., f);
+			}
+			rop<double>::end();
+		}
+	};
+
+	struct log_table {
+		double hi[49], lo_inf[49], lo_sup[49];
+		double l1, l2_inf, l2_sup;
+		double c_inf[10], c_sup[10];
+
+		log_table() {
+			static const char *s[49][3] = {
+				{"-0.3746934494414106975312961367308162152767181396484375", "3.924311228863239242796424e-18", "3.924311228863239242796425e-18"},
+				{"-0.3522205935893520933888112267595715820789337158203125", "-5.723331694918248777553485e-18", "-5.723331694918248777553484e-18"},
+				{"-0.330241686870576867107729412964545190334320068359375", "1.082832163748385846839919e-17", "1.082832163748385846839920e-17"},
+				{"-0.3087354816496132858816281441249884665012359619140625", "1.619918608514810276694428e-17", "1.619918608514810276694429e-17"},
+				{"-0.28768207245178090136761284156818874180316925048828125", "-2.607160616442563868970035e-17", "-2.607160616442563868970034e-17"},
+				{"-0.2670627852490452536216025691828690469264984130859375", "7.328915327320169097747667e-18", "7.328915327320169097747668e-18"},
+				{"-0.2468600779315257842672082233548280782997608184814453125", "-1.361743371748367948302654e-17", "-1.361743371748367948302653e-17"},
+				{"-0.2270574506353460753071971112149185501039028167724609375", "-9.551415762738488618113405e-18", "-9.551415762738488618113404e-18"},
+				{"-0.2076393647782444895621978275812580250203609466552734375", "-1.205324321668612964247638e-17", "-1.205324321668612964247637e-17"},
+				{"-0.188591169807550029791087808916927315294742584228515625", "7.432164219196925677201719e-18", "7.432164219196925677201720e-18"},
+				{"-0.169899036795397473387225772967212833464145660400390625", "4.868008764439071070291166e-19", "4.868008764439071070291167e-19"},
+				{"-0.151549898127200932673730449096183292567729949951171875", "-5.166959368461559176537963e-18", "-5.166959368461559176537962e-18"},
+				{"-0.13353139262452262681080128459143452346324920654296875", "3.664457663660084548873833e-18", "3.664457663660084548873834e-18"},
+				{"-0.1158318155251217007606356901305844075977802276611328125", "-4.338484369808095758970351e-18", "-4.338484369808095758970350e-18"},
+				{"-0.09844007281325252434189820860410691238939762115478515625", "4.439009633675135677506409e-18", "4.439009633675135677506410e-18"},
+				{"-0.081345639453952400810265999098191969096660614013671875", "-5.077076355931169815292994e-18", "-5.077076355931169815292993e-18"},
+				{"-0.06453852113757117814341057737692608498036861419677734375", "6.470486661692933156851459e-18", "6.470486661692933156851460e-18"},
+				{"-0.048009219186360606312913290594224235974252223968505859375", "-1.439090334729220426163067e-18", "-1.439090334729220426163066e-18"},
+				{"-0.0317486983145802981187699742804397828876972198486328125", "-3.038226308468085847039865e-18", "-3.038226308468085847039864e-18"},
+				{"-0.0157483569681391676053916484079309157095849514007568359375", "-1.002157863052897353811351e-18", "-1.002157863052897353811350e-18"},
+				{"0", "0", "0"},
+				{"0.015504186535965254478686148331689764745533466339111328125", "-3.278321022892429288676650e-19", "-3.278321022892429288676649e-19"},
+				{"0.03077165866675368732785500469617545604705810546875", "1.043173202900596708044638e-18", "1.043173202900596708044639e-18"},
+				{"0.0458095360312942012637194011404062621295452117919921875", "1.902959866474257079984386e-18", "1.902959866474257079984387e-18"},
+				{"0.06062462181643483993820353816772694699466228485107421875", "2.642402593872693316291540e-18", "2.642402593872693316291541e-18"},
+				{"0.07522342123758753162920953627690323628485202789306640625", "-5.930604196293240821647982e-18", "-5.930604196293240821647981e-18"},
+				{"0.089612158689687138046764403043198399245738983154296875", "-5.426812933664713870460554e-18", "-5.426812933664713870460553e-18"},
+				{"0.10379679368164355934833764649738441221415996551513671875", "5.477724157266590276092415e-18", "5.477724157266590276092416e-18"},
+				{"0.1177830356563834557359626842298894189298152923583984375", "-1.197168574759367713861335e-18", "-1.197168574759367713861334e-18"},
+				{"0.1315763577887192614657152489598956890404224395751953125", "1.112300087972958747341132e-17", "1.112300087972958747341133e-17"},
+				{"0.1451820098444978890395162807180895470082759857177734375", "8.242418783022474776514300e-18", "8.242418783022474776514301e-18"},
+				{"0.158605030176638572836367302443250082433223724365234375", "1.125700387218259149281246e-17", "1.125700387218259149281247e-17"},
+				{"0.17185025692665922836255276706651784479618072509765625", "-6.022453821011370579860803e-18", "-6.022453821011370579860802e-18"},
+				{"0.1849223384940119896402421773018431849777698516845703125", "3.023661415357406436028020e-18", "3.023661415357406436028021e-18"},
+				{"0.19782574332991986754137769821682013571262359619140625", "1.282119437298014133336263e-17", "1.282119437298014133336264e-17"},
+				{"0.2105647691073496419189581274622469209134578704833984375", "-4.249405314729895407192918e-18", "-4.249405314729895407192917e-18"},
+				{"0.223143551314209764857565687634632922708988189697265625", "-9.091270597324798419334388e-18", "-9.091270597324798419334387e-18"},
+				{"0.235566071312766911471925368459778837859630584716796875", "-2.394337149518735427722670e-18", "-2.394337149518735427722669e-18"},
+				{"0.2478361639045812692128123444490483961999416351318359375", "-1.243220957870252364820104e-17", "-1.243220957870252364820103e-17"},
+				{"0.259957524436926046274010104752960614860057830810546875", "2.069806938978935042971625e-17", "2.069806938978935042971626e-17"},
+				{"0.27193371548364175804834985683555714786052703857421875", "7.833196376974420141220477e-19", "7.833196376974420141220478e-19"},
+				{"0.28376817313064461867355703361681662499904632568359375", "-2.032665581126656185833825e-17", "-2.032665581126656185833824e-17"},
+				{"0.295464212893835898032790510114864446222782135009765625", "-2.164610860405990025104115e-17", "-2.164610860405990025104114e-17"},
+				{"0.30702503529491187439504074063734151422977447509765625", "-1.231991620010196361254078e-17", "-1.231991620010196361254077e-17"},
+				{"0.31845373111853458869546784626436419785022735595703125", "2.711477936732623539774497e-17", "2.711477936732623539774498e-17"},
+				{"0.329753286372467979692402195723843760788440704345703125", "2.122020616196946050163218e-18", "2.122020616196946050163219e-18"},
+				{"0.34092658697059319283795275623560883104801177978515625", "1.746713644354474737739507e-17", "1.746713644354474737739508e-17"},
+				{"0.351976423157178197609340486451401375234127044677734375", "-1.295389303019196244924478e-17", "-1.295389303019196244924477e-17"},
+				{"0.362905493689368474630185801288462243974208831787109375", "-2.149236145531097239783383e-17", "-2.149236145531097239783382e-17"},
+			};
+			int i;
+
+			for (i=0; i<49; i++) {
+				hi[i] = rop<double>::fromstring_down(s[i][0]);
+				lo_inf[i] = rop<double>::fromstring_down(s[i][1]);
+				lo_sup[i] = rop<double>::fromstring_up(s[i][2]);
+			}
+
+			// ln2 = l1 + [l2], l1 has 42 significant bits
+			l1 = rop<double>::fromstring_down("0.693147180559890330187045037746429443359375");
+			l2_inf = rop<double>::fromstring_down("5.497923018708371174712471e-14");
+			l2_sup = rop<double>::fromstring_up("5.497923018708371174712472e-14");
+
+			// c[i] = 1/i
+			rop<double>::begin();
+			c_inf[0] = c_sup[0] = 0.;
+			for (i=1; i<10; i++) {
+				c_inf[i] = rop<double>::div_down(1., (double)i);
+				c_sup[i] = rop<double>::div_up(1., (double)i);
+			}
+			rop<double>::end();
+		}
+	};
+
+	static const exp_table& exptab() {
+		static const exp_table t;
+		return t;
+	}
+
+	static const log_table& logtab() {
+		static const log_table t;
+		return t;
+	}
+
+	// [z1,z2] = [p1,p2] * [r1,r2] assuming p1 > 0
+	// must be called between rop<double>::begin() and rop<double>::end()
+	static void mulpos(const double& p1, const double& p2, const double& r1, const double& r2, double& z1, double& z2) {
+		z1 = rop<double>::mul_down(r1, (r1 >= 0.) ? p1 : p2);
+		z2 = rop<double>::mul_up(r2, (r2 >= 0.) ? p2 : p1);
+	}
+
+	static interval<double> exp_point(const double& x) {
+		double kd, a1, a2, b1, b2, r1, r2, q1, q2, z1, z2, rm, rm2, rem;
+		double s1, s2;
+		int k, j, m, i;
+
+		if (x == std::numeric_limits<double>::infinity() || x > 710.) {
+			return interval<double>((std::numeric_limits<double>::max)(), std::numeric_limits<double>::infinity());
+		}
+		if (x == -std::numeric_limits<double>::infinity() || x < -746.) {
+			return interval<double>(0., std::numeric_limits<double>::denorm_min());
+		}
+		if (x != x) return interval<double>(x, x);
+
+		const exp_table& t = exptab();
+
+		// 64 / ln2
+		k = (int)std::floor(x * 92.332482616893658 + 0.5);
+		j = k & 63;
+		m = (k - j) / 64;
+		kd = k;
+
+		rop<double>::begin();
+
+		// r = x - k * (l1 + [l2]). k * l1 is exact.
+		a1 = rop<double>::mul_down(kd, t.l1);
+		a2 = rop<double>::mul_up(kd, t.l1);
+		if (kd >= 0.) {
+			b1 = rop<double>::mul_down(kd, t.l2_inf);
+			b2 = rop<double>::mul_up(kd, t.l2_sup);
+		} else {
+			b1 = rop<double>::mul_down(kd, t.l2_sup);
+			b2 = rop<double>::mul_up(kd, t.l2_inf);
+		}
+		r1 = rop<double>::sub_down(rop<double>::sub_down(x, a2), b2);
+		r2 = rop<double>::sub_up(rop<double>::sub_up(x, a1), b1);
+
+		// exp(r) - 1 = r * (1 + r * (1/2 + r * (1/6 + ... + r/720))) + R
+		// |R| <= exp(|r|) * |r|^7 / 7! <= 2e-4 * |r|^7
+		q1 = t.c_inf[6];
+		q2 = t.c_sup[6];
+		for (i=5; i>=1; i--) {
+			mulpos(q1, q2, r1, r2, z1, z2);
+			q1 = rop<double>::add_down(z1, t.c_inf[i]);
+			q2 = rop<double>::add_up(z2, t.c_sup[i]);
+		}
+		mulpos(q1, q2, r1, r2, z1, z2);
+		rm = (-r1 > r2) ? -r1 : r2;
+		rm2 = rop<double>::mul_up(rm, rm);
+		rem = rop<double>::mul_up(rop<double>::mul_up(rop<double>::mul_up(rm2, rm2), rop<double>::mul_up(rm2, rm)), 2e-4);
+		q1 = rop<double>::sub_down(z1, rem);
+		q2 = rop<double>::add_up(z2, rem);
+
+		// 2^(j/64) * exp(r) = hi + (lo + (hi + lo) * (exp(r) - 1))
+		mulpos(rop<double>::add_down(t.hi[j], t.lo_inf[j]), rop<double>::add_up(t.hi[j], t.lo_sup[j]), q1, q2, z1, z2);
+		z1 = rop<double>::add_down(t.hi[j], rop<double>::add_down(z1, t.lo_inf[j]));
+		z2 = rop<double>::add_up(t.hi[j], rop<double>::add_up(z2, t.lo_sup[j]));
+
+		// multiply 2^m in two steps to avoid overflow of 2^m itself
+		s1 = std::ldexp(1., m / 2);
+		s2 = std::ldexp(1., m - m / 2);
+		z1 = rop<double>::mul_down(rop<double>::mul_down(z1, s1), s2);
+		z2 = rop<double>::mul_up(rop<double>::mul_up(z2, s1), s2);
+
+		rop<double>::end();
+
+		return interval<double>(z1, z2);
+	}
+
+	static double log_point(const double& x, int round) {
+		double m, c, d1, d2, u1, u2, a1, a2, z1, z2, um, um2, um4, rem;
+		double ed, w1, w2, r;
+		int e, j, i;
+
+		if (x == std::numeric_limits<double>::infinity()) {
+			if (round == 1) {
+				return std::numeric_limits<double>::infinity();
+			} else {
+				return (std::numeric_limits<double>::max)();
+			}
+		}
+		if (x == 0.) {
+			if (round == 1) {
+				return -(std::numeric_limits<double>::max)();
+			} else {
+				return -std::numeric_limits<double>::infinity();
+			}
+		}
+		if (x != x) return x;
+
+		const log_table& t = logtab();
+
+		m = std::frexp(x, &e);
+		if (m < 0.70710678118654752) {
+			m *= 2.;
+			e--;
+		}
+		j = (int)std::floor((m - 1.) * 64. + 0.5);
+		c = 1. + j * 0.015625;
+		ed = e;
+
+		rop<double>::begin();
+
+		// u = (m - c) / c. m - c is exact.
+		d1 = rop<double>::sub_down(m, c);
+		d2 = rop<double>::sub_up(m, c);
+		u1 = rop<double>::div_down(d1, c);
+		u2 = rop<double>::div_up(d2, c);
+
+		// log1p(u) = u * (1 - u * (1/2 - u * (1/3 - ... - u/9))) + R
+		// |R| <= |u|^10 / 10 / (1 - |u|) <= 0.102 * |u|^10
+		a1 = t.c_inf[9];
+		a2 = t.c_sup[9];
+		for (i=8; i>=1; i--) {
+			mulpos(a1, a2, u1, u2, z1, z2);
+			a1 = rop<double>::sub_down(t.c_inf[i], z2);
+			a2 = rop<double>::sub_up(t.c_sup[i], z1);
+		}
+		mulpos(a1, a2, u1, u2, z1, z2);
+		um = (-u1 > u2) ? -u1 : u2;
+		um2 = rop<double>::mul_up(um, um);
+		um4 = rop<double>::mul_up(um2, um2);
+		rem = rop<double>::mul_up(rop<double>::mul_up(rop<double>::mul_up(um4, um4), um2), 0.102);
+		z1 = rop<double>::sub_down(z1, rem);
+		z2 = rop<double>::add_up(z2, rem);
+
+		// log(x) = (e * l1 + hi) + (e * [l2] + [lo] + log1p(u))
+		// e * l1 is exact.
+		if (ed >= 0.) {
+			w1 = rop<double>::mul_down(ed, t.l2_inf);
+			w2 = rop<double>::mul_up(ed, t.l2_sup);
+		} else {
+			w1 = rop<double>::mul_down(ed, t.l2_sup);
+			w2 = rop<double>::mul_up(ed, t.l2_inf);
+		}
+		if (round == -1) {
+			w1 = rop<double>::add_down(rop<double>::add_down(w1, t.lo_inf[j + 20]), z1);
+			r = rop<double>::add_down(rop<double>::add_down(rop<double>::mul_down(ed, t.l1), t.hi[j + 20]), w1);
+		} else {
+			w2 = rop<double>::add_up(rop<double>::add_up(w2, t.lo_sup[j + 20]), z2);
+			r = rop<double>::add_up(rop<double>::add_up(rop<double>::mul_up(ed, t.l1), t.hi[j + 20]), w2);
+		}
+
+		rop<double>::end();
+
+		return r;
+	}
+
+	struct trig_table {
+		double p1, p2, p3, p4_inf, p4_sup;
+		double s_inf[9], s_sup[9];
+		double c_inf[9], c_sup[9];
+
+		trig_table() {
+			int i;
+			double f;
+
+			// pi/2 = p1 + p2 + p3 + [p4]
+			p1 = rop<double>::fromstring_down("1.570796325802803039550781250");
+			p2 = rop<double>::fromstring_down("9.9209357916352214346034088521264493465423583984375e-10");
+			p3 = rop<double>::fromstring_down("5.170182978890249594880037316453613716049630966153927147388458251953125e-19");
+			p4_inf = rop<double>::fromstring_down("2.903855973979360333879556e-28");
+			p4_sup = rop<double>::fromstring_up("2.903855973979360333879557e-28");
+
+			// s[i] = 1/(2i+1)!, c[i] = 1/(2i)!
+			rop<double>::begin();
+			f = 1.;
+			for (i=0; i<9; i++) {
+				if (i != 0) f *= (2 * i - 1) * (2 * i);
+				c_inf[i] = rop<double>::div_down(1., f);
+				c_sup[i] = rop<double>::div_up(1., f);
+				s_inf[i] = rop<double>::div_down(1., f * (2 * i + 1));
+				s_sup[i] = rop<double>::div_up(1., f * (2 * i + 1));
+			}
+			rop<double>::end();
+		}
+	};
+
+	static const trig_table& trigtab() {
+		static const trig_table t;
+		return t;
+	}
+
+	// x = k * pi/2 + [r1,r2]
+	// must be called between rop<double>::begin() and rop<double>::end()
+	static void trig_reduce(const trig_table& t, const double& x, int& k, double& r1, double& r2) {
+		double kd;
+
+		k = (int)std::floor(x * 0.63661977236758134 + 0.5);
+		kd = k;
+
+		// k * p1, k * p2 and k * p3 are exact.
+		r1 = rop<double>::sub_down(rop<double>::sub_down(rop<double>::sub_down(x, kd * t.p1), kd * t.p2), kd * t.p3);
+		r2 = rop<double>::sub_up(rop<double>::sub_up(rop<double>::sub_up(x, kd * t.p1), kd * t.p2), kd * t.p3);
+		if (kd >= 0.) {
+			r1 = rop<double>::sub_down(r1, rop<double>::mul_up(kd, t.p4_sup));
+			r2 = rop<double>::sub_up(r2, rop<double>::mul_down(kd, t.p4_inf));
+		} else {
+			r1 = rop<double>::sub_down(r1, rop<double>::mul_up(kd, t.p4_inf));
+			r2 = rop<double>::sub_up(r2, rop<double>::mul_down(kd, t.p4_sup));
+		}
+	}
+
+	// [y1,y2] = sin([r1,r2]) for |r| < 0.8
+	// must be called between rop<double>::begin() and rop<double>::end()
+	static void sin_origin(const trig_table& t, const double& r1, const double& r2, double& y1, double& y2) {
+		double s1, s2, t1, t2, z1, z2, rm, rm2, rm4, rm8, rem;
+		int i;
+
+		rm = (-r1 > r2) ? -r1 : r2;
+		if (r1 >= 0.) {
+			t1 = rop<double>::mul_down(r1, r1);
+		} else if (r2 <= 0.) {
+			t1 = rop<double>::mul_down(r2, r2);
+		} else {
+			t1 = 0.;
+		}
+		t2 = rop<double>::mul_up(rm, rm);
+
+		// sin(r) = r * (1 - t * (1/3! - t * (1/5! - ... - t/17!))) + R, t = r^2
+		// |R| <= |r|^19 / 19! <= 8.23e-18 * |r|^19
+		s1 = t.s_inf[8];
+		s2 = t.s_sup[8];
+		for (i=7; i>=0; i--) {
+			mulpos(s1, s2, t1, t2, z1, z2);
+			s1 = rop<double>::sub_down(t.s_inf[i], z2);
+			s2 = rop<double>::sub_up(t.s_sup[i], z1);
+		}
+		mulpos(s1, s2, r1, r2, z1, z2);
+		rm2 = t2;
+		rm4 = rop<double>::mul_up(rm2, rm2);
+		rm8 = rop<double>::mul_up(rm4, rm4);
+		rem = rop<double>::mul_up(rop<double>::mul_up(rm8, rm8), rop<double>::mul_up(rop<double>::mul_up(rm2, rm), 8.23e-18));
+		y1 = rop<double>::sub_down(z1, rem);
+		y2 = rop<double>::add_up(z2, rem);
+	}
+
+	// [y1,y2] = cos([r1,r2]) for |r| < 0.8
+	// must be called between rop<double>::begin() and rop<double>::end()
+	static void cos_origin(const trig_table& t, const double& r1, const double& r2, double& y1, double& y2) {
+		double c1, c2, t1, t2, z1, z2, rm, rm2, rm4, rem;
+		int i;
+
+		rm = (-r1 > r2) ? -r1 : r2;
+		if (r1 >= 0.) {
+			t1 = rop<double>::mul_down(r1, r1);
+		} else if (r2 <= 0.) {
+			t1 = rop<double>::mul_down(r2, r2);
+		} else {
+			t1 = 0.;
+		}
+		t2 = rop<double>::mul_up(rm, rm);
+
+		// cos(r) = 1 - t * (1/2! - t * (1/4! - ... - t/16!)) + R, t = r^2
+		// |R| <= |r|^18 / 18! <= 1.57e-16 * |r|^18
+		c1 = t.c_inf[8];
+		c2 = t.c_sup[8];
+		for (i=7; i>=1; i--) {
+			mulpos(c1, c2, t1, t2, z1, z2);
+			c1 = rop<double>::sub_down(t.c_inf[i], z2);
+			c2 = rop<double>::sub_up(t.c_sup[i], z1);
+		}
+		mulpos(c1, c2, t1, t2, z1, z2);
+		rm2 = t2;
+		rm4 = rop<double>::mul_up(rm2, rm2);
+		rem = rop<double>::mul_up(rop<double>::mul_up(rop<double>::mul_up(rm4, rm4), rop<double>::mul_up(rm4, rm4)), rop<double>::mul_up(rm2, 1.57e-16));
+		y1 = rop<double>::sub_down(rop<double>::sub_down(1., z2), rem);
+		y2 = rop<double>::add_up(rop<double>::sub_up(1., z1), rem);
+	}
+
+	// [y1,y2] = sin(k * pi/2 + [r1,r2])
+	// must be called between rop<double>::begin() and rop<double>::end()
+	static void sin_quadrant(const trig_table& t, int k, const double& r1, const double& r2, double& y1, double& y2) {
+		double z1, z2;
+
+		switch (k & 3) {
+			case 0:
+			sin_origin(t, r1, r2, y1, y2);
+			break;
+			case 1:
+			cos_origin(t, r1, r2, y1, y2);
+			break;
+			case 2:
+			sin_origin(t, r1, r2, z1, z2);
+			y1 = -z2;
+			y2 = -z1;
+			break;
+			default:
+			cos_origin(t, r1, r2, z1, z2);
+			y1 = -z2;
+			y2 = -z1;
+			break;
+		}
+	}
+
+	// true if k * pi/2 may be contained in [x1,x2]
+	// where x1 = k1 * pi/2 + [r11,r12], x2 = k2 * pi/2 + [r21,r22]
+	static bool quadrant_in(int k, int k1, const double& r11, int k2, const double& r22) {
+		return (k1 < k || (k1 == k && r11 <= 0.)) && (k < k2 || (k == k2 && r22 >= 0.));
+	}
+
+	// s = sin(I) if want_sin, c = cos(I) if want_cos
+	static bool sincos_range(const interval<double>& I, bool want_sin, bool want_cos, interval<double>& s, interval<double>& c) {
+		double a = I.lower(), b = I.upper();
+		double ra1, ra2, rb1, rb2, y1, y2, z1, z2;
+		double s1, s2, c1, c2;
+		int ka, kb, k;
+
+		using std::abs;
+		if (!(abs(a) < 1e7) || !(abs(b) < 1e7)) return false;
+
+		if (b - a >= 6.3) {
+			s = interval<double>(-1., 1.);
+			c = interval<double>(-1., 1.);
+			return true;
+		}
+
+		const trig_table& t = trigtab();
+
+		rop<double>::begin();
+
+		trig_reduce(t, a, ka, ra1, ra2);
+		if (a == b) {
+			kb = ka; rb1 = ra1; rb2 = ra2;
+		} else {
+			trig_reduce(t, b, kb, rb1, rb2);
+		}
+
+		s1 = s2 = c1 = c2 = 0.;
+
+		if (want_sin) {
+			sin_quadrant(t, ka, ra1, ra2, y1, y2);
+			if (a == b) {
+				z1 = y1; z2 = y2;
+			} else {
+				sin_quadrant(t, kb, rb1, rb2, z1, z2);
+			}
+			s1 = (y1 < z1) ? y1 : z1;
+			s2 = (y2 > z2) ? y2 : z2;
+			// sin takes 1 at k = 1 (mod 4), -1 at k = 3 (mod 4)
+			for (k=ka; k<=kb; k++) {
+				if ((k & 1) == 0) continue;
+				if (!quadrant_in(k, ka, ra1, kb, rb2)) continue;
+				if ((k & 3) == 1) s2 = 1.;
+				else s1 = -1.;
+			}
+		}
+
+		if (want_cos) {
+			// cos(x) = sin(x + pi/2)
+			sin_quadrant(t, ka + 1, ra1, ra2, y1, y2);
+			if (a == b) {
+				z1 = y1; z2 = y2;
+			} else {
+				sin_quadrant(t, kb + 1, rb1, rb2, z1, z2);
+			}
+			c1 = (y1 < z1) ? y1 : z1;
+			c2 = (y2 > z2) ? y2 : z2;
+			// cos takes 1 at k = 0 (mod 4), -1 at k = 2 (mod 4)
+			for (k=ka; k<=kb; k++) {
+				if ((k & 1) != 0) continue;
+				if (!quadrant_in(k, ka, ra1, kb, rb2)) continue;
+				if ((k & 3) == 0) c2 = 1.;
+				else c1 = -1.;
+			}
+		}
+
+		rop<double>::end();
+
+		if (s1 < -1.) s1 = -1.;
+		if (s2 > 1.) s2 = 1.;
+		if (c1 < -1.) c1 = -1.;
+		if (c2 > 1.) c2 = 1.;
+		s = interval<double>(s1, s2);
+		c = interval<double>(c1, c2);
+
+		return true;
+	}
+
+	static bool tan_range(const interval<double>& I, interval<double>& y) {
+		double a = I.lower(), b = I.upper();
+		double ra1, ra2, rb1, rb2, s1, s2, c1, c2;
+		interval<double> ya, yb;
+		int ka, kb, k;
+
+		using std::abs;
+		if (!(abs(a) < 1e7) || !(abs(b) < 1e7)) return false;
+
+		if (b - a >= 3.15) {
+			y = interval<double>::whole();
+			return true;
+		}
+
+		const trig_table& t = trigtab();
+
+		rop<double>::begin();
+		trig_reduce(t, a, ka, ra1, ra2);
+		trig_reduce(t, b, kb, rb1, rb2);
+
+		// tan has poles at odd k
+		for (k=ka; k<=kb; k++) {
+			if ((k & 1) == 0) continue;
+			if (quadrant_in(k, ka, ra1, kb, rb2)) {
+				rop<double>::end();
+				y = interval<double>::whole();
+				return true;
+			}
+		}
+
+		sin_quadrant(t, ka, ra1, ra2, s1, s2);
+		sin_quadrant(t, ka + 1, ra1, ra2, c1, c2);
+		rop<double>::end();
+		ya = interval<double>(s1, s2) / interval<double>(c1, c2);
+
+		rop<double>::begin();
+		sin_quadrant(t, kb, rb1, rb2, s1, s2);
+		sin_quadrant(t, kb + 1, rb1, rb2, c1, c2);
+		rop<double>::end();
+		yb = interval<double>(s1, s2) / interval<double>(c1, c2);
+
+		y = interval<double>(ya.lower(), yb.upper());
+
+		return true;
+	}
+};
+
+template <> inline interval<double> interval<double>::exp_point(const double& x) {
+	return rdouble_elementary::exp_point(x);
+}
+
+template <> inline double interval<double>::log_point(const double& x, int round) {
+	return rdouble_elementary::log_point(x, round);
+}
+
+template <> inline bool interval<double>::sin_special(const interval<double>& I, interval<double>& r) {
+	interval<double> c;
+	return rdouble_elementary::sincos_range(I, true, false, r, c);
+}
+
+template <> inline bool interval<double>::cos_special(const interval<double>& I, interval<double>& r) {
+	interval<double> s;
+	return rdouble_elementary::sincos_range(I, false, true, s, r);
+}
+
+template <> inline bool interval<double>::tan_special(const interval<double>& I, interval<double>& r) {
+	return rdouble_elementary::tan_range(I, r);
+}
+
+} // namespace kv
+
+#endif // RDOUBLE_ELEMENTARY_HPP
@@ -88,11 +88,20 @@ template <> struct rop <double> {
 		return r;
 	}
 
+	// with KV_USE_UPWARD, the rounding mode is not changed in
+	// upward_scope (see hwround.hpp)
+
 	static void begin() {
+		#ifdef KV_USE_UPWARD
+		if (hwround_state::depth() != 0) return;
+		#endif
 		hwround::roundup();
 	}
 
 	static void end() {
+		#ifdef KV_USE_UPWARD
+		if (hwround_state::depth() != 0) return;
+		#endif
 		hwround::roundnear();
 	}
 
@@ -49,4 +49,6 @@ template <> struct constants< interval<double> > {
 };
 } // namespace kv
 
+#include <kv/rdouble-elementary.hpp>
+
 #endif // RDOUBLE_HPP
@@ -174,6 +174,77 @@ template <int N> struct constants< interval< mpfr<N> > > {
 	}
 };
 
+
+namespace rmpfr_sub {
+
+// s(lower) += a * b rounded downward, s(upper) += c * d rounded upward
+template <int N> inline void fma2(interval< mpfr<N> >& s, const mpfr<N>& a, const mpfr<N>& b, const mpfr<N>& c, const mpfr<N>& d) {
+	mpfr_fma(s.lower().a, a.a, b.a, s.lower().a, MPFR_RNDD);
+	mpfr_fma(s.upper().a, c.a, d.a, s.upper().a, MPFR_RNDU);
+}
+
+// s += x * y. the end points are selected by the signs as in
+// interval::operator*, and each bound is added by one mpfr_fma.
+template <int N> inline void fma_add(interval< mpfr<N> >& s, const interval< mpfr<N> >& x, const interval< mpfr<N> >& y) {
+	mpfr<N> tmp;
+
+	if (x.lower() >= 0.) {
+		if (x.upper() == 0.) return;
+		if (y.lower() >= 0.) {
+			if (y.upper() == 0.) return;
+			fma2(s, x.lower(), y.lower(), x.upper(), y.upper());
+		} else if (y.upper() <= 0.) {
+			fma2(s, x.upper(), y.lower(), x.lower(), y.upper());
+		} else {
+			fma2(s, x.upper(), y.lower(), x.upper(), y.upper());
+		}
+	} else if (x.upper() <= 0.) {
+		if (y.lower() >= 0.) {
+			if (y.upper() == 0.) return;
+			fma2(s, x.lower(), y.upper(), x.upper(), y.lower());
+		} else if (y.upper() <= 0.) {
+			fma2(s, x.upper(), y.upper(), x.lower(), y.lower());
+		} else {
+			fma2(s, x.lower(), y.upper(), x.lower(), y.lower());
+		}
+	} else {
+		if (y.lower() >= 0.) {
+			if (y.upper() == 0.) return;
+			fma2(s, x.lower(), y.upper(), x.upper(), y.upper());
+		} else if (y.upper() <= 0.) {
+			fma2(s, x.upper(), y.lower(), x.lower(), y.lower());
+		} else {
+			// the rounded sums are monotone in the products
+			mpfr_fma(tmp.a, x.upper().a, y.lower().a, s.lower().a, MPFR_RNDD);
+			mpfr_fma(s.lower().a, x.lower().a, y.upper().a, s.lower().a, MPFR_RNDD);
+			if (tmp < s.lower()) s.lower() = tmp;
+			mpfr_fma(tmp.a, x.upper().a, y.upper().a, s.upper().a, MPFR_RNDU);
+			mpfr_fma(s.upper().a, x.lower().a, y.lower().a, s.upper().a, MPFR_RNDU);
+			if (tmp > s.upper()) s.upper() = tmp;
+		}
+	}
+}
+
+} // namespace rmpfr_sub
+
+
+// sum of products of psa multiplication (see psa.hpp)
+
+template <class T> struct psa_dot;
+
+template <int N> struct psa_dot< interval< mpfr<N> > > {
+	template <class V> static interval< mpfr<N> > conv(const V& a, const V& b, int i, int j0, int j1) {
+		interval< mpfr<N> > sum;
+		int j;
+
+		sum = 0.;
+		for (j=j0; j<=j1; j++) {
+			rmpfr_sub::fma_add(sum, a(j), b(i-j));
+		}
+		return sum;
+	}
+};
+
 } // namespace kv
 
 #endif // RMPFR_HPP
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef SOLVER_STATS_HPP
+#define SOLVER_STATS_HPP
+
+// statistics of ode, odelong_*, allsol and optimize
+//
+//   kv::solver_stats st;
+//   kv::odelong_maffine(f, x, start, end, kv::ode_param<double>().set_stats(&st));
+//   st.print(std::cout, "json");
+//
+// the solvers record the statistics only if a pointer to
+// solver_stats is given (ode_param::stats, allsol_param::stats,
+// the last argument of optimize). otherwise the cost is one
+// comparison with NULL for each event.
+//
+// three kinds of entries, identified by name:
+//   count: number of events (steps, restarts, boxes, ...)
+//   value: observed values (step size, noise symbols, ...),
+//          number, sum, min and max are kept
+//   time : elapsed time of each phase in seconds
+//
+// entries recorded by the solvers:
+//   ode_steps, ode_failures      : accepted steps, failed steps
+//   ode_rejected                 : verification failed, step size halved
+//   ode_restarts                 : evaluation error, step size halved
+//   ode_resized                  : step size corrected by the estimate
+//   ode_picard                   : Picard iterations (evaluations of f
+//                                  in the verification and refinement)
+//   ode_step_size, ode_order     : values of accepted steps
+//   ode_noise_symbols            : affine noise symbols after
+//                                  epsilon_reduce (ode_maffine)
+//   time ode_taylor, ode_verify, ode_refine, ode_affine
+//   allsol_tested, allsol_ne, allsol_ex_test, allsol_solutions,
+//   allsol_divided, allsol_giveup, time allsol
+//   optimize_tested, optimize_pruned, optimize_divided,
+//   optimize_solutions, time optimize
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <chrono>
+#include <limits>
+
+
+namespace kv {
+
+
+struct stats_value {
+	long long n;
+	double sum, min, max;
+
+	stats_value() : n(0), sum(0.), min(std::numeric_limits<double>::infinity()), max(-std::numeric_limits<double>::infinity()) {}
+
+	void add(double x) {
+		n++;
+		sum += x;
+		if (x < min) min = x;
+		if (x > max) max = x;
+	}
+
+	double mean() const {
+		return n == 0 ? 0. : sum / n;
+	}
+};
+
+
+class solver_stats {
+	public:
+	std::map<std::string, long long> count;
+	std::map<std::string, stats_value> value;
+	std::map<std::string, double> time;
+
+	void add(const char* name, long long x = 1) {
+		#ifdef _OPENMP
+		#pragma omp critical (solver_stats)
+		#endif
+		{
+		count[name] += x;
+		}
+	}
+
+	void record(const char* name, double x) {
+		#ifdef _OPENMP
+		#pragma omp critical (solver_stats)
+		#endif
+		{
+		value[name].add(x);
+		}
+	}
+
+	void add_time(const char* name, double sec) {
+		#ifdef _OPENMP
+		#pragma omp critical (solver_stats)
+		#endif
+		{
+		time[name] += sec;
+		}
+	}
+
+	void clear() {
+		count.clear();
+		value.clear();
+		time.clear();
+	}
+
+	long long get_count(const std::string& name) const {
+		std::map<std::string, long long>::const_iterator p = count.find(name);
+		return p == count.end() ? 0 : p->second;
+	}
+
+	void print_text(std::ostream& o) const {
+		std::map<std::string, long long>::const_iterator p;
+		std::map<std::string, stats_value>::const_iterator q;
+		std::map<std::string, double>::const_iterator r;
+
+		for (p=count.begin(); p!=count.end(); p++) {
+			o << p->first << ": " << p->second << "\n";
+		}
+		for (q=value.begin(); q!=value.end(); q++) {
+			o << q->first << ": n=" << q->second.n << ", mean=" << q->second.mean() << ", min=" << q->second.min << ", max=" << q->second.max << "\n";
+		}
+		for (r=time.begin(); r!=time.end(); r++) {
+			o << r->first << ": " << r->second << " sec\n";
+		}
+	}
+
+	void print_json(std::ostream& o) const {
+		std::map<std::string, long long>::const_iterator p;
+		std::map<std::string, stats_value>::const_iterator q;
+		std::map<std::string, double>::const_iterator r;
+
+		o << "{\"count\": {";
+		for (p=count.begin(); p!=count.end(); p++) {
+			if (p != count.begin()) o << ", ";
+			o << "\"" << p->first << "\": " << p->second;
+		}
+		o << "}, \"value\": {";
+		for (q=value.begin(); q!=value.end(); q++) {
+			if (q != value.begin()) o << ", ";
+			o << "\"" << q->first << "\": {\"n\": " << q->second.n << ", \"sum\": " << q->second.sum << ", \"min\": " << q->second.min << ", \"max\": " << q->second.max << "}";
+		}
+		o << "}, \"time\": {";
+		for (r=time.begin(); r!=time.end(); r++) {
+			if (r != time.begin()) o << ", ";
+			o << "\"" << r->first << "\": " << r->second;
+		}
+		o << "}}\n";
+	}
+
+	void print_csv(std::ostream& o, bool header = true) const {
+		std::map<std::string, long long>::const_iterator p;
+		std::map<std::string, stats_value>::const_iterator q;
+		std::map<std::string, double>::const_iterator r;
+
+		if (header) o << "kind,name,n,sum,min,max\n";
+		for (p=count.begin(); p!=count.end(); p++) {
+			o << "count," << p->first << "," << p->second << ",,,\n";
+		}
+		for (q=value.begin(); q!=value.end(); q++) {
+			o << "value," << q->first << "," << q->second.n << "," << q->second.sum << "," << q->second.min << "," << q->second.max << "\n";
+		}
+		for (r=time.begin(); r!=time.end(); r++) {
+			o << "time," << r->first << ",," << r->second << ",,\n";
+		}
+	}
+
+	// format: "text", "json" or "csv"
+	void print(std::ostream& o, const std::string& format = "text") const {
+		if (format == "json") print_json(o);
+		else if (format == "csv") print_csv(o);
+		else print_text(o);
+	}
+};
+
+
+// add the time from construction to destruction to s (if not NULL)
+
+class stats_timer {
+	solver_stats* s;
+	const char* name;
+	std::chrono::steady_clock::time_point t;
+
+	public:
+
+	stats_timer(solver_stats* s, const char* name) : s(s), name(name) {
+		if (s != NULL) t = std::chrono::steady_clock::now();
+	}
+
+	// add the time until now and restart with new name
+	void lap(const char* name2) {
+		std::chrono::steady_clock::time_point t2;
+
+		if (s == NULL) return;
+		t2 = std::chrono::steady_clock::now();
+		s->add_time(name, std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t).count() / 1e9);
+		name = name2;
+		t = t2;
+	}
+
+	~stats_timer() {
+		if (s != NULL) {
+			s->add_time(name, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t).count() / 1e9);
+		}
+	}
+};
+
+} // namespace kv
+
+#endif // SOLVER_STATS_HPP
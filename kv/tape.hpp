@@ -0,0 +1,586 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef TAPE_HPP
+#define TAPE_HPP
+
+// record the calculation of a templated function object once by the
+// tracing number type "tracer", and evaluate it later with any number
+// type (interval, affine, autodif, psa, ...).
+//
+// usage:
+//   kv::tape tp;
+//   tp.record(Func(), n);         // Func: R^n -> R^m
+//   y = tp(x);                    // same as Func()(x)
+//   kv::allsol(tp, I);            // tape can be used as a function object
+//
+//   kv::scalar_tape st;
+//   st.record(Func2(), n);        // Func2: R^n -> R
+//   kv::minimize(I, st, 1e-5);
+//
+//   tp.record_ode(Func3(), n);    // Func3: right hand side f(x, t) of ODE
+//
+// common subexpressions are merged and the nodes which do not affect the
+// outputs are removed. the work area is shared by the nodes whose
+// lifetime do not overlap.
+// constants in the function are recorded as double and the arithmetic
+// on them is done by the evaluating type, so the result is verified if
+// the evaluating type is an interval type.
+// branches depending on the values of variables can not be recorded.
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <stdexcept>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/cstdint.hpp>
+#include <kv/convert.hpp>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+class tape;
+class tracer;
+
+template <class C> struct convertible<C, tracer> {
+	static const bool value = convertible<C, double>::value || boost::is_same<C, tracer>::value;
+};
+template <class C> struct acceptable_n<C, tracer> {
+	static const bool value = convertible<C, double>::value;
+};
+
+
+class tape {
+	public:
+
+	enum {
+		VAR, CONST, ADD, SUB, MUL, DIV, NEG, POWI, POW,
+		SQRT, EXP, LOG, SIN, COS, TAN, ASIN, ACOS, ATAN,
+		SINH, COSH, TANH, ASINH, ACOSH, ATANH
+	};
+
+	struct node {
+		int op;
+		int a, b; // operands (index of variable for VAR, exponent for POWI)
+		double c; // value for CONST
+		int r; // place of the result in the work area (after finalize)
+	};
+
+	std::vector<node> code;
+	std::vector<int> outputs;
+	int nvar;
+	int nwork;
+
+	tape() : nvar(0), nwork(0) {}
+
+	void clear() {
+		code.clear();
+		outputs.clear();
+		table.clear();
+		nvar = 0;
+		nwork = 0;
+	}
+
+	int size() const {
+		return code.size();
+	}
+
+	// the tape which is now recording
+	static tape*& current() {
+		static tape* p = NULL;
+		#ifdef _OPENMP
+		#pragma omp threadprivate(p)
+		#endif
+		return p;
+	}
+
+	// add node with common subexpression elimination
+	int push(int op, int a, int b, double c = 0.) {
+		key k;
+		node n;
+		std::map<key, int>::iterator p;
+
+		// normalize commutative operations
+		if ((op == ADD || op == MUL) && a > b) std::swap(a, b);
+
+		k.op = op; k.a = a; k.b = b;
+		std::memcpy(&k.c, &c, sizeof(double));
+
+		p = table.find(k);
+		if (p != table.end()) return p->second;
+
+		n.op = op; n.a = a; n.b = b; n.c = c; n.r = -1;
+		code.push_back(n);
+		table.insert(std::make_pair(k, (int)code.size() - 1));
+		return code.size() - 1;
+	}
+
+	int constant(double c) {
+		return push(CONST, 0, 0, c);
+	}
+
+	template <class F> void record(F f, int n);
+	template <class F> void record_ode(F f, int n);
+
+	template <class T> void eval(const ub::vector<T>& x, ub::vector<T>& y) const {
+		int i;
+		std::vector<T> w(nwork);
+
+		run(x, w);
+
+		y.resize(outputs.size());
+		for (i=0; i<(int)outputs.size(); i++) {
+			y(i) = w[outputs[i]];
+		}
+	}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) const {
+		ub::vector<T> y;
+		eval(x, y);
+		return y;
+	}
+
+	// for the tape recorded by record_ode
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, const T& t) const {
+		int i, n = x.size();
+		ub::vector<T> xt(n + 1), y;
+
+		for (i=0; i<n; i++) xt(i) = x(i);
+		xt(n) = t;
+		eval(xt, y);
+		return y;
+	}
+
+	// evaluate for many inputs in parallel
+	template <class T> void eval_batch(const std::vector< ub::vector<T> >& x, std::vector< ub::vector<T> >& y) const {
+		int i;
+		int n = x.size();
+
+		y.resize(n);
+		#ifdef _OPENMP
+		#pragma omp parallel for schedule(dynamic)
+		#endif
+		for (i=0; i<n; i++) {
+			eval(x[i], y[i]);
+		}
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const tape& t) {
+		int i;
+		static const char* name[] = {
+			"var", "const", "add", "sub", "mul", "div", "neg", "powi", "pow",
+			"sqrt", "exp", "log", "sin", "cos", "tan", "asin", "acos", "atan",
+			"sinh", "cosh", "tanh", "asinh", "acosh", "atanh"
+		};
+
+		for (i=0; i<(int)t.code.size(); i++) {
+			const node& n = t.code[i];
+			s << "w" << n.r << " = " << name[n.op];
+			if (n.op == VAR) s << " x" << n.a;
+			else if (n.op == CONST) s << " " << n.c;
+			else if (n.op == POWI) s << " w" << n.a << " " << n.b;
+			else if (n.op <= POW) s << " w" << n.a << " w" << n.b;
+			else s << " w" << n.a;
+			s << "\n";
+		}
+		s << "outputs:";
+		for (i=0; i<(int)t.outputs.size(); i++) s << " w" << t.outputs[i];
+		s << "\n";
+		return s;
+	}
+
+	protected:
+
+	struct key {
+		int op, a, b;
+		boost::uint64_t c;
+		bool operator<(const key& y) const {
+			if (op != y.op) return op < y.op;
+			if (a != y.a) return a < y.a;
+			if (b != y.b) return b < y.b;
+			return c < y.c;
+		}
+	};
+
+	std::map<key, int> table;
+
+	static bool binary(int op) {
+		return op >= ADD && op <= POW && op != NEG && op != POWI;
+	}
+
+	static bool unary(int op) {
+		return op == NEG || op == POWI || op >= SQRT;
+	}
+
+	template <class T> void run(const ub::vector<T>& x, std::vector<T>& w) const {
+		int i;
+
+		using std::sqrt;
+		using std::exp;
+		using std::log;
+		using std::sin;
+		using std::cos;
+		using std::tan;
+		using std::asin;
+		using std::acos;
+		using std::atan;
+		using std::sinh;
+		using std::cosh;
+		using std::tanh;
+		using std::pow;
+
+		for (i=0; i<(int)code.size(); i++) {
+			const node& n = code[i];
+			switch (n.op) {
+				case VAR: w[n.r] = x(n.a); break;
+				case CONST: w[n.r] = T(n.c); break;
+				case ADD: w[n.r] = w[n.a] + w[n.b]; break;
+				case SUB: w[n.r] = w[n.a] - w[n.b]; break;
+				case MUL: w[n.r] = w[n.a] * w[n.b]; break;
+				case DIV: w[n.r] = w[n.a] / w[n.b]; break;
+				case NEG: w[n.r] = - w[n.a]; break;
+				case POWI: w[n.r] = pow(w[n.a], n.b); break;
+				case POW: w[n.r] = pow(w[n.a], w[n.b]); break;
+				case SQRT: w[n.r] = sqrt(w[n.a]); break;
+				case EXP: w[n.r] = exp(w[n.a]); break;
+				case LOG: w[n.r] = log(w[n.a]); break;
+				case SIN: w[n.r] = sin(w[n.a]); break;
+				case COS: w[n.r] = cos(w[n.a]); break;
+				case TAN: w[n.r] = tan(w[n.a]); break;
+				case ASIN: w[n.r] = asin(w[n.a]); break;
+				case ACOS: w[n.r] = acos(w[n.a]); break;
+				case ATAN: w[n.r] = atan(w[n.a]); break;
+				case SINH: w[n.r] = sinh(w[n.a]); break;
+				case COSH: w[n.r] = cosh(w[n.a]); break;
+				case TANH: w[n.r] = tanh(w[n.a]); break;
+				case ASINH: w[n.r] = asinh(w[n.a]); break;
+				case ACOSH: w[n.r] = acosh(w[n.a]); break;
+				case ATANH: w[n.r] = atanh(w[n.a]); break;
+			}
+		}
+	}
+
+	// remove nodes unused by outputs and assign places in the work area
+	void finalize() {
+		int i, j, m;
+		int s = code.size();
+		std::vector<int> used(s, 0), newindex(s, -1), last(s, -1), freelist;
+		std::vector<node> code2;
+
+		for (i=0; i<(int)outputs.size(); i++) used[outputs[i]] = 1;
+		for (i=s-1; i>=0; i--) {
+			if (!used[i]) continue;
+			if (binary(code[i].op)) {
+				used[code[i].a] = 1;
+				used[code[i].b] = 1;
+			} else if (unary(code[i].op)) {
+				used[code[i].a] = 1;
+			}
+		}
+
+		for (i=0; i<s; i++) {
+			if (!used[i]) continue;
+			node n = code[i];
+			if (binary(n.op)) {
+				n.a = newindex[n.a];
+				n.b = newindex[n.b];
+			} else if (unary(n.op)) {
+				n.a = newindex[n.a];
+			}
+			newindex[i] = code2.size();
+			code2.push_back(n);
+		}
+		code.swap(code2);
+		for (i=0; i<(int)outputs.size(); i++) outputs[i] = newindex[outputs[i]];
+		table.clear();
+
+		// lifetime of each node
+		s = code.size();
+		last.assign(s, -1);
+		for (i=0; i<s; i++) {
+			if (binary(code[i].op)) {
+				last[code[i].a] = i;
+				last[code[i].b] = i;
+			} else if (unary(code[i].op)) {
+				last[code[i].a] = i;
+			}
+		}
+		for (i=0; i<(int)outputs.size(); i++) last[outputs[i]] = s;
+
+		// places in the work area
+		std::vector<int> place(s);
+		nwork = 0;
+		for (i=0; i<s; i++) {
+			node& n = code[i];
+			// operands which are not used after this node
+			if (binary(n.op)) {
+				if (last[n.a] == i) freelist.push_back(place[n.a]);
+				if (last[n.b] == i && n.b != n.a) freelist.push_back(place[n.b]);
+			} else if (unary(n.op)) {
+				if (last[n.a] == i) freelist.push_back(place[n.a]);
+			}
+			if (freelist.empty()) {
+				m = nwork++;
+			} else {
+				m = freelist.back();
+				freelist.pop_back();
+			}
+			place[i] = m;
+			if (binary(n.op)) {
+				n.a = place[n.a];
+				n.b = place[n.b];
+			} else if (unary(n.op)) {
+				n.a = place[n.a];
+			}
+			n.r = m;
+			// result which is never used
+			if (last[i] == -1) freelist.push_back(m);
+		}
+		for (j=0; j<(int)outputs.size(); j++) outputs[j] = place[outputs[j]];
+	}
+};
+
+
+// tracing number type
+
+class tracer {
+	public:
+	int id; // index of node in the recording tape, -1 means 0
+
+	typedef double base_type;
+
+	tracer() : id(-1) {}
+
+	template <class C> explicit tracer(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value >::type* =0) {
+		id = rec().constant((double)x);
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer& >::type operator=(const C& x) {
+		id = rec().constant((double)x);
+		return *this;
+	}
+
+	static tracer variable(int i) {
+		tracer r;
+		r.id = rec().push(tape::VAR, i, 0);
+		return r;
+	}
+
+	static tape& rec() {
+		tape* p = tape::current();
+		if (p == NULL) throw std::logic_error("tracer: no tape is recording");
+		return *p;
+	}
+
+	int node() const {
+		if (id == -1) return rec().constant(0.);
+		return id;
+	}
+
+	static tracer make(int op, const tracer& a, const tracer& b) {
+		tracer r;
+		r.id = rec().push(op, a.node(), b.node());
+		return r;
+	}
+
+	static tracer make(int op, const tracer& a, int b = 0) {
+		tracer r;
+		r.id = rec().push(op, a.node(), b);
+		return r;
+	}
+
+	friend tracer operator+(const tracer& a, const tracer& b) {
+		return make(tape::ADD, a, b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator+(const tracer& a, const C& b) {
+		return a + tracer(b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator+(const C& a, const tracer& b) {
+		return tracer(a) + b;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::convertible<C, tracer>::value, tracer& >::type operator+=(tracer& a, const C& b) {
+		a = a + b;
+		return a;
+	}
+
+	friend tracer operator-(const tracer& a, const tracer& b) {
+		return make(tape::SUB, a, b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator-(const tracer& a, const C& b) {
+		return a - tracer(b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator-(const C& a, const tracer& b) {
+		return tracer(a) - b;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::convertible<C, tracer>::value, tracer& >::type operator-=(tracer& a, const C& b) {
+		a = a - b;
+		return a;
+	}
+
+	friend tracer operator-(const tracer& a) {
+		return make(tape::NEG, a);
+	}
+
+	friend tracer operator*(const tracer& a, const tracer& b) {
+		return make(tape::MUL, a, b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator*(const tracer& a, const C& b) {
+		return a * tracer(b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator*(const C& a, const tracer& b) {
+		return tracer(a) * b;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::convertible<C, tracer>::value, tracer& >::type operator*=(tracer& a, const C& b) {
+		a = a * b;
+		return a;
+	}
+
+	friend tracer operator/(const tracer& a, const tracer& b) {
+		return make(tape::DIV, a, b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator/(const tracer& a, const C& b) {
+		return a / tracer(b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type operator/(const C& a, const tracer& b) {
+		return tracer(a) / b;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::convertible<C, tracer>::value, tracer& >::type operator/=(tracer& a, const C& b) {
+		a = a / b;
+		return a;
+	}
+
+	friend tracer pow(const tracer& x, int y) {
+		return make(tape::POWI, x, y);
+	}
+
+	friend tracer pow(const tracer& x, const tracer& y) {
+		return make(tape::POW, x, y);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value && ! boost::is_integral<C>::value, tracer >::type pow(const tracer& x, const C& y) {
+		return pow(x, tracer(y));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, tracer>::value, tracer >::type pow(const C& x, const tracer& y) {
+		return pow(tracer(x), y);
+	}
+
+	friend tracer sqrt(const tracer& x) { return make(tape::SQRT, x); }
+	friend tracer exp(const tracer& x) { return make(tape::EXP, x); }
+	friend tracer log(const tracer& x) { return make(tape::LOG, x); }
+	friend tracer sin(const tracer& x) { return make(tape::SIN, x); }
+	friend tracer cos(const tracer& x) { return make(tape::COS, x); }
+	friend tracer tan(const tracer& x) { return make(tape::TAN, x); }
+	friend tracer asin(const tracer& x) { return make(tape::ASIN, x); }
+	friend tracer acos(const tracer& x) { return make(tape::ACOS, x); }
+	friend tracer atan(const tracer& x) { return make(tape::ATAN, x); }
+	friend tracer sinh(const tracer& x) { return make(tape::SINH, x); }
+	friend tracer cosh(const tracer& x) { return make(tape::COSH, x); }
+	friend tracer tanh(const tracer& x) { return make(tape::TANH, x); }
+	friend tracer asinh(const tracer& x) { return make(tape::ASINH, x); }
+	friend tracer acosh(const tracer& x) { return make(tape::ACOSH, x); }
+	friend tracer atanh(const tracer& x) { return make(tape::ATANH, x); }
+};
+
+
+template <class F> void tape::record(F f, int n) {
+	int i;
+	ub::vector<tracer> x(n), y;
+
+	clear();
+	current() = this;
+	try {
+		for (i=0; i<n; i++) x(i) = tracer::variable(i);
+		y = f(x);
+		for (i=0; i<(int)y.size(); i++) outputs.push_back(y(i).node());
+	}
+	catch (...) {
+		current() = NULL;
+		throw;
+	}
+	current() = NULL;
+	nvar = n;
+	finalize();
+}
+
+template <class F> void tape::record_ode(F f, int n) {
+	int i;
+	ub::vector<tracer> x(n), y;
+	tracer t;
+
+	clear();
+	current() = this;
+	try {
+		for (i=0; i<n; i++) x(i) = tracer::variable(i);
+		t = tracer::variable(n);
+		y = f(x, t);
+		for (i=0; i<(int)y.size(); i++) outputs.push_back(y(i).node());
+	}
+	catch (...) {
+		current() = NULL;
+		throw;
+	}
+	current() = NULL;
+	nvar = n + 1;
+	finalize();
+}
+
+
+// tape of scalar function R^n -> R
+
+class scalar_tape : public tape {
+	public:
+
+	template <class F> void record(F f, int n) {
+		int i;
+		ub::vector<tracer> x(n);
+		tracer y;
+
+		clear();
+		current() = this;
+		try {
+			for (i=0; i<n; i++) x(i) = tracer::variable(i);
+			y = f(x);
+			outputs.push_back(y.node());
+		}
+		catch (...) {
+			current() = NULL;
+			throw;
+		}
+		current() = NULL;
+		nvar = n;
+		finalize();
+	}
+
+	template <class T> T operator() (const ub::vector<T>& x) const {
+		std::vector<T> w(nwork);
+
+		run(x, w);
+		return w[outputs[0]];
+	}
+};
+
+} // namespace kv
+
+#endif // TAPE_HPP
@@ -0,0 +1,77 @@
+// test program for sparse storage of affine arithmetic
+// compile with -DAFFINE_SPARSE=0 to compare with dense storage
+
+#ifndef AFFINE_SPARSE
+#define AFFINE_SPARSE 1
+#endif
+
+#include <iostream>
+#include <limits>
+#include <chrono>
+
+#include <kv/ode-maffine.hpp>
+
+namespace ub = boost::numeric::ublas;
+typedef kv::affine<double> aff;
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+
+int main()
+{
+	ub::vector<aff> v;
+	ub::vector<itv> ix;
+	aff x, y, z, s1, s2;
+	itv end;
+	int i, r;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	std::cout << "AFFINE_SPARSE: " << AFFINE_SPARSE << "\n";
+
+	x = itv(1., 2.);
+	y = itv(3., 4.);
+	z = itv(-1., 1.);
+
+	// ep_2 is not included in x + z
+	std::cout << x + z << "\n";
+	std::cout << x * y - y * x << "\n";
+	std::cout << exp(x) / sqrt(y) + z << "\n";
+	std::cout << to_interval(x * y - y * x) << "\n";
+	std::cout << to_interval(exp(x) / sqrt(y) + z) << "\n";
+	std::cout << (x - x).get_maxindex() << " " << (x * y).get_coef(2) << "\n";
+
+	split(x * y + z, 2, s1, s2);
+	std::cout << s1 << "\n" << s2 << "\n";
+
+	v.resize(3);
+	v(0) = 15.; v(1) = 15.; v(2) = 36.;
+	for (i=0; i<3; i++) v(i) += itv(-1e-4, 1e-4);
+
+	end = 5.;
+	t = std::chrono::system_clock::now();
+	r = kv::odelong_maffine(Lorenz(), v, itv(0.), end, kv::ode_param<double>().set_ep_reduce(30).set_ep_reduce_limit(60));
+	if (!r) {
+		std::cout << "No Solution\n";
+	} else {
+		for (i=0; i<3; i++) {
+			std::cout << to_interval(v(i)) << "\n";
+		}
+		std::cout << end << "\n";
+		std::cout << "maxnum: " << aff::maxnum() << "\n";
+		std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	}
+}
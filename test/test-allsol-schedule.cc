@@ -0,0 +1,54 @@
+// test program for the schedulers of allsol
+// compile with -fopenmp to run in parallel
+
+#include <iostream>
+#include <chrono>
+#include <kv/allsol.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x){
+		ub::vector<T> y(2);
+
+		y(0) = x(0) * x(0) + x(1) * x(1) - 25.;
+		y(1) = sin(4. * x(0)) * cos(3. * x(1)) - x(0) / 10.;
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i, sc;
+	ub::vector<itv> I;
+	std::list< ub::vector<itv> > r[2];
+	std::list< ub::vector<itv> >::iterator p, q;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	I.resize(2);
+	for (i=0; i<I.size(); i++) I(i) = itv(-10., 10.);
+
+	for (sc=0; sc<2; sc++) {
+		t = std::chrono::system_clock::now();
+		r[sc] = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_schedule(sc).set_sort(true));
+		std::cout << "schedule " << sc << ": " << r[sc].size() << " solutions, ";
+		std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	}
+
+	for (p=r[1].begin(); p!=r[1].end(); p++) {
+		std::cout << *p << "\n";
+	}
+
+	// sorted results do not depend on the scheduler
+	kv::allsol_sub::vector_less<double> less;
+	bool same = r[0].size() == r[1].size();
+	for (p=r[0].begin(), q=r[1].begin(); same && p!=r[0].end(); p++, q++) {
+		if (less(*p, *q) || less(*q, *p)) same = false;
+	}
+	std::cout << (same ? "same results\n" : "different results\n");
+}
@@ -0,0 +1,80 @@
+// test program for allsol_callback and max_targets of allsol
+// the solutions are received by the callback as soon as they are
+// found, and the candidate intervals are moved to a file if there
+// are too many of them.
+
+#include <iostream>
+#include <chrono>
+#include <kv/allsol.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(2);
+
+		y(0) = sin(x(0)) + 0.01 * x(1);
+		y(1) = cos(x(1)) - 0.01 * x(0);
+
+		return y;
+	}
+};
+
+
+struct Counter : kv::allsol_callback<double> {
+	int& count;
+	int limit;
+
+	Counter(int& count, int limit = 0) : count(count), limit(limit) {}
+
+	virtual bool solution(const ub::vector<itv>& x) const {
+		count++;
+		if (count <= 3) std::cout << "callback: " << x << "\n";
+		if (limit > 0 && count >= limit) return false;
+		return true;
+	}
+};
+
+
+int main()
+{
+	ub::vector<itv> I(2);
+	std::list< ub::vector<itv> > s1, s2;
+	std::list< ub::vector<itv> >::iterator p1, p2;
+	int i, count, diff;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	I(0) = itv(-30., 30.);
+	I(1) = itv(-30., 30.);
+
+	t = std::chrono::system_clock::now();
+	s1 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_sort(true));
+	std::cout << s1.size() << " solutions, ";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	// streaming and spilling
+	count = 0;
+	t = std::chrono::system_clock::now();
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_max_targets(16).set_sort(true), Counter(count));
+	std::cout << s2.size() << " solutions, " << count << " callbacks, ";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	// same solutions as without spilling
+	diff = 0;
+	for (p1=s1.begin(), p2=s2.begin(); p1!=s1.end() && p2!=s2.end(); p1++, p2++) {
+		for (i=0; i<2; i++) {
+			if ((*p1)(i).lower() != (*p2)(i).lower() || (*p1)(i).upper() != (*p2)(i).upper()) diff++;
+		}
+	}
+	std::cout << "difference: " << diff << "\n";
+
+	// stop after 10 solutions
+	count = 0;
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param(), Counter(count, 10));
+	std::cout << s2.size() << " solutions, " << count << " callbacks\n";
+}
@@ -0,0 +1,134 @@
+// test program for "autodif-fixed.hpp"
+// compare autodif_fixed with autodif, and use it in
+// allsol, krawczyk_approx, optimize and odelong_maffine
+// through FixedJacobian / FixedGradient
+
+#include <iostream>
+#include <chrono>
+#include <kv/autodif-fixed.hpp>
+#include <kv/allsol.hpp>
+#include <kv/kraw-approx.hpp>
+#include <kv/optimize.hpp>
+#include <kv/ode-maffine.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(3);
+		y(0) = x(0) * x(0) + x(1) * x(1) + x(2) * x(2) - 1.;
+		y(1) = exp(x(0)) - 2. * x(1) - sin(x(2));
+		y(2) = x(0) - sqrt(x(1) + 3.) * x(2) + atan(x(2));
+		return y;
+	}
+};
+
+struct Func2 {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(2);
+		y(0) = x(0) * x(0) + x(1) * x(1) - 1.;
+		y(1) = x(0) - x(1) * x(1) * x(1);
+		return y;
+	}
+};
+
+struct Griewank {
+	template <class T> T operator() (const ub::vector<T>& x){
+		int i;
+		T s1, s2;
+		s1 = 0;
+		for (i=0; i<(int)x.size(); i++) {
+			s1 += x(i) * x(i);
+		}
+		s2 = 1;
+		for (i=0; i<(int)x.size(); i++) {
+			s2 *= cos(x(i) / sqrt(T(i + 1)));
+		}
+		return 1 + s1 / 4000. - s2;
+	}
+};
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i;
+	ub::vector<itv> I, fv1, fv2;
+	ub::matrix<itv> fd1, fd2;
+	ub::vector<double> x;
+	std::list< ub::vector<itv> > s;
+	std::list< ub::vector<itv> >::iterator p;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	I.resize(3);
+	I(0) = itv(0.1, 0.2);
+	I(1) = itv(-0.3, 0.5);
+	I(2) = itv(0.7, 0.8);
+
+	// Jacobian
+	kv::autodif<itv>::split(Func()(kv::autodif<itv>::init(I)), fv1, fd1);
+	kv::autodif_fixed<itv, 3>::split(Func()(kv::autodif_fixed<itv, 3>::init(I)), fv2, fd2);
+	std::cout << fd1 << "\n" << fd2 << "\n";
+
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100000; i++) {
+		kv::autodif<itv>::split(Func()(kv::autodif<itv>::init(I)), fv1, fd1);
+	}
+	std::cout << "autodif: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100000; i++) {
+		kv::autodif_fixed<itv, 3>::split(Func()(kv::autodif_fixed<itv, 3>::init(I)), fv2, fd2);
+	}
+	std::cout << "autodif_fixed: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	// allsol
+	for (i=0; i<3; i++) I(i) = itv(-2., 2.);
+	t = std::chrono::system_clock::now();
+	s = kv::allsol(Func(), I, 0);
+	std::cout << "allsol with autodif: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	t = std::chrono::system_clock::now();
+	s = kv::allsol(kv::FixedJacobian<Func, 3>(Func()), I, 0);
+	std::cout << "allsol with autodif_fixed: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	for (p=s.begin(); p!=s.end(); p++) std::cout << *p << "\n";
+
+	// N larger than the number of variables
+	I.resize(2);
+	s = kv::allsol(kv::FixedJacobian<Func2, 4>(Func2()), I, 0);
+	for (p=s.begin(); p!=s.end(); p++) std::cout << *p << "\n";
+	I.resize(3);
+	I(2) = itv(-2., 2.);
+
+	// krawczyk_approx
+	x.resize(3);
+	x(0) = 0.; x(1) = 0.; x(2) = 1.;
+	if (kv::krawczyk_approx(kv::FixedJacobian<Func, 3>(Func()), x, I, 5, 0)) {
+		std::cout << I << "\n";
+	}
+
+	// optimize
+	for (i=0; i<3; i++) I(i) = itv(-20., 30.);
+	std::cout << kv::minimize_value(I, kv::FixedGradient<Griewank, 3>(Griewank()), 1e-3) << "\n";
+
+	// odelong_maffine
+	itv end;
+	ub::vector< kv::affine<double> > v(3);
+	v(0) = 15.; v(1) = 15.; v(2) = 36.;
+	end = 1.;
+	if (kv::odelong_maffine(kv::FixedJacobian<Lorenz, 3>(Lorenz()), v, itv(0.), end)) {
+		for (i=0; i<3; i++) std::cout << to_interval(v(i)) << "\n";
+	}
+}
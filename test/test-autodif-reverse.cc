@@ -0,0 +1,98 @@
+// test program for "autodif-reverse.hpp"
+// compare the gradients by autodif_reverse with those by autodif,
+// and use autodif_reverse in optimize
+
+#define OPTIMIZE_REVERSE 1
+
+#include <iostream>
+#include <chrono>
+#include <kv/autodif-reverse.hpp>
+#include <kv/optimize.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(3);
+		y(0) = x(0) * x(0) + x(1) * x(1) + x(2) * x(2) - 1.;
+		y(1) = exp(x(0)) - 2. * x(1) - sin(x(2));
+		y(2) = x(0) - sqrt(x(1) + 3.) * x(2) + atan(x(2)) / x(0);
+		return y;
+	}
+};
+
+struct Griewank {
+	template <class T> T operator() (const ub::vector<T>& x){
+		int i;
+		T s1, s2;
+		s1 = 0;
+		for (i=0; i<(int)x.size(); i++) {
+			s1 += x(i) * x(i);
+		}
+		s2 = 1;
+		for (i=0; i<(int)x.size(); i++) {
+			s2 *= cos(x(i) / sqrt(T(i + 1)));
+		}
+		return 1 + s1 / 4000. - s2;
+	}
+};
+
+int main()
+{
+	int i, n;
+	ub::vector<itv> I, fv1, fv2, g1, g2;
+	ub::matrix<itv> fd1, fd2;
+	ub::vector<double> x, gd;
+	itv f1, f2;
+	double fd;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	I.resize(3);
+	I(0) = itv(0.1, 0.2);
+	I(1) = itv(-0.3, 0.5);
+	I(2) = itv(0.7, 0.8);
+
+	// Jacobian
+	kv::autodif<itv>::split(Func()(kv::autodif<itv>::init(I)), fv1, fd1);
+	kv::autodif_reverse<itv>::split(Func()(kv::autodif_reverse<itv>::init(I)), fv2, fd2);
+	std::cout << fd1 << "\n" << fd2 << "\n";
+
+	// gradient of high dimensional function
+	n = 200;
+	I.resize(n);
+	for (i=0; i<n; i++) I(i) = itv(i * 0.1, i * 0.1 + 0.01);
+
+	kv::autodif<itv>::split(Griewank()(kv::autodif<itv>::init(I)), f1, g1);
+	kv::autodif_reverse<itv>::split(Griewank()(kv::autodif_reverse<itv>::init(I)), f2, g2);
+	std::cout << f1 << "\n" << f2 << "\n";
+	std::cout << g1(n-1) << "\n" << g2(n-1) << "\n";
+	for (i=0; i<n; i++) {
+		if (!overlap(g1(i), g2(i))) std::cout << "error: " << i << "\n";
+	}
+
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100; i++) {
+		kv::autodif<itv>::split(Griewank()(kv::autodif<itv>::init(I)), f1, g1);
+	}
+	std::cout << "forward: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100; i++) {
+		kv::autodif_reverse<itv>::split(Griewank()(kv::autodif_reverse<itv>::init(I)), f2, g2);
+	}
+	std::cout << "reverse: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	// point gradient
+	x.resize(3);
+	x(0) = 1.; x(1) = 2.; x(2) = 3.;
+	kv::autodif_reverse<double>::split(Griewank()(kv::autodif_reverse<double>::init(x)), fd, gd);
+	std::cout << fd << " " << gd << "\n";
+
+	// optimize
+	I.resize(3);
+	for (i=0; i<3; i++) I(i) = itv(-20., 30.);
+	std::cout << kv::minimize_value(I, Griewank(), 1e-3) << "\n";
+}
@@ -0,0 +1,182 @@
+// test program for checkpoint of allsol and optimize
+// the search is interrupted, resumed from the checkpoint file, and
+// the results are compared with the uninterrupted search.
+
+#include <iostream>
+#include <cstdio>
+#include <stdexcept>
+#include <chrono>
+#include <kv/allsol.hpp>
+#include <kv/optimize.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(2);
+
+		y(0) = sin(x(0)) + 0.01 * x(1);
+		y(1) = cos(x(1)) - 0.01 * x(0);
+
+		return y;
+	}
+};
+
+// stop allsol after limit solutions (simulate killed process)
+struct Stopper : kv::allsol_callback<double> {
+	int& count;
+	int limit;
+
+	Stopper(int& count, int limit) : count(count), limit(limit) {}
+
+	virtual bool solution(const ub::vector<itv>& x) const {
+		count++;
+		return limit == 0 || count < limit;
+	}
+};
+
+// throw exception after limit evaluations (simulate killed process)
+int nevals = 0;
+int max_evals = 0;
+
+struct Levy {
+	template <class T> T operator() (const ub::vector<T>& x){
+		T tmp, tmp2;
+		int i;
+
+		nevals++;
+		if (max_evals > 0 && nevals > max_evals) throw std::runtime_error("killed");
+
+		tmp = 0;
+		for (i=1; i<=5; i++) {
+			tmp += i * cos((i-1)*x(0) + i);
+		}
+		tmp2 = 0;
+		for (i=1; i<=5; i++) {
+			tmp2 += i * cos((i+1)*x(1) + i);
+		}
+		return tmp * tmp2 + pow(x(0) + 1.42513, 2) + pow(x(1) + 0.80032, 2);
+	}
+};
+
+int diff(const std::list< ub::vector<itv> >& s1, const std::list< ub::vector<itv> >& s2) {
+	std::list< ub::vector<itv> >::const_iterator p1, p2;
+	int i, d = 0;
+
+	if (s1.size() != s2.size()) return -1;
+	for (p1=s1.begin(), p2=s2.begin(); p1!=s1.end(); p1++, p2++) {
+		for (i=0; i<(int)(*p1).size(); i++) {
+			if ((*p1)(i).lower() != (*p2)(i).lower() || (*p1)(i).upper() != (*p2)(i).upper()) d++;
+		}
+	}
+	return d;
+}
+
+bool exists(const char* file) {
+	std::FILE* fp = std::fopen(file, "rb");
+
+	if (fp == NULL) return false;
+	std::fclose(fp);
+	return true;
+}
+
+
+int main()
+{
+	ub::vector<itv> I(2);
+	std::list< ub::vector<itv> > s1, s2;
+	int count;
+	std::chrono::system_clock::time_point t;
+	kv::checkpoint_param cp;
+
+	std::cout.precision(17);
+
+	// allsol
+
+	std::remove("test-checkpoint-allsol.dat");
+	cp.set_file("test-checkpoint-allsol.dat").set_interval(100);
+
+	I(0) = itv(-30., 30.);
+	I(1) = itv(-30., 30.);
+
+	t = std::chrono::system_clock::now();
+	s1 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_sort(true));
+	std::cout << s1.size() << " solutions, ";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	count = 0;
+	t = std::chrono::system_clock::now();
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_checkpoint(cp), Stopper(count, 200));
+	std::cout << "interrupted: " << s2.size() << " solutions, ";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	t = std::chrono::system_clock::now();
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_checkpoint(cp).set_sort(true), Stopper(count, 0));
+	std::cout << "resumed: " << s2.size() << " solutions, ";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	std::cout << "difference: " << diff(s1, s2) << "\n";
+	std::cout << "checkpoint removed: " << !exists("test-checkpoint-allsol.dat") << "\n";
+
+	// the checkpoint of another initial box must not be used
+
+	count = 0;
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_checkpoint(cp), Stopper(count, 200));
+	std::cout << "interrupted: " << s2.size() << " solutions\n";
+
+	I(0) = itv(-20., 20.);
+	s1 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_sort(true));
+	s2 = kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_checkpoint(cp).set_sort(true));
+	std::cout << "other box: " << s2.size() << " solutions, difference: " << diff(s1, s2) << "\n";
+
+	std::remove("test-checkpoint-allsol.dat");
+
+	// optimize
+
+	std::remove("test-checkpoint-optimize.dat");
+	cp.set_file("test-checkpoint-optimize.dat").set_interval(50);
+
+	I(0) = itv(-10., 10.);
+	I(1) = itv(-10., 10.);
+
+	nevals = 0;
+	s1 = kv::minimize(I, Levy(), 1e-8, false);
+	std::cout << s1.size() << " boxes, " << nevals << " evaluations\n";
+
+	nevals = 0;
+	max_evals = 2000;
+	try {
+		s2 = kv::minimize(I, Levy(), 1e-8, false, 0, cp);
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "interrupted after " << max_evals << " evaluations\n";
+	}
+
+	nevals = 0;
+	max_evals = 0;
+	s2 = kv::minimize(I, Levy(), 1e-8, false, 0, cp);
+	std::cout << "resumed: " << s2.size() << " boxes, " << nevals << " evaluations\n";
+	std::cout << "difference: " << diff(s1, s2) << "\n";
+	std::cout << "checkpoint removed: " << !exists("test-checkpoint-optimize.dat") << "\n";
+
+	// the checkpoint of minimize must not be used by maximize
+
+	nevals = 0;
+	max_evals = 2000;
+	try {
+		s2 = kv::minimize(I, Levy(), 1e-8, false, 0, cp);
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "interrupted after " << max_evals << " evaluations\n";
+	}
+
+	nevals = 0;
+	max_evals = 0;
+	s1 = kv::maximize(I, Levy(), 1e-4, false);
+	s2 = kv::maximize(I, Levy(), 1e-4, false, 0, cp);
+	std::cout << "maximize: " << s2.size() << " boxes, difference: " << diff(s1, s2) << "\n";
+
+	std::remove("test-checkpoint-optimize.dat");
+}
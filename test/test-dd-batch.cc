@@ -0,0 +1,157 @@
+// test program for "dd-batch.hpp"
+// compare dot products of dd and interval<dd> with scalar operations
+// try to compile with -mavx2 -mfma or -mavx512f -DKV_USE_AVX512
+
+#include <kv/dd-batch.hpp>
+#include <boost/random.hpp>
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<kv::dd> itv;
+
+// exact value of x * 2^-60 as dd (|x| < 2^106)
+kv::dd exact(__int128 x)
+{
+	__int128 h;
+	double a1, a2;
+
+	a1 = (double)x;
+	h = (__int128)a1;
+	a2 = (double)(x - h);
+	return kv::dd(std::ldexp(a1, -60), std::ldexp(a2, -60));
+}
+
+double sec(std::chrono::system_clock::time_point t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+int main()
+{
+	int i, j, k, c;
+	int n = 1000;
+	long long p, q, p2, q2;
+	__int128 e;
+	kv::dd lo, up, ex;
+	kv::dd_vector x(n), y(n);
+	std::vector<itv> a(n), b(n), r1(n), r2(n);
+	itv s1, s2;
+	std::chrono::system_clock::time_point t;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_int<long long> > irand(boost::mt19937(1), boost::uniform_int<long long>(-65535, 65535));
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(2), boost::uniform_real<>(-10., 10.));
+
+	std::cout.precision(34);
+
+	// dd: the exact value must be contained
+	c = 0;
+	for (k=0; k<100; k++) {
+		e = 0;
+		for (i=0; i<n; i++) {
+			p = irand(); q = irand(); p2 = irand(); q2 = irand();
+			// x = p + q * 2^-30
+			x.set(i, kv::dd(std::ldexp((double)p, 0), 0.) + std::ldexp((double)q, -30));
+			y.set(i, kv::dd(std::ldexp((double)p2, 0), 0.) + std::ldexp((double)q2, -30));
+			e += (((__int128)p << 30) + q) * (((__int128)p2 << 30) + q2);
+		}
+		ex = exact(e);
+		lo = kv::dd_batch::dot_down(x, y);
+		up = kv::dd_batch::dot_up(x, y);
+		if (!(lo <= ex && ex <= up)) {
+			if (c == 0) std::cout << "dd error: " << lo << " " << ex << " " << up << "\n";
+			c++;
+		}
+	}
+	std::cout << "dd dot: " << c << " errors\n";
+	std::cout << lo << "\n" << up << "\n";
+
+	// interval<dd>: compare with the scalar operations
+	c = 0;
+	for (k=0; k<100; k++) {
+		for (i=0; i<n; i++) {
+			// thin intervals and intervals which contain 0
+			if (i % 3 == 0) {
+				a[i] = itv::hull(rand(), rand());
+			} else {
+				a[i] = itv(rand()) / 3.;
+			}
+			if (i % 5 == 0) {
+				b[i] = itv::hull(rand(), rand());
+			} else {
+				b[i] = itv(rand()) / 7.;
+			}
+		}
+		s1 = 0.;
+		for (i=0; i<n; i++) s1 += a[i] * b[i];
+		s2 = kv::dd_batch::dot(&a[0], 1, &b[0], 1, n);
+		if (!overlap(s1, s2) || width(s2) > width(s1) * 1.000001) {
+			if (c == 0) std::cout << "interval<dd> error: " << s1 << " " << s2 << "\n";
+			c++;
+		}
+	}
+	std::cout << "interval<dd> dot: " << c << " errors\n";
+	std::cout << s1 << "\n" << s2 << "\n";
+
+	// convolution
+	c = 0;
+	kv::dd_batch::conv(&a[0], &b[0], &r2[0], 50);
+	for (k=0; k<50; k++) {
+		s1 = 0.;
+		for (j=0; j<=k; j++) s1 += a[j] * b[k-j];
+		if (!overlap(s1, r2[k]) || width(r2[k]) > width(s1) * 1.000001) c++;
+	}
+	std::cout << "conv: " << c << " errors\n";
+
+	// psa
+	{
+		kv::psa<itv> u, v, w;
+		u.v.resize(30); v.v.resize(30);
+		for (i=0; i<30; i++) {
+			u.v(i) = a[i];
+			v.v(i) = b[i];
+		}
+		w = u * v;
+		c = 0;
+		for (k=0; k<30; k++) {
+			if (!overlap(w.v(k), r2[k])) c++;
+		}
+		std::cout << "psa: " << c << " errors\n";
+	}
+
+	// matrix
+	{
+		ub::matrix<itv> ma(20, 30), mb(30, 10), mc, md;
+		for (i=0; i<20; i++) for (j=0; j<30; j++) ma(i, j) = a[i*30+j];
+		for (i=0; i<30; i++) for (j=0; j<10; j++) mb(i, j) = b[i*10+j];
+		md = ub::prod(ma, mb);
+		kv::mm_mult(ma, mb, mc);
+		c = 0;
+		for (i=0; i<20; i++) for (j=0; j<10; j++) {
+			if (!overlap(mc(i, j), md(i, j))) c++;
+		}
+		std::cout << "mm_mult: " << c << " errors\n";
+	}
+
+	// timing
+	for (i=0; i<n; i++) {
+		a[i] = itv(rand()) / 3.;
+		b[i] = itv(rand()) / 7.;
+	}
+
+	t = std::chrono::system_clock::now();
+	for (k=0; k<1000; k++) {
+		s1 = 0.;
+		for (i=0; i<n; i++) s1 += a[i] * b[i];
+	}
+	std::cout << "scalar: " << sec(t) << " sec\n";
+
+	t = std::chrono::system_clock::now();
+	for (k=0; k<1000; k++) {
+		s2 = kv::dd_batch::dot(&a[0], 1, &b[0], 1, n);
+	}
+	std::cout << "batch: " << sec(t) << " sec\n";
+	std::cout << s1 << "\n" << s2 << "\n";
+}
@@ -0,0 +1,102 @@
+// test program for "interval-batch.hpp"
+// compare batch operations with scalar interval operations
+// try to compile with -mavx2 or -mavx512f -DKV_USE_AVX512
+
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-batch.hpp>
+#include <boost/random.hpp>
+#include <vector>
+#include <limits>
+
+typedef kv::interval<double> itv;
+
+bool same(const itv& x, const itv& y)
+{
+	return x.lower() == y.lower() && x.upper() == y.upper();
+}
+
+int check(const char* name, const std::vector<itv>& r1, const std::vector<itv>& r2)
+{
+	int i, c = 0;
+	for (i=0; i<(int)r1.size(); i++) {
+		if (!same(r1[i], r2[i])) {
+			if (c == 0) {
+				std::cout << name << " error: " << i << " " << r1[i] << " " << r2[i] << "\n";
+			}
+			c++;
+		}
+	}
+	std::cout << name << ": " << c << " mismatches\n";
+	return c;
+}
+
+int main()
+{
+	int i;
+	int n = 100003;
+	double a, b;
+	double inf = std::numeric_limits<double>::infinity();
+	std::vector<itv> x(n), y(n), z(n), r1(n), r2(n), yp(n);
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-10., 10.));
+
+	std::cout.precision(17);
+
+	for (i=0; i<n; i++) {
+		a = rand(); b = rand();
+		x[i] = itv::hull(a, b);
+		a = rand(); b = rand();
+		y[i] = itv::hull(a, b);
+		a = rand(); b = rand();
+		z[i] = itv::hull(a, b);
+		yp[i] = itv(1., 2.) + abs(y[i]);
+	}
+
+	// special values which need scalar fallback
+	x[10] = itv(0., 0.); y[10] = itv(-inf, inf);
+	x[11] = itv(0., 1.); y[11] = itv(2., inf);
+	x[12] = itv(-inf, -1.); y[12] = itv(-3., 0.);
+	x[13] = itv(1., inf); yp[13] = itv(2., inf);
+	x[14] = itv(0., 0.); y[14] = itv(0., 0.);
+
+	kv::batch::add(&x[0], &y[0], &r1[0], n);
+	for (i=0; i<n; i++) r2[i] = x[i] + y[i];
+	check("add", r1, r2);
+
+	kv::batch::sub(&x[0], &y[0], &r1[0], n);
+	for (i=0; i<n; i++) r2[i] = x[i] - y[i];
+	check("sub", r1, r2);
+
+	kv::batch::mul(&x[0], &y[0], &r1[0], n);
+	for (i=0; i<n; i++) r2[i] = x[i] * y[i];
+	check("mul", r1, r2);
+
+	kv::batch::div(&x[0], &yp[0], &r1[0], n);
+	for (i=0; i<n; i++) r2[i] = x[i] / yp[i];
+	check("div", r1, r2);
+
+	kv::batch::fma(&x[0], &y[0], &z[0], &r1[0], n);
+	for (i=0; i<n; i++) r2[i] = x[i] * y[i] + z[i];
+	check("fma", r1, r2);
+
+	std::vector<itv> r3(n);
+	kv::batch::sincos(&x[0], &r1[0], &r3[0], n);
+	for (i=0; i<n; i++) r2[i] = sin(x[i]);
+	check("sincos (sin)", r1, r2);
+	for (i=0; i<n; i++) r2[i] = cos(x[i]);
+	check("sincos (cos)", r3, r2);
+
+	// division by interval containing 0
+	try {
+		kv::batch::div(&x[0], &y[0], &r1[0], n);
+	}
+	catch (std::domain_error& e) {
+		std::cout << e.what() << "\n";
+	}
+
+	// generic version
+	std::vector< kv::interval<float> > xf(3, kv::interval<float>(1., 2.)), rf(3);
+	kv::batch::mul(&xf[0], &xf[0], &rf[0], 3);
+	std::cout << rf[2] << "\n";
+}
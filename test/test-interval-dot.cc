@@ -0,0 +1,116 @@
+// test program for "interval-dot.hpp"
+// compare accurate dot products (prod) with ub::prod
+// try to compile with -mfma
+
+#include <iostream>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-dot.hpp>
+#include <kv/kraw-approx.hpp>
+#include <boost/random.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(3);
+
+		y(0) = x(0) * x(0) + x(1) * x(1) + x(2) * x(2) - 3.;
+		y(1) = x(0) - x(1) * x(1);
+		y(2) = x(0) + 2. * x(1) - 3. * x(2);
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i, j, k, n = 100, c;
+	double tmp;
+	ub::matrix<double> r(n, n);
+	ub::matrix<itv> a(n, n);
+	ub::vector<itv> x(n), y1, y2;
+	ub::matrix<itv> m1, m2;
+	std::chrono::system_clock::time_point t;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	std::cout.precision(17);
+
+	// ill-conditioned sum: exact value is 1
+	{
+		ub::matrix<double> p(1, 3);
+		ub::vector<itv> q(3);
+		p(0, 0) = 1e16; p(0, 1) = 1.; p(0, 2) = -1e16;
+		q(0) = 1.; q(1) = 1.; q(2) = 1.;
+		std::cout << "ub::prod: " << ub::prod(p, q) << "\n";
+		std::cout << "prod: " << prod(p, q) << "\n";
+	}
+
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			r(i, j) = rand();
+			tmp = rand();
+			a(i, j) = itv(tmp, tmp + 1e-10 * std::fabs(rand()));
+		}
+		tmp = rand();
+		x(i) = itv::hull(tmp, tmp + 1e-10 * rand());
+	}
+	// intervals which contain 0
+	x(3) = itv(-1., 2.);
+	a(5, 7) = itv(-0.5, 0.5);
+
+	// matrix * vector
+	for (k=0; k<2; k++) {
+		if (k == 0) {
+			y1 = ub::prod(r, x);
+			y2 = prod(r, x);
+		} else {
+			y1 = ub::prod(a, x);
+			y2 = prod(a, x);
+		}
+		c = 0;
+		for (i=0; i<n; i++) {
+			if (!subset(y2(i), y1(i))) c++;
+		}
+		std::cout << (k == 0 ? "point" : "interval") << " matrix * vector: " << c << " not subset\n";
+		std::cout << y1(0) << " " << width(y1(0)) << "\n";
+		std::cout << y2(0) << " " << width(y2(0)) << "\n";
+	}
+
+	// matrix * matrix, residual of the Krawczyk operator
+	t = std::chrono::system_clock::now();
+	m1 = ub::identity_matrix<itv>(n) - ub::prod(r, a);
+	std::cout << "ub::prod: " << elapsed(t) << " sec\n";
+	t = std::chrono::system_clock::now();
+	m2 = ub::identity_matrix<itv>(n) - prod(r, a);
+	std::cout << "prod: " << elapsed(t) << " sec\n";
+	c = 0;
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			if (!subset(m2(i, j), m1(i, j))) c++;
+		}
+	}
+	std::cout << "matrix * matrix: " << c << " not subset\n";
+	std::cout << m1(0, 0) << " " << width(m1(0, 0)) << "\n";
+	std::cout << m2(0, 0) << " " << width(m2(0, 0)) << "\n";
+
+	// Krawczyk
+	{
+		ub::vector<double> c0(3);
+		ub::vector<itv> result;
+		c0(0) = 1.1; c0(1) = 0.9; c0(2) = 1.05;
+		if (kv::krawczyk_approx(Func(), c0, result, 2, 0)) {
+			std::cout << result << "\n";
+			for (i=0; i<3; i++) std::cout << width(result(i)) << "\n";
+		}
+	}
+}
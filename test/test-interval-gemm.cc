@@ -0,0 +1,109 @@
+// test program for "interval-gemm.hpp"
+// compare mm_mult (midpoint-radius product) with ub::prod
+// try to compile with -fopenmp
+
+#include <iostream>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-gemm.hpp>
+#include <boost/random.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+int main()
+{
+	int i, j, l, n = 200;
+	ub::matrix<itv> a(n, n), b(n, n), c1, c2, pc;
+	ub::matrix<double> pa(n, n), pb(n, n), r, e;
+	double tmp, wr, wmax, emax, za[2], zb[2], zc;
+	bool ok;
+	std::chrono::system_clock::time_point t;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	std::cout.precision(17);
+
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			tmp = rand();
+			a(i, j) = itv(tmp, tmp + 1e-3 * std::fabs(rand()));
+			tmp = rand();
+			b(i, j) = itv(tmp, tmp + 1e-3 * std::fabs(rand()));
+		}
+	}
+
+	t = std::chrono::system_clock::now();
+	c1 = ub::prod(a, b);
+	std::cout << "ub::prod: " << elapsed(t) << " sec\n";
+
+	t = std::chrono::system_clock::now();
+	kv::mm_mult(a, b, c2);
+	std::cout << "mm_mult: " << elapsed(t) << " sec\n";
+
+	// maximum of width(c2) / width(c1)
+	wmax = 0.;
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			wr = width(c2(i, j)) / width(c1(i, j));
+			if (wr > wmax) wmax = wr;
+		}
+	}
+	std::cout << "width ratio: " << wmax << "\n";
+
+	// products of point matrices in a and b must be included
+	ok = true;
+	for (l=0; l<3; l++) {
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				pa(i, j) = a(i, j).lower() + (l / 2.) * width(a(i, j));
+				pb(i, j) = b(i, j).upper() - (l / 2.) * width(b(i, j));
+			}
+		}
+		pc = ub::prod(ub::matrix<itv>(pa), ub::matrix<itv>(pb));
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				if (!subset(pc(i, j), c2(i, j))) ok = false;
+			}
+		}
+	}
+	std::cout << (ok ? "included\n" : "NOT included\n");
+
+	// mixed product
+	kv::mm_mult(pa, b, c2);
+	pc = ub::prod(ub::matrix<itv>(pa), ub::matrix<itv>(pb));
+	ok = true;
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			if (!subset(pc(i, j), c2(i, j))) ok = false;
+		}
+	}
+	std::cout << (ok ? "mixed: included\n" : "mixed: NOT included\n");
+
+	// inversion
+	t = std::chrono::system_clock::now();
+	kv::invert(pa, r);
+	std::cout << "invert: " << elapsed(t) << " sec\n";
+	kv::mm_mult(r, pa, e);
+	emax = 0.;
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			tmp = std::fabs(e(i, j) - ((i == j) ? 1. : 0.));
+			if (tmp > emax) emax = tmp;
+		}
+	}
+	std::cout << "max |R A - I|: " << emax << "\n";
+
+	// 0 * inf gives NaN as in the naive product
+	za[0] = 0.; za[1] = 1.;
+	zb[0] = std::numeric_limits<double>::infinity(); zb[1] = 2.;
+	kv::gemm(1, 1, 2, za, 2, zb, 1, &zc, 1);
+	std::cout << "0 * inf + 1 * 2: " << zc << "\n";
+}
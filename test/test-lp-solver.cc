@@ -0,0 +1,85 @@
+// test program for lp_solver
+// compare with lp_minimize and lp_minimize_verified on random problems
+// with the same constraints and different objective functions
+
+#include <iostream>
+#include <list>
+#include <chrono>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/random.hpp>
+
+#include <kv/lp.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+int main()
+{
+	int i, j, k, m = 30, n = 40, nobj = 50, c1, c2;
+	double r1, r2, r3, t1, t2;
+	int pivots;
+	ub::vector<double> objfunc(n + 1), tmp(n + 1);
+	std::list< ub::vector<double> > constraints;
+	std::vector< ub::vector<double> > objs;
+	std::chrono::system_clock::time_point t;
+	kv::lp_solver<double> lp;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	std::cout.precision(17);
+
+	// bounded feasible region: random rows and 0 <= x_j <= 1
+	for (i=0; i<m; i++) {
+		tmp(0) = -std::fabs(rand()) - 0.1;
+		for (j=1; j<=n; j++) tmp(j) = rand();
+		constraints.push_back(tmp);
+	}
+	for (j=1; j<=n; j++) {
+		tmp(0) = -1.;
+		for (k=1; k<=n; k++) tmp(k) = (k == j) ? 1. : 0.;
+		constraints.push_back(tmp);
+	}
+
+	for (k=0; k<nobj; k++) {
+		objfunc(0) = rand();
+		for (j=1; j<=n; j++) objfunc(j) = rand();
+		objs.push_back(objfunc);
+	}
+
+	lp.set_constraints(constraints);
+	c1 = c2 = 0;
+	pivots = 0;
+	for (k=0; k<nobj; k++) {
+		r1 = kv::lp_minimize(objs[k], constraints);
+		r2 = lp.minimize(objs[k]);
+		pivots += lp.pivots;
+		r3 = lp.minimize_verified(objs[k]);
+		if (std::fabs(r1 - r2) > 1e-10 * (1. + std::fabs(r1))) {
+			if (c1 == 0) std::cout << "approximate: " << r1 << " " << r2 << "\n";
+			c1++;
+		}
+		if (r3 > r1 || r1 - r3 > 1e-10 * (1. + std::fabs(r1))) {
+			if (c2 == 0) std::cout << "verified: " << r1 << " " << r3 << "\n";
+			c2++;
+		}
+	}
+	std::cout << "approximate: " << c1 << " errors\n";
+	std::cout << "verified: " << c2 << " errors\n";
+	std::cout << "pivots with warm start: " << pivots << "\n";
+
+	// timing
+	t = std::chrono::system_clock::now();
+	for (k=0; k<nobj; k++) r1 = kv::lp_minimize_verified(objs[k], constraints, -1);
+	t1 = elapsed(t);
+	t = std::chrono::system_clock::now();
+	for (k=0; k<nobj; k++) r2 = lp.minimize_verified(objs[k]);
+	t2 = elapsed(t);
+	std::cout << r1 << " " << r2 << "\n";
+	std::cout << "lp_minimize_verified: " << t1 << " sec\n";
+	std::cout << "lp_solver: " << t2 << " sec\n";
+}
@@ -0,0 +1,80 @@
+// test program for the mpfr_t pool, move and in-place operators of mpfr
+// and psa_dot of interval<mpfr> by mpfr_fma
+// compare with -DMPFR_POOL=0
+
+#include <iostream>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/mpfr.hpp>
+#include <kv/rmpfr.hpp>
+#include <kv/psa.hpp>
+
+typedef kv::mpfr<106> mp;
+typedef kv::interval<mp> itv;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+int main()
+{
+	int i, j, k, n = 100000, m = 40;
+	mp a, b, c;
+	itv x, y, s;
+	kv::psa<itv> p, q, r;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(33);
+
+	// in-place operators give the same results as binary operators
+	a = 1.; a /= 3.;
+	b = mp(1.) / mp(3.);
+	std::cout << a << "\n" << b << "\n";
+	a = 2.; a *= b; a -= 1; a += b;
+	std::cout << a << "\n" << (mp(2.) * b - mp(1.) + b) << "\n";
+
+	// fma
+	c = fma(b, mp(3.), mp(-1.));
+	std::cout << c << "\n";
+
+	// timing
+	x = itv(1., 2.) / 3.;
+	y = itv(2., 3.) / 7.;
+	t = std::chrono::system_clock::now();
+	s = 0.;
+	for (i=0; i<n; i++) {
+		s += x * y - (x + y) / 10.;
+	}
+	std::cout << s << "\n";
+	std::cout << "interval arithmetic: " << elapsed(t) << " sec\n";
+
+	t = std::chrono::system_clock::now();
+	s = 0.;
+	for (i=0; i<n/100; i++) {
+		s += exp(x) + sin(y);
+	}
+	std::cout << s << "\n";
+	std::cout << "exp and sin: " << elapsed(t) << " sec\n";
+
+	// psa multiplication uses psa_dot (one mpfr_fma for each bound)
+	p.v.resize(m);
+	q.v.resize(m);
+	for (i=0; i<m; i++) {
+		p.v(i) = itv(-1., 2.) / (double)(i + 1);
+		q.v(i) = itv(1., 3.) / (double)(i + 2);
+	}
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100; i++) r = p * q;
+	std::cout << "psa multiplication: " << elapsed(t) << " sec\n";
+
+	// contained in the sums of the interval products
+	k = 0;
+	for (i=0; i<m; i++) {
+		s = 0.;
+		for (j=0; j<=i; j++) s += p.v(j) * q.v(i-j);
+		if (!subset(r.v(i), s)) k++;
+	}
+	std::cout << r.v(m-1) << "\n" << s << "\n";
+	std::cout << "not contained: " << k << "\n";
+}
@@ -0,0 +1,108 @@
+// test program for "ode-ensemble.hpp"
+// integrate ODEs from many initial boxes. the pieces which fail or
+// give too wide solutions are bisected.
+
+#include <iostream>
+#include <chrono>
+#include <kv/ode-ensemble.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::affine<double> aff;
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+// fails if x(0) contains negative values
+struct Sqrt {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(2);
+
+		y(0) = sqrt(x(0));
+		y(1) = - x(1);
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i, r;
+	std::list< ub::vector<itv> > init;
+	std::list< ub::vector<aff> > inita;
+	std::list< kv::ode_ensemble_result<double> > result;
+	std::list< kv::ode_ensemble_result<double> >::iterator p;
+	ub::vector<itv> x(3), hull;
+	ub::vector<aff> a(3);
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	// initial boxes of different sizes
+	for (i=0; i<8; i++) {
+		x(0) = 15. + i + itv(-1., 1.) * (1e-6 * (1 << (2 * i)));
+		x(1) = 15.;
+		x(2) = 36.;
+		init.push_back(x);
+	}
+
+	t = std::chrono::system_clock::now();
+	r = kv::ode_ensemble(Lorenz(), init, itv(0.), itv(1.), result, hull);
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	std::cout << "return: " << r << "\n";
+	for (p=result.begin(); p!=result.end(); p++) {
+		std::cout << p->index << " " << p->depth << " " << p->ret << " " << p->end << " " << p->x(0) << "\n";
+	}
+	std::cout << hull << "\n";
+
+	// failure and bisection
+	init.clear();
+	x.resize(2);
+	x(0) = itv(-0.5, 2.);
+	x(1) = 1.;
+	init.push_back(x);
+	x(0) = itv(1., 3.);
+	init.push_back(x);
+	result.clear();
+	r = kv::ode_ensemble(Sqrt(), init, itv(0.), itv(1.), result, hull, kv::ode_param<double>(), kv::ode_ensemble_param<double>().set_max_depth(3));
+	std::cout << "return: " << r << "\n";
+	for (p=result.begin(); p!=result.end(); p++) {
+		std::cout << p->index << " " << p->depth << " " << p->ret << " " << p->init(0) << " " << p->x(0) << "\n";
+	}
+	std::cout << hull << "\n";
+
+	// max_width and lohner
+	init.pop_front();
+	result.clear();
+	r = kv::ode_ensemble(Sqrt(), init, itv(0.), itv(1.), result, hull, kv::ode_param<double>(), kv::ode_ensemble_param<double>().set_method(1).set_max_width(1.));
+	std::cout << "return: " << r << ", pieces: " << result.size() << "\n";
+	std::cout << hull << "\n";
+
+	// affine initial sets sharing a noise symbol
+	aff e;
+	e = itv(-1e-4, 1e-4);
+	for (i=0; i<3; i++) {
+		a(0) = 15. + i + e;
+		a(1) = 15. - e;
+		a(2) = 36.;
+		inita.push_back(a);
+	}
+	result.clear();
+	r = kv::ode_ensemble(Lorenz(), inita, itv(0.), itv(1.), result, hull);
+	std::cout << "return: " << r << "\n";
+	for (p=result.begin(); p!=result.end(); p++) {
+		std::cout << p->index << " " << p->depth << " " << p->ret << " " << p->x << "\n";
+	}
+	std::cout << "maxnum: " << aff::maxnum() << "\n";
+}
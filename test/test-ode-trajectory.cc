@@ -0,0 +1,90 @@
+// test program for "ode-trajectory.hpp"
+// write the trajectory of Lorenz equation to files, and compare
+// the values read from the files with ode_callback_dense_list
+
+#include <iostream>
+#include <list>
+#include <chrono>
+
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-trajectory.hpp>
+
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+
+int main()
+{
+	ub::vector<itv> x(3), ix, y;
+	itv end, start, end2;
+	int r, i, err;
+	std::list<itv> time_list;
+	std::list< ub::vector<itv> > value_list;
+	std::list<itv>::iterator pt;
+	std::list< ub::vector<itv> >::iterator pv;
+	ub::vector< kv::psa<itv> > result;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+
+	// write
+	kv::trajectory_writer<double> w("test-ode-trajectory.dat");
+	ix = x;
+	end = 10.;
+	r = kv::odelong_maffine(Lorenz(), ix, itv(0.), end, kv::ode_param<double>(), kv::ode_callback_trajectory<double>(w));
+	w.close();
+	std::cout << r << " " << end << " " << w.size() << " steps\n";
+
+	// reference
+	ix = x;
+	end = 10.;
+	r = kv::odelong_maffine(Lorenz(), ix, itv(0.), end, kv::ode_param<double>(), kv::ode_callback_dense_list<double>(itv(0.), itv(0.125), time_list, value_list));
+
+	// read
+	kv::trajectory_reader<double> rd("test-ode-trajectory.dat");
+	std::cout << rd.size() << " steps\n";
+	rd.get(rd.size() - 1, start, end2, result);
+	std::cout << start << " " << end2 << "\n";
+
+	err = 0;
+	t = std::chrono::system_clock::now();
+	for (pt=time_list.begin(), pv=value_list.begin(); pt!=time_list.end(); pt++, pv++) {
+		if (!rd.eval(*pt, y)) {
+			err++;
+			continue;
+		}
+		for (i=0; i<3; i++) {
+			if (!subset((*pv)(i), y(i))) err++;
+		}
+	}
+	std::cout << "errors: " << err << " in " << time_list.size() << " points\n";
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	rd.eval(itv(5.), y);
+	std::cout << y << "\n";
+	std::cout << rd.find(5.) << "\n";
+
+	// interval of time over some steps
+	rd.eval(itv(5., 5.1), y);
+	std::cout << y << "\n";
+
+	// out of range
+	std::cout << rd.eval(itv(9., 11.), y) << "\n";
+}
@@ -0,0 +1,66 @@
+// test program for the processing order of optimize
+// compile with -DOPTIMIZE_ORDER=0,1,2,3 and compare the number of
+// evaluations. add -DOPTIMIZE_PARALLEL=1 -fopenmp to run in parallel.
+
+#include <iostream>
+#include <chrono>
+#include <kv/optimize.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+// count evaluations on intervals
+int count_eval = 0;
+
+/*
+ * Griewank Function
+ *  https://www.sfu.ca/~ssurjano/griewank.html
+ */
+struct Griewank {
+	int n;
+	Griewank(int n): n(n) {
+	}
+	template <class T> T operator() (const ub::vector<T>& x){
+		int i;
+		T s1, s2;
+
+		#ifdef _OPENMP
+		#pragma omp atomic
+		#endif
+		count_eval++;
+
+		s1 = 0;
+		for (i=0; i<n; i++) {
+			s1 += x(i) * x(i);
+		}
+		s2 = 1;
+		for (i=0; i<n; i++) {
+			s2 *= cos(x(i) / sqrt(T(i + 1)));
+		}
+		return 1 + s1 / 4000. - s2;
+	}
+};
+
+int main()
+{
+	int i, n;
+	ub::vector<itv> I;
+	itv v;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	std::cout << "OPTIMIZE_ORDER: " << OPTIMIZE_ORDER << "\n";
+
+	for (n=2; n<=4; n++) {
+		I.resize(n);
+		for (i=0; i<n; i++) I(i) = itv(-20., 30.);
+
+		count_eval = 0;
+		t = std::chrono::system_clock::now();
+		v = kv::minimize_value(I, Griewank(n), 1e-3);
+		std::cout << "n=" << n << ": " << v << ", " << count_eval << " evaluations, ";
+		std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	}
+}
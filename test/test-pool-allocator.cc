@@ -0,0 +1,48 @@
+// test program for "pool-allocator.hpp"
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/pool-allocator.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/psa.hpp>
+
+namespace ub = boost::numeric::ublas;
+typedef kv::interval<double> itv;
+
+int main()
+{
+	int i, j;
+	void *p, *q;
+	kv::psa<itv> x, y;
+	std::chrono::system_clock::time_point t;
+
+	// freed block is reused by next allocation of same size class
+	p = kv::pool_memory::allocate(100);
+	kv::pool_memory::deallocate(p, 100);
+	q = kv::pool_memory::allocate(120);
+	std::cout << (p == q) << "\n";
+	kv::pool_memory::deallocate(q, 120);
+
+	std::vector< double, kv::pool_allocator<double> > v;
+	for (i=0; i<1000; i++) v.push_back(i);
+	std::cout << v[999] << "\n";
+
+	ub::vector< itv, ub::unbounded_array< itv, kv::pool_allocator<itv> > > w(10);
+	for (i=0; i<10; i++) w(i) = itv(i, i+1);
+	std::cout << w << "\n";
+
+	// psa uses pool_allocator unless PSA_POOL=0
+	x.v.resize(25);
+	for (i=0; i<25; i++) x.v(i) = itv(1., 2.) / (i + 1.);
+	t = std::chrono::system_clock::now();
+	for (j=0; j<100000; j++) {
+		y = x * x + x;
+	}
+	std::cout << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	std::cout << y.v(24) << "\n";
+
+	kv::pool_memory::release();
+}
@@ -0,0 +1,107 @@
+// test program for the elementary functions of psa
+// (exp, log, sin, cos, sqrt, inv by the recurrences)
+
+#include <iostream>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/psa.hpp>
+
+typedef kv::interval<double> itv;
+typedef kv::psa<itv> psa;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+// check y(t) in eval(r, t) for sample points t in the domain
+template <class F> int check(const char* name, F f, const psa& x, const psa& r)
+{
+	int i, j, c = 0;
+	itv t, xt;
+	int s = x.v.size();
+
+	for (i=0; i<=100; i++) {
+		t = psa::domain().lower() + width(psa::domain()) * (i / 100.);
+		xt = 0.;
+		for (j=s-1; j>=0; j--) xt = xt * t + x.v(j);
+		if (!overlap(f(xt), eval(r, t))) c++;
+	}
+	std::cout << name << ": " << c << " errors, last coefficient: " << r.v(s-1) << "\n";
+	return c;
+}
+
+itv f_exp(const itv& x) { return exp(x); }
+itv f_log(const itv& x) { return log(x); }
+itv f_sin(const itv& x) { return sin(x); }
+itv f_cos(const itv& x) { return cos(x); }
+itv f_sqrt(const itv& x) { return sqrt(x); }
+itv f_inv(const itv& x) { return 1. / x; }
+
+int main()
+{
+	int i, n = 10;
+	psa x, y, z;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	x.v.resize(n + 1);
+	for (i=0; i<=n; i++) x.v(i) = 2. / (i + 1.);
+
+	// Type-I: identities
+	y = exp(log(x)) - x;
+	std::cout << "exp(log(x)) - x: " << y << "\n";
+	y = sin(x) * sin(x) + cos(x) * cos(x) - 1.;
+	std::cout << "sin^2 + cos^2 - 1: " << y << "\n";
+	y = sqrt(x) * sqrt(x) - x;
+	std::cout << "sqrt(x)^2 - x: " << y << "\n";
+	y = inv(x) * x - 1.;
+	std::cout << "inv(x) * x - 1: " << y << "\n";
+
+	// Type-II: x is a polynomial, the results must contain f(x(t))
+	psa::mode() = 2;
+	for (i=0; i<2; i++) {
+		psa::domain() = (i == 0) ? itv(0., 0.1) : itv(0., 1.);
+		std::cout << "domain: " << psa::domain() << "\n";
+		check("exp", f_exp, x, exp(x));
+		check("log", f_log, x, log(x));
+		check("sin", f_sin, x, sin(x));
+		check("cos", f_cos, x, cos(x));
+		check("sqrt", f_sqrt, x, sqrt(x));
+		check("inv", f_inv, x, inv(x));
+	}
+	psa::mode() = 1;
+
+	// history: same result as without history
+	x = 1.;
+	for (i=0; i<5; i++) {
+		x = 1. + integrate(-exp(x) * sin(x) + cos(x) / sqrt(x) - log(x));
+	}
+	std::cout << x << "\n";
+	x = 1.;
+	psa::record_history() = true;
+	for (i=0; i<5; i++) {
+		if (i == 1) psa::use_history() = true;
+		if (i == 4) psa::record_history() = false;
+		x = 1. + integrate(-exp(x) * sin(x) + cos(x) / sqrt(x) - log(x));
+	}
+	psa::use_history() = false;
+	std::cout << x << "\n";
+	std::cout << psa::history().size() << "\n";
+
+	// timing
+	n = 200;
+	x.v.resize(n + 1);
+	for (i=0; i<=n; i++) x.v(i) = itv(1., 1.125) / (i + 1.);
+	for (i=1; i<=2; i++) {
+		psa::mode() = i;
+		psa::domain() = itv(0., 0.125);
+		t = std::chrono::system_clock::now();
+		y = exp(x);
+		z = sin(x);
+		std::cout << "type " << i << ", order " << n << ": " << elapsed(t) << " sec\n";
+	}
+	psa::mode() = 1;
+}
@@ -0,0 +1,83 @@
+// test program for psa_mul (Karatsuba multiplication of psa)
+// psa_mul is called directly, since it is not used by operator*
+// for interval<double> and interval<dd>
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#include <kv/psa.hpp>
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+// dyadic coefficients m(k) 2^(g k) with small integers m(k), so that
+// the products of the same order have the same exponent and the exact
+// convolution is an integer times 2^(g k). a is widened by radius w
+// (the exact value of the point coefficients is still contained).
+template <class T> void test(int n, int g, double w)
+{
+	typedef typename kv::psa<T>::vector_type V;
+	int i, j, c;
+	V a(n), b(n), c1(2 * n - 1), c2;
+	std::vector<long long> ma(n), mb(n);
+	long long sum;
+	double e, w1, w2;
+	std::chrono::system_clock::time_point t;
+	T tmp;
+
+	for (i=0; i<n; i++) {
+		ma[i] = (i % 3 == 1 ? -1 : 1) * (1 + (7 * i + 3) % 31);
+		mb[i] = 1 + (11 * i + 5) % 29;
+		a(i) = T(std::ldexp((double)ma[i], g * i));
+		b(i) = T(std::ldexp((double)mb[i], g * i));
+		if (w > 0.) a(i) *= T(1.) + T(-w, w);
+	}
+
+	t = std::chrono::system_clock::now();
+	for (i=0; i<2*n-1; i++) {
+		tmp = 0.;
+		for (j=std::max(0, i-n+1); j<=std::min(i, n-1); j++) tmp += a(j) * b(i-j);
+		c1(i) = tmp;
+	}
+	std::cout << "n=" << n << " g=" << g << " w=" << w << "\n";
+	std::cout << "  naive: " << elapsed(t) << " sec\n";
+
+	t = std::chrono::system_clock::now();
+	kv::psa_mul<T>::mul(a, b, c2);
+	std::cout << "  karatsuba: " << elapsed(t) << " sec\n";
+
+	// the results must contain the exact values, compare the relative widths
+	c = 0;
+	w1 = w2 = 0.;
+	for (i=0; i<2*n-1; i++) {
+		sum = 0;
+		for (j=std::max(0, i-n+1); j<=std::min(i, n-1); j++) sum += ma[j] * mb[i-j];
+		e = std::ldexp((double)sum, g * i);
+		if (!subset(T(e), c1(i)) || !subset(T(e), c2(i))) c++;
+		if (e == 0.) continue;
+		w1 = std::max(w1, (double)(width(c1(i)) / std::fabs(e)));
+		w2 = std::max(w2, (double)(width(c2(i)) / std::fabs(e)));
+	}
+	std::cout << "  " << c << " errors, relative width: " << w1 << " " << w2 << "\n";
+}
+
+int main()
+{
+	int n;
+
+	std::cout.precision(5);
+
+	for (n=32; n<=256; n*=2) {
+		test< kv::interval<double> >(n, 1, 0.);
+		test< kv::interval<double> >(n, -1, 1e-8);
+		test< kv::interval<kv::dd> >(n, 1, 0.);
+		test< kv::interval<kv::dd> >(n, -1, 1e-20);
+	}
+}
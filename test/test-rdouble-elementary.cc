@@ -0,0 +1,136 @@
+// test program for "rdouble-elementary.hpp"
+// compare exp, log, sin, cos and tan of interval<double> with those of interval<dd>
+
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#include <boost/random.hpp>
+#include <limits>
+
+typedef kv::interval<double> itv;
+typedef kv::interval<kv::dd> itvd;
+
+double ulps(const itv& x)
+{
+	double u = std::fabs(x.upper()) * std::numeric_limits<double>::epsilon();
+	if (u < std::numeric_limits<double>::denorm_min()) u = std::numeric_limits<double>::denorm_min();
+	return width(x) / u;
+}
+
+int main()
+{
+	int i, bad_exp = 0, bad_log = 0;
+	double x, w, wmax_exp = 0., wmax_log = 0.;
+	itv r;
+	itvd rd;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	std::cout.precision(17);
+
+	for (i=0; i<100000; i++) {
+		if (i % 2 == 0) x = rand();
+		else x = rand() * 700.;
+
+		r = exp(itv(x));
+		rd = exp(itvd(x));
+		if (!(r.lower() <= rd.lower() && rd.upper() <= r.upper())) {
+			if (bad_exp == 0) std::cout << "exp error: " << x << " " << r << " " << rd << "\n";
+			bad_exp++;
+		}
+		w = ulps(r);
+		if (w > wmax_exp) wmax_exp = w;
+
+		x = std::ldexp(std::fabs(rand()) + 0.5, (int)(rand() * 1000.));
+		if (i < 1000) x = 1. + rand() * 1e-3;
+
+		r = log(itv(x));
+		rd = log(itvd(x));
+		if (!(r.lower() <= rd.lower() && rd.upper() <= r.upper())) {
+			if (bad_log == 0) std::cout << "log error: " << x << " " << r << " " << rd << "\n";
+			bad_log++;
+		}
+		w = ulps(r);
+		if (w > wmax_log) wmax_log = w;
+	}
+
+	int bad_sin = 0, bad_cos = 0, bad_tan = 0;
+	double wmax_sin = 0., wmax_cos = 0., wmax_tan = 0.;
+	itv I;
+	itvd Id;
+
+	for (i=0; i<100000; i++) {
+		x = rand();
+		if (i % 3 == 1) x *= 10.;
+		if (i % 3 == 2) x *= 1e6;
+		if (i % 5 == 0) I = itv(x);
+		else I = itv::hull(x, x + std::fabs(rand()) * 3.);
+		Id = itvd(I.lower(), I.upper());
+
+		r = sin(I);
+		rd = sin(Id);
+		if (!(r.lower() <= rd.lower() && rd.upper() <= r.upper())) {
+			if (bad_sin == 0) std::cout << "sin error: " << I << " " << r << " " << rd << "\n";
+			bad_sin++;
+		}
+		if (I.lower() == I.upper()) {
+			w = ulps(r);
+			if (w > wmax_sin) wmax_sin = w;
+		}
+
+		r = cos(I);
+		rd = cos(Id);
+		if (!(r.lower() <= rd.lower() && rd.upper() <= r.upper())) {
+			if (bad_cos == 0) std::cout << "cos error: " << I << " " << r << " " << rd << "\n";
+			bad_cos++;
+		}
+		if (I.lower() == I.upper()) {
+			w = ulps(r);
+			if (w > wmax_cos) wmax_cos = w;
+		}
+
+		r = tan(I);
+		rd = tan(Id);
+		if (!(r.lower() <= rd.lower() && rd.upper() <= r.upper())) {
+			if (bad_tan == 0) std::cout << "tan error: " << I << " " << r << " " << rd << "\n";
+			bad_tan++;
+		}
+		if (I.lower() == I.upper()) {
+			w = ulps(r);
+			if (w > wmax_tan) wmax_tan = w;
+		}
+	}
+
+	std::cout << "exp: " << bad_exp << " errors, max width " << wmax_exp << " ulps\n";
+	std::cout << "log: " << bad_log << " errors, max width " << wmax_log << " ulps\n";
+	std::cout << "sin: " << bad_sin << " errors, max width " << wmax_sin << " ulps\n";
+	std::cout << "cos: " << bad_cos << " errors, max width " << wmax_cos << " ulps\n";
+	std::cout << "tan: " << bad_tan << " errors, max width " << wmax_tan << " ulps\n";
+
+	std::cout << exp(itv(0.)) << "\n";
+	std::cout << exp(itv(1.)) << "\n";
+	std::cout << exp(itv(-1., 1.)) << "\n";
+	std::cout << exp(itv(800.)) << "\n";
+	std::cout << exp(itv(-800.)) << "\n";
+	std::cout << exp(itv(-740.)) << "\n";
+	std::cout << log(itv(1.)) << "\n";
+	std::cout << log(itv(2.)) << "\n";
+	std::cout << log(itv(0.5, 3.)) << "\n";
+	std::cout << log(itv(0., 1.)) << "\n";
+	std::cout << log(itv(std::numeric_limits<double>::denorm_min())) << "\n";
+	std::cout << log(itv(std::numeric_limits<double>::infinity())) << "\n";
+	std::cout << expm1(itv(1e-10)) << "\n";
+	std::cout << sinh(itv(3.)) << "\n";
+	std::cout << pow(itv(2.), itv(0.5)) << "\n";
+	std::cout << sin(itv(1.)) << "\n";
+	std::cout << cos(itv(1.)) << "\n";
+	std::cout << tan(itv(1.)) << "\n";
+	std::cout << sin(itv(3.141592653589793)) << "\n";
+	std::cout << cos(itv(1.5707963267948966)) << "\n";
+	std::cout << sin(itv(1e6)) << "\n";
+	std::cout << sin(itv(1e22)) << "\n";
+	std::cout << sin(itv(1., 2.)) << "\n";
+	std::cout << cos(itv(-1., 4.)) << "\n";
+	std::cout << tan(itv(1., 2.)) << "\n";
+}
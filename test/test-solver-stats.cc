@@ -0,0 +1,76 @@
+// test program for solver_stats
+// statistics of odelong_maffine, allsol and optimize
+
+#include <iostream>
+#include <kv/ode-maffine.hpp>
+#include <kv/allsol.hpp>
+#include <kv/optimize.hpp>
+#include <kv/solver-stats.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(2);
+
+		y(0) = sin(x(0)) + 0.01 * x(1);
+		y(1) = cos(x(1)) - 0.01 * x(0);
+
+		return y;
+	}
+};
+
+struct Rosenbrock {
+	template <class T> T operator() (const ub::vector<T>& x){
+		T tmp, tmp2;
+		tmp = 1. - x(0);
+		tmp2 = x(1) - x(0) * x(0);
+		return tmp * tmp + 100. * tmp2 * tmp2;
+	}
+};
+
+
+int main()
+{
+	ub::vector<itv> x(3), I(2);
+	itv end;
+	int r;
+	kv::solver_stats st;
+
+	// ode
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 5.;
+	r = kv::odelong_maffine(Lorenz(), x, itv(0.), end, kv::ode_param<double>().set_stats(&st));
+	std::cout << r << " " << end << "\n";
+	std::cout << "steps: " << st.get_count("ode_steps") << ", rejected: " << st.get_count("ode_rejected") << "\n";
+	st.print(std::cout);
+
+	// allsol
+	st.clear();
+	I(0) = itv(-30., 30.);
+	I(1) = itv(-30., 30.);
+	kv::allsol(Func(), I, 0, 0., (std::list< ub::vector<itv> >*)NULL, kv::allsol_param().set_stats(&st));
+	st.print(std::cout, "json");
+
+	// optimize
+	st.clear();
+	I(0) = itv(-10., 10.);
+	I(1) = itv(-10., 10.);
+	kv::minimize(I, Rosenbrock(), 1e-8, true, 0, kv::checkpoint_param(), &st);
+	st.print(std::cout, "csv");
+}
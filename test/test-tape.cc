@@ -0,0 +1,133 @@
+// test program for "tape.hpp"
+// record functions once by tracer and evaluate the tapes with
+// interval, affine and autodif, and use them in allsol, optimize
+// and odelong_maffine
+
+#include <iostream>
+#include <chrono>
+#include <kv/tape.hpp>
+#include <kv/allsol.hpp>
+#include <kv/optimize.hpp>
+#include <kv/ode-maffine.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::affine<double> aff;
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(3);
+		// x(2) * x(2) and sin(x(2)) are recorded only once
+		y(0) = x(0) * x(0) + x(1) * x(1) + x(2) * x(2) - 1.;
+		y(1) = exp(x(0)) - 2. * x(1) - sin(x(2));
+		y(2) = x(0) - sqrt(x(1) + 3.) * x(2) + atan(x(2)) + 0.5 * (sin(x(2)) - x(2) * x(2));
+		return y;
+	}
+};
+
+struct Griewank {
+	template <class T> T operator() (const ub::vector<T>& x){
+		int i;
+		T s1, s2;
+		s1 = 0;
+		for (i=0; i<(int)x.size(); i++) {
+			s1 += x(i) * x(i);
+		}
+		s2 = 1;
+		for (i=0; i<(int)x.size(); i++) {
+			s2 *= cos(x(i) / sqrt(T(i + 1)));
+		}
+		return 1 + s1 / 4000. - s2;
+	}
+};
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i;
+	kv::tape tp, tl;
+	kv::scalar_tape tg;
+	ub::vector<itv> I, fv1, fv2;
+	ub::matrix<itv> fd1, fd2;
+	ub::vector<aff> A;
+	std::vector< ub::vector<itv> > xs, ys;
+	std::list< ub::vector<itv> > s;
+	std::list< ub::vector<itv> >::iterator p;
+	std::chrono::system_clock::time_point t;
+
+	std::cout.precision(17);
+
+	tp.record(Func(), 3);
+	std::cout << tp;
+	std::cout << "nodes: " << tp.size() << ", work area: " << tp.nwork << "\n";
+
+	I.resize(3);
+	I(0) = itv(0.1, 0.2);
+	I(1) = itv(-0.3, 0.5);
+	I(2) = itv(0.7, 0.8);
+
+	// interval
+	std::cout << Func()(I) << "\n" << tp(I) << "\n";
+
+	// affine
+	A = I;
+	std::cout << to_interval(Func()(A)) << "\n" << to_interval(tp(A)) << "\n";
+
+	// autodif
+	kv::autodif<itv>::split(Func()(kv::autodif<itv>::init(I)), fv1, fd1);
+	kv::autodif<itv>::split(tp(kv::autodif<itv>::init(I)), fv2, fd2);
+	std::cout << fd1 << "\n" << fd2 << "\n";
+
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100000; i++) {
+		kv::autodif<itv>::split(Func()(kv::autodif<itv>::init(I)), fv1, fd1);
+	}
+	std::cout << "direct: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+	t = std::chrono::system_clock::now();
+	for (i=0; i<100000; i++) {
+		kv::autodif<itv>::split(tp(kv::autodif<itv>::init(I)), fv2, fd2);
+	}
+	std::cout << "tape: " << std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9 << " sec\n";
+
+	// batch evaluation
+	xs.resize(1000);
+	for (i=0; i<1000; i++) {
+		xs[i] = I;
+		xs[i](0) += i * 0.001;
+	}
+	tp.eval_batch(xs, ys);
+	std::cout << ys[999] << "\n" << Func()(xs[999]) << "\n";
+
+	// allsol
+	for (i=0; i<3; i++) I(i) = itv(-2., 2.);
+	s = kv::allsol(tp, I, 0);
+	for (p=s.begin(); p!=s.end(); p++) std::cout << *p << "\n";
+
+	// optimize
+	tg.record(Griewank(), 3);
+	std::cout << "nodes: " << tg.size() << ", work area: " << tg.nwork << "\n";
+	for (i=0; i<3; i++) I(i) = itv(-20., 30.);
+	std::cout << kv::minimize_value(I, tg, 1e-3) << "\n";
+
+	// odelong_maffine
+	tl.record_ode(Lorenz(), 3);
+	itv end;
+	ub::vector<aff> v(3);
+	v(0) = 15.; v(1) = 15.; v(2) = 36.;
+	end = 1.;
+	if (kv::odelong_maffine(tl, v, itv(0.), end)) {
+		for (i=0; i<3; i++) std::cout << to_interval(v(i)) << "\n";
+	}
+}
@@ -0,0 +1,158 @@
+// test program for upward_scope
+// compile with -DKV_USE_UPWARD
+// compare interval<double> operations in and out of upward_scope
+
+#include <iostream>
+#include <chrono>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-dot.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/allsol.hpp>
+#include <boost/random.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+double elapsed(const std::chrono::system_clock::time_point& t)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - t).count() / 1e9;
+}
+
+// all the operations of rop<double>
+itv ops(const itv& x, const itv& y)
+{
+	return sqrt(abs(x * y - x / y + (x - y))) + exp(x) + log(abs(y) + 1.) + sin(x);
+}
+
+// 1 if the current rounding mode is upward
+int upward()
+{
+	volatile double a = 1., b = 1e-30, c;
+	c = a + b;
+	return c > 1.;
+}
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, const T& t) {
+		ub::vector<T> y(3);
+
+		y(0) = 10. * (x(1) - x(0));
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = -8. / 3. * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+struct Func {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x) {
+		ub::vector<T> y(2);
+
+		y(0) = x(0) * x(0) + x(1) * x(1) - 1.;
+		y(1) = x(0) - x(1) * x(1) * x(1);
+
+		return y;
+	}
+};
+
+int main()
+{
+	int i, n = 1000, c;
+	std::vector<itv> x(n), y(n), r1(n), r2(n);
+	itv s;
+	std::chrono::system_clock::time_point t;
+
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-10., 10.));
+
+	std::cout.precision(17);
+
+	for (i=0; i<n; i++) {
+		x[i] = itv::hull(rand(), rand());
+		y[i] = (i % 3 == 0) ? itv(rand()) : itv::hull(rand(), rand());
+		if (zero_in(y[i])) y[i] = 1.;
+	}
+
+	// the results must be the same
+	for (i=0; i<n; i++) r1[i] = ops(x[i], y[i]);
+	{
+		kv::upward_scope u;
+		for (i=0; i<n; i++) r2[i] = ops(x[i], y[i]);
+	}
+	c = 0;
+	for (i=0; i<n; i++) {
+		if (r1[i].lower() != r2[i].lower() || r1[i].upper() != r2[i].upper()) c++;
+	}
+	std::cout << "operations: " << c << " differences\n";
+
+	// rounding mode in the scopes
+	std::cout << "outside: " << !upward() << "\n";
+	{
+		kv::upward_scope u1;
+		{
+			kv::upward_scope u2;
+			s = x[0] + y[0];
+			std::cout << "nested upward: " << upward() << "\n";
+			{
+				kv::nearest_scope nr;
+				s = x[0] * y[0];
+				std::cout << "nearest: " << !upward() << "\n";
+			}
+			std::cout << "upward: " << upward() << "\n";
+		}
+		std::cout << "upward: " << upward() << "\n";
+
+		// kernels which change the rounding mode keep it upward
+		ub::matrix<double> a(3, 3);
+		ub::vector<itv> v(3);
+		for (i=0; i<9; i++) a(i / 3, i % 3) = rand();
+		for (i=0; i<3; i++) v(i) = x[i];
+		std::cout << prod(a, v) << "\n";
+		std::cout << "upward after prod: " << upward() << "\n";
+	}
+	std::cout << "outside: " << !upward() << "\n";
+
+	// ode and allsol in upward_scope
+	{
+		ub::vector<itv> z(3), z2(3);
+		itv end;
+		int r1, r2;
+
+		z(0) = 15.; z(1) = 15.; z(2) = 36.;
+		end = 1.;
+		t = std::chrono::system_clock::now();
+		r1 = kv::odelong_maffine(Lorenz(), z, itv(0.), end);
+		std::cout << "ode: " << elapsed(t) << " sec\n";
+
+		z2(0) = 15.; z2(1) = 15.; z2(2) = 36.;
+		end = 1.;
+		t = std::chrono::system_clock::now();
+		{
+			kv::upward_scope u;
+			r2 = kv::odelong_maffine(Lorenz(), z2, itv(0.), end);
+		}
+		std::cout << "ode in upward_scope: " << elapsed(t) << " sec\n";
+		std::cout << r1 << " " << z << "\n";
+		std::cout << r2 << " " << z2 << "\n";
+
+		ub::vector<itv> b(2);
+		b(0) = itv(-10., 10.);
+		b(1) = itv(-10., 10.);
+		{
+			kv::upward_scope u;
+			kv::allsol(Func(), b, 0);
+		}
+	}
+
+	// timing
+	t = std::chrono::system_clock::now();
+	for (i=0; i<1000*n; i++) r1[i % n] = x[i % n] * y[i % n] + x[(i + 1) % n];
+	std::cout << "out of scope: " << elapsed(t) << " sec\n";
+	t = std::chrono::system_clock::now();
+	{
+		kv::upward_scope u;
+		for (i=0; i<1000*n; i++) r2[i % n] = x[i % n] * y[i % n] + x[(i + 1) % n];
+	}
+	std::cout << "upward_scope: " << elapsed(t) << " sec\n";
+}